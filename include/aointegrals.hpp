@@ -27,10 +27,12 @@
 #include <chronusq_sys.hpp>
 #include <molecule.hpp>
 #include <basisset/basisset_def.hpp>
+#include <aointegrals/quartets.hpp>
 #include <memmanager.hpp>
 #include <libint2/engine.h>
 
 #include <util/files.hpp>
+#include <util/shm.hpp>
 
 namespace ChronusQ {
 
@@ -87,6 +89,12 @@ namespace ChronusQ {
     CHOLESKY
   }; ///< Orthonormalization Scheme
 
+  enum ERI_COMPRESSION {
+    ERI_FULL,      ///< Full double precision ERI tensor
+    ERI_FLOAT32,   ///< Single precision shell pair tiles
+    ERI_QUANTIZED  ///< Integer quantized tiles with bounded error
+  }; ///< Storage of the in-core ERI tensor
+
   class AOIntegrals {
   public:
 
@@ -105,6 +113,21 @@ namespace ChronusQ {
     Molecule     &molecule_;   ///< Molecule object for nuclear potential
     BasisSet     &basisSet_;   ///< BasisSet for the GTO basis defintion
 
+    std::vector<ShellPairTask> sigShellPairs_; ///< Significant shell pairs
+
+    std::shared_ptr<SharedMemSegment> shmERI_; ///< Node-shared ERI storage
+    std::vector<std::shared_ptr<SharedMemSegment>> shmPublished_;
+      ///< Node-shared segments published by this object
+
+    // Node-shared storage (see src/aointegrals/aointegrals.cxx for docs)
+    std::string sharedKey();
+    std::shared_ptr<SharedMemSegment> attachShared(const std::string&, 
+      size_t);
+
+    // Compressed in-core ERIs 
+    // (see src/aointegrals/eri_compress.cxx for docs)
+    void computeERICompressed();
+
     // General wrapper for 1-e integrals
     // See src/aointegrals/aointegrals_builders.cxx for documentation
     oper_t_coll OneEDriver(libint2::Operator, std::vector<libint2::Shell>&);
@@ -286,6 +309,17 @@ namespace ChronusQ {
     ORTHO_TYPE            orthoType; ///< Orthogonalization scheme
 
     double threshSchwartz; ///< Schwartz screening threshold
+    double threshOneE;     ///< Shell pair (overlap extent) threshold
+    double nucFarField;    ///< Far-field ratio for the nuclear potential 
+                           ///< (disabled if <= 0)
+
+    bool   sharedMem;       ///< Share read-only integrals between processes
+                            ///< on the node (POSIX shared memory)
+
+    ERI_COMPRESSION eriCompress;    ///< Storage of the in-core ERIs
+    double          eriCompressTol; ///< Max abs error of a compressed ERI
+    bool   collectERIStats; ///< Collect ERI screening stats (DIRECT / INCORE)
+    size_t nERIStatsCall;   ///< Number of contractions with collected stats
 
 
     // Hard storage of integrals
@@ -324,6 +358,10 @@ namespace ChronusQ {
       
     oper_t ERI;    ///< Electron-Electron repulsion integrals (4 index) 
 
+    unsigned char *ERIComp;      ///< Compressed ERI columns (if compressed)
+    size_t        *ERICompOffset;///< Offsets of the compressed (kl) columns
+                                 ///< (the last entry is the total size)
+
     // Constructors
     
     // Disable default constructor
@@ -337,10 +375,14 @@ namespace ChronusQ {
      *  \param [in] basis      The GTO basis for integral evaluation
      */ 
     AOIntegrals(CQMemManager &memManager, Molecule &mol, BasisSet &basis) :
-      threshSchwartz(1e-12), cAlg(DIRECT), orthoType(LOWDIN), 
-      memManager_(memManager), basisSet_(basis), molecule_(mol), 
+      memManager_(memManager), molecule_(mol), basisSet_(basis), 
+      coreType(NON_RELATIVISTIC), cAlg(DIRECT), orthoType(LOWDIN), 
+      threshSchwartz(1e-12), threshOneE(1e-14), nucFarField(0.),
+      sharedMem(false), eriCompress(ERI_FULL), eriCompressTol(1e-10),
+      collectERIStats(false), nERIStatsCall(0),
       schwartz(nullptr), ortho1(nullptr), ortho2(nullptr), overlap(nullptr), 
-      kinetic(nullptr), potential(nullptr), ERI(nullptr), coreType(NON_RELATIVISTIC) {
+      kinetic(nullptr), potential(nullptr), ERI(nullptr), ERIComp(nullptr),
+      ERICompOffset(nullptr) {
 
       nTT_  = basis.nBasis * ( basis.nBasis + 1 ) / 2;
       nSQ_  = basis.nBasis * basis.nBasis;
@@ -404,10 +446,22 @@ namespace ChronusQ {
     // (see src/aointegrals/aointegrals_builders.cxx for docs)
 
     void computeAOOneE(bool); // Evaluate the 1-e ints in the CGTO basis
+    void computeLenMultipole(size_t); // Length gauge multipoles (on demand)
+    void computeMagDipole();    // Magnetic dipole (on demand)
+    void computeVelMultipole(); // Velocity gauge multipoles (on demand)
+    void saveAOOper(std::string, double*); // Save a 1-e operator to disk
     void computeERI();    // Evaluate and store the ERIs in the CGTO basis
     void computeOrtho();  // Evaluate orthonormalization transformations
     void computeSchwartz(); // Evaluate schwartz bounds over CGTOS
 
+    // Decompress a range of (kl) columns of the compressed ERIs
+    // (see src/aointegrals/eri_compress.cxx for docs)
+    void decompressERI(size_t, size_t, double*);
+
+    // Significant (class sorted) shell pairs shared by the 1-e and 2-e
+    // engines
+    const std::vector<ShellPairTask>& significantShellPairs();
+
     // CH == Core Hamiltonian
     void computeCoreHam(CORE_HAMILTONIAN_TYPE); // Compute the CH
     void computeNRCH(double*); // Non-relativistic CH
@@ -417,6 +471,15 @@ namespace ChronusQ {
     // Allow for delayed evaluation of CH
     inline void computeCoreHam() { computeCoreHam(coreType); }
 
+    // Nuclear gradients (see src/aointegrals/gradient.cxx for docs)
+    std::vector<double> oneEGradient(double*, double*);
+    std::vector<double> twoEGradient(double*, std::vector<double*>&, double);
+
+    // Discard the geometry dependent integrals after the nuclei (and so
+    // the basis centers) have been moved
+    // (see src/aointegrals/aointegrals.cxx for docs)
+    void clearGeometry();
+
     // Integral contraction
 
     /**
@@ -457,6 +520,21 @@ namespace ChronusQ {
     template <typename T, typename G>
     void KContractIncore(TwoBodyContraction<T,G> &);
 
+    template <typename T, typename G>
+    void JContractIncoreBatch(std::vector<TwoBodyContraction<T,G>*> &);
+
+    template <typename T, typename G>
+    void KContractIncoreBatch(std::vector<TwoBodyContraction<T,G>*> &);
+
+    template <typename T, typename G>
+    void JContractIncoreCompressed(std::vector<TwoBodyContraction<T,G>*> &);
+
+    template <typename T, typename G>
+    void KContractIncoreCompressed(std::vector<TwoBodyContraction<T,G>*> &);
+
+    template <typename U>
+    void JCompressedKernel(size_t, U*, U*);
+
 
 
     // DIRECT contraction routines
@@ -465,6 +543,10 @@ namespace ChronusQ {
     template <typename T, typename G>
     void twoBodyContractDirect(std::vector<TwoBodyContraction<T,G>>&);
 
+    // Report / save the ERI screening statistics
+    // (see src/aointegrals/quartets.cxx for docs)
+    void reportERIScreenStats(std::vector<ERIScreenStats>&);
+
     template <typename T, typename G>
     void directScaffold(std::vector<TwoBodyContraction<T,G>>&);
 
@@ -26,6 +26,7 @@
 
 
 #include <aointegrals.hpp>
+#include <aointegrals/quartets.hpp>
 #include <util/matout.hpp>
 #include <cqlinalg/blas1.hpp>
 #include <cqlinalg/blasext.hpp>
@@ -230,6 +231,23 @@ namespace ChronusQ {
       maxShBlk = std::max(maxShBlk,
         *std::max_element(ShBlkNorms[iMat],ShBlkNorms[iMat] + NS*NS) ); 
 
+#ifdef _FULL_DIRECT
+    // Max of the shell block norms over all matricies (and both
+    // triangles if any are non-hermetian)
+    double *ShBlkMax = memManager_.malloc<double>(NS*NS);
+    std::copy_n(ShBlkNorms[0],NS*NS,ShBlkMax);
+    for(auto iMat = 1; iMat < NMat; iMat++)
+    for(auto iSS = 0; iSS < NS*NS; iSS++)
+      ShBlkMax[iSS] = std::max(ShBlkMax[iSS],ShBlkNorms[iMat][iSS]);
+
+    if( AnyNonHer )
+      for(auto s1 = 0; s1 < NS; s1++)
+      for(auto s2 = 0; s2 < s1; s2++) {
+        double mx = std::max(ShBlkMax[s1 + s2*NS],ShBlkMax[s2 + s1*NS]);
+        ShBlkMax[s1 + s2*NS] = mx; ShBlkMax[s2 + s1*NS] = mx;
+      }
+#endif
+
 
     size_t NP4 = 
       basisSet_.maxPrim * basisSet_.maxPrim * basisSet_.maxPrim * 
@@ -255,8 +273,19 @@ namespace ChronusQ {
       durZero(0.);
 #endif
 
-    // Keeping track of number of integrals skipped
-    std::vector<size_t> nSkip(nthreads,0);
+    // Screening statistics (opt-in)
+    std::vector<ERIScreenStats> screenStats(collectERIStats ? nthreads : 0);
+
+#ifdef _FULL_DIRECT
+    // Significant unique shell pairs sorted by integral class such that 
+    // quartets of the same class are evaluated contiguously
+    const std::vector<ShellPairTask> &shellPairs = significantShellPairs();
+    const size_t NPair = shellPairs.size();
+#endif
+
+#ifdef _REPORT_QUARTET_CLASS_STATS
+    std::vector<QuartetClassStats> classStats(nthreads);
+#endif
 
 
     auto topDirect = std::chrono::high_resolution_clock::now();
@@ -272,11 +301,30 @@ namespace ChronusQ {
     
     auto &AX_loc = AXthreads[thread_id];
 
+    ERIScreenStats *stats_loc = 
+      collectERIStats ? &screenStats[thread_id] : nullptr;
+    auto topThread = std::chrono::high_resolution_clock::now();
+
 
     double * intBuffer_loc  = intBuffer  + thread_id*lenIntBuffer;
     double * intBuffer2_loc = intBuffer2 + thread_id*lenIntBuffer;
 
 
+#ifdef _FULL_DIRECT
+
+    // Loop over class sorted bra shell pairs (s2 <= s1)
+    for(size_t iBra = 0; iBra < NPair; iBra++) {
+
+      // Round-Robbin work distribution
+      if( iBra % nthreads != thread_id ) continue;
+
+      const ShellPairTask &bra = shellPairs[iBra];
+
+      const size_t s1 = bra.s1, bf1_s = bra.bf1, n1 = bra.n1;
+      const size_t s2 = bra.s2, bf2_s = bra.bf2, n2 = bra.n2;
+
+#else
+
     size_t n1,n2;
 
     // Always Loop over s2 <= s1
@@ -290,6 +338,8 @@ namespace ChronusQ {
       // Round-Robbin work distribution
       if( s12 % nthreads != thread_id ) continue;
 
+#endif
+
 
       // Cache variables for shells 1 and 2
         
@@ -301,6 +351,9 @@ namespace ChronusQ {
 #ifdef _SHZ_SCREEN
       double shz12 = schwartz[s1 + s2*NS];
 
+  #ifdef _FULL_DIRECT
+      double shMax12 = ShBlkMax[s1 + s2*NS];
+  #else
       double shMax12 = ShBlkNorms[0][s1 + s2*NS];
       for(auto iMat = 1; iMat < NMat; iMat++)
         shMax12 = std::max(shMax12,ShBlkNorms[iMat][s1 + s2*NS]);
@@ -309,6 +362,7 @@ namespace ChronusQ {
       if( AnyNonHer and s1 != s2 )
         for(auto iMat = 0; iMat < NMat; iMat++)
           shMax12 = std::max(shMax12,ShBlkNorms[iMat][s2 + s1*NS]);
+  #endif
 #endif
 
 
@@ -347,6 +401,35 @@ namespace ChronusQ {
 #endif
 
 
+#ifdef _FULL_DIRECT
+
+      // Loop over class sorted ket shell pairs, the 8-fold unique
+      // quartets are those with ket.pairIndex <= bra.pairIndex
+      for(auto &ket : shellPairs) {
+
+        if( ket.pairIndex > bra.pairIndex ) continue;
+
+        const size_t s3 = ket.s1, bf3_s = ket.bf1, n3 = ket.n1;
+        const size_t s4 = ket.s2, bf4_s = ket.bf2, n4 = ket.n2;
+
+  #ifdef _SHZ_SCREEN
+        // Compute Shell norm max
+        double shMax = 
+          std::max(std::max(shMax12,             ShBlkMax[s3 + s4*NS]),
+          std::max(std::max(ShBlkMax[s1 + s3*NS],ShBlkMax[s2 + s3*NS]),
+                   std::max(ShBlkMax[s1 + s4*NS],ShBlkMax[s2 + s4*NS])));
+
+        double bound = shMax * shz12 * schwartz[s3 + s4*NS];
+        if( stats_loc ) stats_loc->addBound(bound);
+
+        if( bound < threshSchwartz ) { 
+          if( stats_loc ) stats_loc->nSchwartz++; 
+          continue; 
+        }
+  #endif
+
+#else
+
       size_t n3,n4;
       for(size_t s3(0), bf3_s(0); s3 <= S3_MAX; s3++, bf3_s += n3) { 
         n3 = basisSet_.shells[s3].size(); // Size of Shell 3
@@ -419,9 +502,13 @@ namespace ChronusQ {
 
         shMax = std::max(shMax,shMax123);
 
-        if((shMax * shz12 * schwartz[s3 + s4*NS]) < 
-           threshSchwartz) { nSkip[thread_id]++; continue; }
+        if((shMax * shz12 * schwartz[s3 + s4*NS]) < threshSchwartz) { 
+          if( stats_loc ) stats_loc->nSchwartz++; 
+          continue; 
+        }
 #endif
+
+#endif // _FULL_DIRECT
       
 
 #ifdef _FULL_DIRECT
@@ -437,6 +524,10 @@ namespace ChronusQ {
 
 #endif
 
+#ifdef _REPORT_QUARTET_CLASS_STATS
+        auto topERI = std::chrono::high_resolution_clock::now();
+#endif
+
         // Evaluate ERI for shell quartet (s1 s2 | s3 s4)
         engine.compute2<
           libint2::Operator::coulomb, libint2::BraKet::xx_xx, 0>(
@@ -446,9 +537,25 @@ namespace ChronusQ {
           basisSet_.shells[s4]
         );
 
+#ifdef _REPORT_QUARTET_CLASS_STATS
+        std::chrono::duration<double> durERI = 
+          std::chrono::high_resolution_clock::now() - topERI;
+        classStats[thread_id].add(bra,ket,durERI.count());
+#endif
+
         // Libint2 internal screening
         const double *buff = buf_vec[0];
-        if(buff == nullptr) { nSkip[thread_id]++; continue; }
+        if(buff == nullptr) { 
+          if( stats_loc ) stats_loc->nLibint++; 
+          continue; 
+        }
+
+#ifdef _FULL_DIRECT
+        if( stats_loc ) stats_loc->addSurvivor(bra,ket);
+#else
+        // No shell pair (class) information in the batched contraction
+        if( stats_loc ) stats_loc->nEval++;
+#endif
 
 #ifdef _BATCH_DIRECT
 
@@ -615,8 +722,12 @@ namespace ChronusQ {
 
 #endif
 
+#ifdef _FULL_DIRECT
+      } // loop ket pairs
+#else
       } // loop s4
       } // loop s3
+#endif
 
 #ifdef _SUB_TIMINGS
       auto botInner = std::chrono::high_resolution_clock::now();
@@ -723,18 +834,32 @@ namespace ChronusQ {
 
 #endif
 
+#ifdef _FULL_DIRECT
+    }; // loop bra pairs
+#else
     }; // s2
     }; // s1
+#endif
+
+    if( stats_loc ) {
+      std::chrono::duration<double> durThread = 
+        std::chrono::high_resolution_clock::now() - topThread;
+      stats_loc->time = durThread.count();
+    }
 
 
     }; // OpenMP context
 
     auto botDirect = std::chrono::high_resolution_clock::now();
 
-#ifdef _REPORT_INTEGRAL_TIMINGS
-    size_t nIntSkip = std::accumulate(nSkip.begin(),nSkip.end(),0);
-    std::cerr << "Screened " << nIntSkip << std::endl;
+#ifdef _REPORT_QUARTET_CLASS_STATS
+    for(auto iTh = 1; iTh < nthreads; iTh++) classStats[0] += classStats[iTh];
+    classStats[0].print(std::cerr,"Direct ERI Class Statistics");
+#endif
+
+    if( collectERIStats ) reportERIScreenStats(screenStats);
 
+#ifdef _REPORT_INTEGRAL_TIMINGS
     std::chrono::duration<double> durDirect = botDirect - topDirect;
     std::cerr << "Direct Contraction took " << durDirect.count() << " s\n"; 
 
@@ -813,6 +938,9 @@ namespace ChronusQ {
     memManager_.free(intBuffer);
 #ifdef _SHZ_SCREEN
     memManager_.free(ShBlkNorms_raw);
+  #ifdef _FULL_DIRECT
+    memManager_.free(ShBlkMax);
+  #endif
 #endif
     if(AXRaw != nullptr) memManager_.free(AXRaw);
 
@@ -55,6 +55,24 @@ namespace ChronusQ {
 
     auto topIncore = std::chrono::high_resolution_clock::now();
 
+    // Compressed ERIs are decompressed on the fly
+    if( ERIComp != nullptr ) {
+
+      std::vector<TwoBodyContraction<T,G>*> JList, KList;
+      for(auto &C : list) {
+        if( C.contType == COULOMB )       JList.emplace_back(&C);
+        else if( C.contType == EXCHANGE ) KList.emplace_back(&C);
+      }
+
+      if( JList.size() > 0 ) JContractIncoreCompressed(JList);
+      if( KList.size() > 0 ) KContractIncoreCompressed(KList);
+
+      return;
+
+    }
+
+#ifdef _BULLET_PROOF_INCORE
+
     // Loop over matricies to contract with
     for(auto &C : list) {
 
@@ -68,6 +86,29 @@ namespace ChronusQ {
 
     } // loop over matricies
 
+#else
+
+    // Sort the contractions by type so that the ERI tensor is only
+    // traversed once per contraction type regardless of the number
+    // of matricies
+    std::vector<TwoBodyContraction<T,G>*> JList, KList;
+    for(auto &C : list) {
+      if( C.contType == COULOMB )       JList.emplace_back(&C);
+      else if( C.contType == EXCHANGE ) KList.emplace_back(&C);
+    }
+
+    // Coulomb-type (34,12) ERI contraction
+    // AX(mn) = (mn | kl) X(kl)
+    if( JList.size() == 1 )     JContractIncore(*JList[0]);
+    else if( JList.size() > 1 ) JContractIncoreBatch(JList);
+
+    // Exchange-type (23,12) ERI contraction
+    // AX(mn) = (mk |ln) X(kl)
+    if( KList.size() == 1 )     KContractIncore(*KList[0]);
+    else if( KList.size() > 1 ) KContractIncoreBatch(KList);
+
+#endif
+
     auto botIncore = std::chrono::high_resolution_clock::now();
     
     std::chrono::duration<double> durIncore = botIncore - topIncore;
@@ -86,7 +127,22 @@ namespace ChronusQ {
         return C.contType == COULOMB; 
       }));
 
+    if( ERIComp != nullptr ) {
+      std::vector<TwoBodyContraction<dcomplex,double>*> JList;
+      for(auto &C : list) JList.emplace_back(&C);
+      JContractIncoreCompressed(JList);
+      return;
+    }
+
+#ifdef _BULLET_PROOF_INCORE
     for(auto &C : list) JContractIncore(C);
+#else
+    std::vector<TwoBodyContraction<dcomplex,double>*> JList;
+    for(auto &C : list) JList.emplace_back(&C);
+
+    if( JList.size() == 1 )     JContractIncore(*JList[0]);
+    else if( JList.size() > 1 ) JContractIncoreBatch(JList);
+#endif
     
   }; // AOIntegrals::twoBodyContractIncore (complex, real)
 
@@ -220,6 +276,325 @@ namespace ChronusQ {
 
   }; // AOIntegrals::KContractIncore
 
+
+
+  /**
+   *  \brief Perform a set of Coulomb-type (34,12) ERI contractions
+   *  as a single matrix-matrix product.
+   *
+   *  The matricies to be contracted are packed as the columns of an
+   *  NB^2 x NMat matrix such that the ERI tensor is only read once.
+   *  Hermetian matricies are contracted using their real part (as in
+   *  JContractIncore), non-Hermetian matricies are batched separately.
+   */
+  template <typename T, typename G>
+  void AOIntegrals::JContractIncoreBatch(
+    std::vector<TwoBodyContraction<T,G>*> &list) {
+
+    std::vector<TwoBodyContraction<T,G>*> HList, NList;
+    for(auto C : list) {
+      if( C->HER ) HList.emplace_back(C);
+      else         NList.emplace_back(C);
+    }
+
+    // Hermetian code
+    if( HList.size() > 0 ) {
+
+      size_t nMat = HList.size();
+      double *XB  = memManager_.malloc<double>(nSQ_*nMat);
+      double *AXB = memManager_.malloc<double>(nSQ_*nMat);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::transform(HList[iMat]->X,HList[iMat]->X + nSQ_,XB + iMat*nSQ_,
+          []( T a ) -> double { return std::real(a); }
+        ); 
+
+      Gemm('N','N',nSQ_,nMat,nSQ_,1.,ERI,nSQ_,XB,nSQ_,0.,AXB,nSQ_);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::copy_n(AXB + iMat*nSQ_,nSQ_,HList[iMat]->AX);
+
+      memManager_.free(XB,AXB);
+
+    }
+
+    // Non-hermetian code
+    if( NList.size() > 0 ) {
+
+      assert( (std::is_same<T,G>::value) );
+
+      size_t nMat = NList.size();
+      T *XB  = memManager_.malloc<T>(nSQ_*nMat);
+      T *AXB = memManager_.malloc<T>(nSQ_*nMat);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::copy_n(NList[iMat]->X,nSQ_,XB + iMat*nSQ_);
+
+      Gemm('N','N',nSQ_,nMat,nSQ_,T(1.),ERI,nSQ_,XB,nSQ_,T(0.),AXB,nSQ_);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::copy_n(AXB + iMat*nSQ_,nSQ_,
+          reinterpret_cast<T*>(NList[iMat]->AX));
+
+      memManager_.free(XB,AXB);
+
+    }
+
+  }; // AOIntegrals::JContractIncoreBatch
+
+
+
+  /**
+   *  \brief Perform a set of Exchange-type (23,12) ERI contractions
+   *  with a single pass over the ERI tensor.
+   *
+   *  The matricies to be contracted are packed as the columns of an
+   *  NB^2 x NMat matrix. Each NB x NB^2 slab of the ERI tensor is then
+   *  contracted with all of the matricies at once, so the slab is
+   *  streamed from memory once and reused from cache NMat times.
+   */
+  template <typename T, typename G>
+  void AOIntegrals::KContractIncoreBatch(
+    std::vector<TwoBodyContraction<T,G>*> &list) {
+
+    assert( (std::is_same<T,G>::value) );
+
+    size_t NB   = basisSet_.nBasis;
+    size_t NB3  = NB * nSQ_;
+    size_t nMat = list.size();
+    size_t nThreads = GetNumThreads();
+
+    T *XB  = memManager_.malloc<T>(nSQ_*nMat);
+
+    // NUMA-local per-thread scratch
+    ThreadScratch<T> SCR(NB*nMat,nThreads);
+
+    for(auto iMat = 0; iMat < nMat; iMat++)
+      std::copy_n(list[iMat]->X,nSQ_,XB + iMat*nSQ_);
+
+    size_t LAThreads = GetLAThreads();
+    SetLAThreads(1);
+
+    #pragma omp parallel
+    {
+
+      T *SCR_loc = SCR.local();
+
+      #pragma omp for
+      for(auto nu = 0; nu < NB; nu++) {
+
+        // SCR(mu,X) = (mu lam | sig nu) X(lam,sig)
+        Gemm('N','N',NB,nMat,nSQ_,T(1.),ERI + nu * NB3,NB,XB,nSQ_,
+          T(0.),SCR_loc,NB);
+
+        for(auto iMat = 0; iMat < nMat; iMat++)
+          std::copy_n(SCR_loc + iMat*NB,NB,
+            reinterpret_cast<T*>(list[iMat]->AX) + nu * NB);
+
+      }
+
+    }
+
+    SetLAThreads(LAThreads);
+
+    memManager_.free(XB);
+
+  }; // AOIntegrals::KContractIncoreBatch
+
+
+
+  /**
+   *  \brief Number of (kl) columns of the compressed ERIs to be
+   *  decompressed at once (~32 MB of scratch per thread).
+   */
+  inline size_t compressedERIChunk(size_t NB) {
+    return std::max(1ul,std::min(NB,(1ul << 22) / (NB*NB)));
+  }
+
+  /**
+   *  \brief Coulomb-type (34,12) contraction of the compressed ERIs with 
+   *  a set of matricies packed as the columns of XB (NB^2 x nMat).
+   *
+   *  Chunks of (kl) columns are decompressed into thread local scratch
+   *  and contracted with the corresponding rows of XB. The thread local
+   *  results are reduced into AXB.
+   */
+  template <typename U>
+  void AOIntegrals::JCompressedKernel(size_t nMat, U *XB, U *AXB) {
+
+    size_t nChunk   = compressedERIChunk(basisSet_.nBasis);
+    size_t nBlk     = (nSQ_ + nChunk - 1) / nChunk;
+    size_t nThreads = GetNumThreads();
+
+    ThreadScratch<double> COL(nSQ_*nChunk,nThreads);
+    ThreadScratch<U>      ACC(nSQ_*nMat,nThreads);
+
+    size_t LAThreads = GetLAThreads();
+    SetLAThreads(1);
+
+    #pragma omp parallel
+    {
+
+      double *COL_loc = COL.local();
+      U      *ACC_loc = ACC.local();
+
+      #pragma omp for schedule(dynamic)
+      for(auto iBlk = 0; iBlk < nBlk; iBlk++) {
+
+        size_t kl = iBlk * nChunk;
+        size_t nc = std::min(nChunk,nSQ_ - kl);
+
+        decompressERI(kl,nc,COL_loc);
+
+        // ACC(mn,X) += (mn | kl) X(kl)
+        Gemm('N','N',nSQ_,nMat,nc,U(1.),COL_loc,nSQ_,XB + kl,nSQ_,
+          U(1.),ACC_loc,nSQ_);
+
+      }
+
+    }
+
+    SetLAThreads(LAThreads);
+
+    std::fill_n(AXB,nSQ_*nMat,U(0.));
+    for(auto iTh = 0; iTh < nThreads; iTh++) {
+      U *ACC_th = ACC[iTh];
+      for(auto i = 0ul; i < nSQ_*nMat; i++) AXB[i] += ACC_th[i];
+    }
+
+  }; // AOIntegrals::JCompressedKernel
+
+
+
+  /**
+   *  \brief Perform a set of Coulomb-type (34,12) ERI contractions with
+   *  the compressed ERIs. Hermetian matricies are contracted using their
+   *  real part (as in JContractIncoreBatch).
+   */
+  template <typename T, typename G>
+  void AOIntegrals::JContractIncoreCompressed(
+    std::vector<TwoBodyContraction<T,G>*> &list) {
+
+    std::vector<TwoBodyContraction<T,G>*> HList, NList;
+    for(auto C : list) {
+      if( C->HER ) HList.emplace_back(C);
+      else         NList.emplace_back(C);
+    }
+
+    // Hermetian code
+    if( HList.size() > 0 ) {
+
+      size_t nMat = HList.size();
+      double *XB  = memManager_.malloc<double>(nSQ_*nMat);
+      double *AXB = memManager_.malloc<double>(nSQ_*nMat);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::transform(HList[iMat]->X,HList[iMat]->X + nSQ_,XB + iMat*nSQ_,
+          []( T a ) -> double { return std::real(a); }
+        ); 
+
+      JCompressedKernel(nMat,XB,AXB);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::copy_n(AXB + iMat*nSQ_,nSQ_,HList[iMat]->AX);
+
+      memManager_.free(XB,AXB);
+
+    }
+
+    // Non-hermetian code
+    if( NList.size() > 0 ) {
+
+      assert( (std::is_same<T,G>::value) );
+
+      size_t nMat = NList.size();
+      T *XB  = memManager_.malloc<T>(nSQ_*nMat);
+      T *AXB = memManager_.malloc<T>(nSQ_*nMat);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::copy_n(NList[iMat]->X,nSQ_,XB + iMat*nSQ_);
+
+      JCompressedKernel(nMat,XB,AXB);
+
+      for(auto iMat = 0; iMat < nMat; iMat++)
+        std::copy_n(AXB + iMat*nSQ_,nSQ_,
+          reinterpret_cast<T*>(NList[iMat]->AX));
+
+      memManager_.free(XB,AXB);
+
+    }
+
+  }; // AOIntegrals::JContractIncoreCompressed
+
+
+
+  /**
+   *  \brief Perform a set of Exchange-type (23,12) ERI contractions with
+   *  the compressed ERIs.
+   *
+   *  For each nu, chunks of the (sig nu) columns are decompressed into 
+   *  thread local scratch (an NB x (NB*nSig) slab of (mu lam | sig nu)) and
+   *  contracted with all of the matricies at once.
+   */
+  template <typename T, typename G>
+  void AOIntegrals::KContractIncoreCompressed(
+    std::vector<TwoBodyContraction<T,G>*> &list) {
+
+    assert( (std::is_same<T,G>::value) );
+
+    size_t NB       = basisSet_.nBasis;
+    size_t nMat     = list.size();
+    size_t nChunk   = compressedERIChunk(NB);
+    size_t nThreads = GetNumThreads();
+
+    T *XB  = memManager_.malloc<T>(nSQ_*nMat);
+
+    ThreadScratch<double> COL(nSQ_*nChunk,nThreads);
+    ThreadScratch<T>      SCR(NB*nMat,nThreads);
+
+    for(auto iMat = 0; iMat < nMat; iMat++)
+      std::copy_n(list[iMat]->X,nSQ_,XB + iMat*nSQ_);
+
+    size_t LAThreads = GetLAThreads();
+    SetLAThreads(1);
+
+    #pragma omp parallel
+    {
+
+      double *COL_loc = COL.local();
+      T      *SCR_loc = SCR.local();
+
+      #pragma omp for schedule(dynamic)
+      for(auto nu = 0; nu < NB; nu++) {
+
+        std::fill_n(SCR_loc,NB*nMat,T(0.));
+
+        for(auto sig = 0ul; sig < NB; sig += nChunk) {
+
+          size_t nc = std::min(nChunk,NB - sig);
+
+          decompressERI(sig + nu*NB,nc,COL_loc);
+
+          // SCR(mu,X) += (mu lam | sig nu) X(lam,sig)
+          Gemm('N','N',NB,nMat,NB*nc,T(1.),COL_loc,NB,XB + sig*NB,nSQ_,
+            T(1.),SCR_loc,NB);
+
+        }
+
+        for(auto iMat = 0; iMat < nMat; iMat++)
+          std::copy_n(SCR_loc + iMat*NB,NB,
+            reinterpret_cast<T*>(list[iMat]->AX) + nu * NB);
+
+      }
+
+    }
+
+    SetLAThreads(LAThreads);
+
+    memManager_.free(XB);
+
+  }; // AOIntegrals::KContractIncoreCompressed
+
 }; // namespace ChronusQ
 
 #endif
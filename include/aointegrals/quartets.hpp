@@ -0,0 +1,192 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_AOINTEGRALS_QUARTETS_HPP__
+#define __INCLUDED_AOINTEGRALS_QUARTETS_HPP__
+
+#include <chronusq_sys.hpp>
+#include <basisset.hpp>
+
+#include <cmath>
+
+// Report the time and count of the ERI evaluations per
+// angular momentum class
+//#define _REPORT_QUARTET_CLASS_STATS
+
+namespace ChronusQ {
+
+  /**
+   *  \brief A unique (s1 >= s2) shell pair and the information
+   *  required to group shell quartets by integral class.
+   */ 
+  struct ShellPairTask {
+
+    size_t s1, s2;      ///< Shell indices (s1 >= s2)
+    size_t bf1, bf2;    ///< Starting basis functions of s1 and s2
+    size_t n1, n2;      ///< Number of basis functions in s1 and s2
+    size_t pairIndex;   ///< Canonical pair index s1*(s1+1)/2 + s2
+    int    L1, L2;      ///< Angular momenta of s1 and s2
+    int    primBucket;  ///< log2 bucket of the primitive pair depth
+
+  }; // struct ShellPairTask
+
+
+  // Shell pair screening by primitive overlap extent.
+  // See src/aointegrals/quartets.cxx for documentation
+  double shellPairBound(const libint2::Shell &, const libint2::Shell &);
+  double shellPairCoulombBound(const libint2::Shell &, 
+    const libint2::Shell &);
+  double shellPairExtent(const libint2::Shell &, const libint2::Shell &,
+    double, std::array<double,3> &);
+  std::vector<ShellPairTask> screenedShellPairs(
+    const std::vector<libint2::Shell> &, double threshPair = 0.);
+
+  // Generate the unique shell pairs sorted by integral class.
+  // See src/aointegrals/quartets.cxx for documentation
+  std::vector<ShellPairTask> classSortedShellPairs(const BasisSet &,
+    double threshPair = 0.);
+
+
+  /**
+   *  \brief Accumulates the number and time of integral evaluations
+   *  per angular momentum class (L1 L2 | L3 L4)
+   */ 
+  struct QuartetClassStats {
+
+    typedef std::array<int,4> class_t;
+
+    std::map<class_t,std::pair<size_t,double>> stats; 
+      ///< Class -> (count, time [s])
+
+    /**
+     *  \brief Add an integral evaluation to the statistics
+     *
+     *  \param [in] bra  Bra shell pair
+     *  \param [in] ket  Ket shell pair
+     *  \param [in] dur  Time for the evaluation [s]
+     */ 
+    void add(const ShellPairTask &bra, const ShellPairTask &ket, 
+      double dur) {
+
+      auto &st = stats[{{bra.L1,bra.L2,ket.L1,ket.L2}}];
+      st.first++; st.second += dur;
+
+    }; // QuartetClassStats::add
+
+    /**
+     *  \brief Merge another set of statistics into this one
+     */ 
+    QuartetClassStats& operator+=(const QuartetClassStats &other) {
+
+      for(auto &st : other.stats) {
+        stats[st.first].first  += st.second.first;
+        stats[st.first].second += st.second.second;
+      }
+
+      return *this;
+
+    }; // QuartetClassStats::operator+=
+
+    // Print the statistics
+    // See src/aointegrals/quartets.cxx for documentation
+    void print(std::ostream &, const std::string &) const;
+
+  }; // struct QuartetClassStats
+
+
+
+  /**
+   *  \brief Thread local ERI screening statistics for a single
+   *  direct contraction.
+   *
+   *  Tracks the number of quartets rejected by the Schwartz bound and
+   *  by the internal Libint2 screening, a histogram of the quartet bounds
+   *  (log10), the survivors per angular momentum class and the work 
+   *  performed by the thread.
+   */ 
+  struct ERIScreenStats {
+
+    enum { 
+      NBIN    = 24,  ///< Number of bound histogram bins
+      MIN_EXP = -22  ///< log10 of the lower edge of the first bin
+    };
+
+    size_t nSchwartz; ///< # Quartets skipped by the Schwartz bound
+    size_t nLibint;   ///< # Quartets skipped by Libint2
+    size_t nEval;     ///< # Quartets evaluated and contracted
+    double time;      ///< Time spent by this thread [s]
+
+    std::array<size_t,NBIN> boundHist; ///< Histogram of log10(bound)
+    std::map<QuartetClassStats::class_t,size_t> classSurvivors; 
+      ///< Survivors per angular momentum class
+
+    ERIScreenStats() : nSchwartz(0), nLibint(0), nEval(0), time(0.) {
+      boundHist.fill(0);
+    }
+
+    /**
+     *  \brief Add a quartet bound to the histogram. Bounds outside the
+     *  range of the histogram are placed in the first / last bin.
+     */ 
+    void addBound(double bound) {
+
+      int bin = (bound > 0.) ? 
+        static_cast<int>(std::floor(std::log10(bound))) - MIN_EXP : 0;
+      bin = std::max(0,std::min(bin,static_cast<int>(NBIN) - 1));
+      boundHist[bin]++;
+
+    }; // ERIScreenStats::addBound
+
+    /**
+     *  \brief Add a surviving quartet to the class statistics
+     */ 
+    void addSurvivor(const ShellPairTask &bra, const ShellPairTask &ket) {
+
+      nEval++;
+      classSurvivors[{{bra.L1,bra.L2,ket.L1,ket.L2}}]++;
+
+    }; // ERIScreenStats::addSurvivor
+
+    /**
+     *  \brief Merge another set of statistics into this one
+     */ 
+    ERIScreenStats& operator+=(const ERIScreenStats &other) {
+
+      nSchwartz += other.nSchwartz;
+      nLibint   += other.nLibint;
+      nEval     += other.nEval;
+      time       = std::max(time,other.time);
+
+      for(auto i = 0; i < NBIN; i++) boundHist[i] += other.boundHist[i];
+      for(auto &cl : other.classSurvivors)
+        classSurvivors[cl.first] += cl.second;
+
+      return *this;
+
+    }; // ERIScreenStats::operator+=
+
+  }; // struct ERIScreenStats
+
+}; // namespace ChronusQ
+
+#endif
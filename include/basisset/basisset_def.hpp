@@ -65,6 +65,18 @@ namespace ChronusQ {
     std::vector<size_t> mapSh2Bf;  ///< Map Shell # -> BF #
     std::vector<size_t> mapSh2Cen; ///< Map Shell # -> Cen #
     std::vector<size_t> mapCen2BfSt; ///< Map Cen # -> Starting BF #
+    std::vector<size_t> mapCen2BfEnd; ///< Map Cen # -> (One past) Last BF #
+
+    size_t nFamily; ///< Number of (general) contraction families
+    std::vector<size_t> mapSh2Fam; 
+      ///< Map Shell # -> Family # (consecutive shells on the same center 
+      ///< over the same primitives, i.e. a general contraction). Only the 
+      ///< grid evaluation (evalShellSet) shares the primitive exponentials
+      ///< within a family, the integrals see the segmented shells
+
+    bool reordered = false; ///< Whether the shells have been reordered
+    std::vector<size_t> mapBf2Orig; 
+      ///< Map BF # -> BF # in the original (input) ordering
 
     // Disable default constructor
     BasisSet() = delete;
@@ -116,6 +128,61 @@ namespace ChronusQ {
     std::vector<libint2::Shell> uncontractShells();
     void makeMapPrim2Cont(double *, double *, CQMemManager&);
 
+    // Spatial locality reordering of the shells.
+    // See src/basisset/basisset.cxx for documentation
+    void reorderShells();
+
+    // Move the shells onto a new set of nuclear positions.
+    // See src/basisset/basisset.cxx for documentation
+    void updateCenters(const Molecule &);
+
+
+    /**
+     *  \brief Permute a matrix from the internal basis ordering to the
+     *  original (input) basis ordering.
+     *
+     *  The rows of A are always permuted, the columns only if permCol.
+     *  A and B may not alias.
+     *
+     *  \param [in]  N       Number of columns of A
+     *  \param [in]  permCol Whether or not to permute the columns 
+     *                       (requires N == nBasis)
+     *  \param [in]  A       Matrix in the internal ordering
+     *  \param [in]  LDA     Leading dimension of A
+     *  \param [out] B       Matrix in the original ordering
+     *  \param [in]  LDB     Leading dimension of B
+     */ 
+    template <typename T>
+    void toOriginalOrder(size_t N, bool permCol, const T *A, size_t LDA, 
+      T *B, size_t LDB) const {
+
+      for(auto j = 0ul; j < N; j++) {
+        size_t jB = permCol ? mapBf2Orig[j] : j;
+        for(auto i = 0ul; i < nBasis; i++)
+          B[mapBf2Orig[i] + jB*LDB] = A[i + j*LDA];
+      }
+
+    }; // BasisSet::toOriginalOrder
+
+
+    /**
+     *  \brief Permute a matrix from the original (input) basis ordering 
+     *  to the internal basis ordering.
+     *
+     *  Inverse of toOriginalOrder.
+     */ 
+    template <typename T>
+    void toInternalOrder(size_t N, bool permCol, const T *A, size_t LDA, 
+      T *B, size_t LDB) const {
+
+      for(auto j = 0ul; j < N; j++) {
+        size_t jA = permCol ? mapBf2Orig[j] : j;
+        for(auto i = 0ul; i < nBasis; i++)
+          B[i + j*LDB] = A[mapBf2Orig[i] + jA*LDA];
+      }
+
+    }; // BasisSet::toInternalOrder
+
 
     private:
 
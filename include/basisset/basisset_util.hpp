@@ -62,7 +62,7 @@ namespace ChronusQ {
    *  \brief for each point from each shell origin in the shells vector..
    */ 
   void evalShellSet(SHELL_EVAL_TYPE, std::vector<libint2::Shell> &, std::vector<bool> &,double *, double *, size_t, 
-    size_t, std::vector<size_t>&, size_t, double*, double*, size_t, bool );
+    size_t, std::vector<size_t>&, std::vector<size_t>&, size_t, double*, double*, size_t, bool );
 
   /**
    *  \brief Level 3 Basis Set Evaluation Function
@@ -71,6 +71,7 @@ namespace ChronusQ {
    *  \brief to properly store the results can be used..
    */ 
   void evalShellSet(SHELL_EVAL_TYPE,const libint2::Shell&,double,const std::array<double,3>&, double *, size_t);
+  void evalShellSet(SHELL_EVAL_TYPE,const libint2::Shell&,const double*,const std::array<double,3>&, double *, size_t);
 
   /**
    *  \brief Basis Set transformation from Cartesian to Spherical
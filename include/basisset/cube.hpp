@@ -0,0 +1,105 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_BASISSET_CUBE_HPP__
+#define __INCLUDED_BASISSET_CUBE_HPP__
+
+#include <basisset/basisset_def.hpp>
+#include <basisset/basisset_util.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Specification of a uniform volumetric (cube) grid.
+   *
+   *  Grid point (i,j,k) is located at origin + i*axes[0] + j*axes[1] +
+   *  k*axes[2]. All quantities in Bohr.
+   */ 
+  struct CubeGrid {
+
+    cart_t origin = {0., 0., 0.};  ///< Grid origin
+    std::array<cart_t,3> axes = {{ {0.2,0.,0.}, {0.,0.2,0.}, {0.,0.,0.2} }};
+      ///< Step vectors along each grid axis
+    std::array<size_t,3> nPts = {{1,1,1}}; ///< # points along each axis
+
+  }; // struct CubeGrid
+
+  CubeGrid MoleculeCubeGrid(const Molecule &mol, double spacing = 0.2,
+    double padding = 4.);
+
+
+  /**
+   *  \brief Evaluates densities and orbitals on a CubeGrid and writes
+   *  them in the Gaussian cube format.
+   *
+   *  The grid is processed in blocks of (x,y) lines in parallel. Only
+   *  the shells whose extent (J. Chem. Theory Comput. 2011, 7, 3097) 
+   *  reaches the bounding box of a block are evaluated, and the
+   *  fields are formed from the basis values with GEMMs. Blocks are
+   *  streamed to disk in order, so the full grid is never held in
+   *  memory.
+   */ 
+  class CubeWriter {
+
+    CQMemManager &memManager_; ///< Memory manager
+    const Molecule &molecule_; ///< Molecule (for the cube header)
+    BasisSet     &basisSet_;   ///< Basis set for the evaluation
+    CubeGrid      grid_;       ///< Volumetric grid
+
+    std::vector<double> mapSh2Cut_; ///< Shell # -> extent
+
+    void writeHeader(std::ostream &out, const std::string &comment, 
+      const std::vector<size_t> &moIdx);
+
+    // Evaluate nField fields (per point) given the basis values 
+    // on a block of points and stream them to fName
+    template <typename F>
+    void writeFields(const std::string &fName, const std::string &comment,
+      const std::vector<size_t> &moIdx, size_t nField, const F &func);
+
+  public:
+
+    double epsScreen   = 1e-10; ///< Basis function screening tolerance
+    size_t nLinesBlock = 4;     ///< # (x,y) lines per block of points
+
+    // Disable default, copy and move construction and assignment
+    CubeWriter() = delete;
+    CubeWriter(const CubeWriter &) = delete;
+    CubeWriter(CubeWriter &&) = delete;
+    CubeWriter& operator=(const CubeWriter &) = delete;
+    CubeWriter& operator=(CubeWriter &&) = delete;
+
+    CubeWriter(CQMemManager &mem, const Molecule &mol, BasisSet &basis,
+      const CubeGrid &grid);
+
+    void writeDensity(const std::string &fName, const std::string &comment,
+      const double *D, size_t LDD);
+
+    void writeOrbitals(const std::string &fName, const std::string &comment,
+      const double *C, size_t LDC, const std::vector<size_t> &moIdx);
+
+  }; // class CubeWriter
+
+}; // namespace ChronusQ
+
+#endif
@@ -50,24 +50,43 @@ namespace ChronusQ {
    *   \brief A class to handle the digestion of a complete basis set file
    *   to be used to generate BasisSet Objects.
    *
-   *   Acts as a collection of ReferenceShell objects
+   *   Acts as a collection of ReferenceShell objects. Parsed basis
+   *   definitions are kept in an in-process registry (see fetch) such that
+   *   repeated BasisSet construction (e.g. in the SAD guess) does not
+   *   re-digest the basis file. Optionally, the parsed definitions may be
+   *   dumped to / loaded from a binary cache (see cacheDir).
    */
   class ReferenceBasisSet {
   
-    std::string    basisPath_; ///< Path to basis file
-    std::ifstream  basisFile_; ///< File object for basis file
+    std::string    basisPath_;     ///< Path to basis file
+    std::string    basisFullPath_; ///< Path to basis file (incl. BASIS_PATH)
+    std::ifstream  basisFile_;     ///< File object for basis file
   
     bool forceCart_;  ///< Whether or not to force cartesian basis functions
+
+    int64_t  basisMTime_; ///< Modification time of the basis file
+    uint64_t basisSize_;  ///< Size of the basis file (bytes)
+
+    bool fromCache_ = false; ///< Whether refShells was read from the cache
   
     // Functions to digest the basis set file
     // See src/basisset/reference.cxx for documentation
     void findBasisFile(bool doPrint = true);
     void parseBasisFile();
+
+    // Functions to handle the binary basis cache
+    // See src/basisset/reference.cxx for documentation
+    std::string cacheFileName() const;
+    bool readBinaryCache();
+    void writeBinaryCache() const;
   
   public:
   
     std::unordered_map<int,ReferenceShell> refShells; 
       ///< Full shell set for basis set
+
+    static std::string cacheDir; 
+      ///< Directory for the binary basis cache ("" disables the cache)
         
         
         
@@ -85,21 +104,41 @@ namespace ChronusQ {
      *  Generates a ReferenceBasisSet object given a path to a basis
      *  file.
      *
-     *  \param [in] path      Full path to basis file
+     *  \param [in] path      Basis file (relative to BASIS_PATH unless 
+     *                        absolute)
      *  \param [in] forceCart Whether or not to force cartesian GTOs
      */ 
     ReferenceBasisSet(const std::string &path, bool forceCart = false,
       bool doPrint = true) : basisPath_(path), forceCart_(forceCart){
   
       findBasisFile(doPrint);
-      parseBasisFile();
+
+      fromCache_ = readBinaryCache();
+      if( not fromCache_ ) {
+        parseBasisFile();
+        writeBinaryCache();
+      }
+
     }
+
+    /**
+     *  \brief Whether the shells were loaded from a valid binary cache
+     *  (rather than parsed from the basis file)
+     */ 
+    bool loadedFromCache() const { return fromCache_; }
   
     
     // Generates a shell list given a Molecule object. 
     // See src/basisset/reference.cxx for documentation
     std::pair<std::vector<libint2::Shell>,std::vector<std::vector<double>>> 
-      generateShellSet(const Molecule&);
+      generateShellSet(const Molecule&) const;
+
+
+    // Registry of parsed basis sets
+    // See src/basisset/reference.cxx for documentation
+    static std::shared_ptr<ReferenceBasisSet> fetch(const std::string &path,
+      bool forceCart = false, bool doPrint = true);
+    static void clearRegistry();
   
   }; // ReferenceBasisSet class
 
@@ -39,4 +39,7 @@
 #include <cqlinalg/factorization.hpp>
 #include <cqlinalg/solve.hpp>
 
+// Iterative solvers
+#include <cqlinalg/krylov.hpp>
+
 #endif
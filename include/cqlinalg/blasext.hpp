@@ -88,6 +88,54 @@ namespace ChronusQ {
   template <typename _F>
   void HerMat(char UPLO, size_t N, _F *A, size_t LDA);
 
+
+  /**
+   *  \brief A scaled operand of a matrix linear combination 
+   *  (see MatLinComb)
+   */ 
+  template <typename _F>
+  struct LinCombTerm {
+    _F      ALPHA; ///< Scaling parameter
+    _F     *A;     ///< Raw storage of the operand
+    size_t  LDA;   ///< Leading dimension of A
+  }; // struct LinCombTerm
+
+  /**
+   *  \brief A scaled real operand of a matrix linear combination which
+   *  is scattered into the real (or imaginary) part of the result
+   *  (see MatLinComb)
+   */ 
+  struct RealLinCombTerm {
+    double  ALPHA; ///< Scaling parameter
+    double *A;     ///< Raw storage of the operand
+    size_t  LDA;   ///< Leading dimension of A
+    bool    IMAG;  ///< Scatter into the imaginary part (complex C only)
+  }; // struct RealLinCombTerm
+
+  /**
+   *  \brief Evaluate a linear combination of (sub) matricies in a single
+   *  sweep over the result.
+   *
+   *  C = BETA * C + sum_i ALPHA_i * A_i + sum_j [i] ALPHA_j * R_j
+   *
+   *  where the real operands R_j are added to the real or imaginary
+   *  (IMAG) part of C. If BETA == 0, C is not referenced on entry.
+   *
+   *  \param[in]     M         Number of rows in C and the operands
+   *  \param[in]     N         Number of columns in C and the operands
+   *  \param[in]     BETA      Scaling parameter which scales C
+   *  \param[in/out] C         Raw storage of the matrix C
+   *  \param[in]     LDC       Leading dimension of the matrix C
+   *  \param[in]     terms     Operands of the same type as C
+   *  \param[in]     realTerms Real operands
+   *
+   *  \warning C may not overlap any of the operands.
+   */ 
+  template <typename _F>
+  void MatLinComb(size_t M, size_t N, _F BETA, _F *C, size_t LDC,
+    const std::vector<LinCombTerm<_F>> &terms,
+    const std::vector<RealLinCombTerm> &realTerms = {});
+
 }; // namespace ChronusQ
 
 
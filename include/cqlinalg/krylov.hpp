@@ -0,0 +1,58 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_CQLINALG_KRYLOV_HPP__
+#define __INCLUDED_CQLINALG_KRYLOV_HPP__
+
+#include <cqlinalg/cqlinalg_config.hpp>
+#include <functional>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Linear operator for the Krylov solvers.
+   *
+   *  Applies the operator to nVec vectors V (stored column major) which
+   *  belong to the right hand sides iRHS[0...nVec) and places the result 
+   *  in AV. All of the vectors of an iteration are passed at once such
+   *  that the operator may batch their evaluation.
+   */ 
+  typedef std::function<
+    void(size_t nVec, const size_t *iRHS, double *V, double *AV)
+  > KrylovOperator;
+
+  enum KRYLOV_ALGORITHM {
+    KRYLOV_CG,      ///< Conjugate gradient (SPD operators)
+    KRYLOV_MINRES,  ///< MINRES (symmetric operators, SPD preconditioner)
+    KRYLOV_GMRES    ///< GMRES (general operators)
+  };
+
+  // Preconditioned Krylov solution of A X = B for several right hand 
+  // sides (see src/cqlinalg/krylov.cxx for docs)
+  bool KrylovSolve(KRYLOV_ALGORITHM alg, size_t N, size_t nRHS, double *B, 
+    double *X, const KrylovOperator &linOp, const KrylovOperator &precond,
+    double convTol, size_t maxIter, size_t &nIter, CQMemManager &mem);
+
+}; // namespace ChronusQ
+
+#endif
@@ -32,6 +32,8 @@
 #include <util/threads.hpp>
 #include <H5Cpp.h>
 
+#include <mutex>
+
 namespace ChronusQ {
 
   /**
@@ -41,21 +43,30 @@ namespace ChronusQ {
    *  Currently initialized the libint2 environment and sets
    *  the default thread pool to a single thread (serial 
    *  calculation)
+   *
+   *  Only the first call in a process performs the initialization, such
+   *  that the environment may be shared by several sessions (CQSession).
    */ 
   inline void initialize() {
 
-    // Bootstrap libint2 env
-    libint2::initialize();
+    static std::once_flag initFlag;
+
+    std::call_once(initFlag,[](){
+
+      // Bootstrap libint2 env
+      libint2::initialize();
+
+      // SS start
+      pop_cart_ang_list();  // populate cartesian angular momentum list  
+      pop_car2sph_matrix();        // populate cartesian to spherical transform matrix
+      generateFmTTable();
+      // SS end
 
-    // SS start
-    pop_cart_ang_list();  // populate cartesian angular momentum list  
-    pop_car2sph_matrix();        // populate cartesian to spherical transform matrix
-    generateFmTTable();
-    // SS end
+      SetNumThreads(1);
 
-    SetNumThreads(1);
+      H5::Exception::dontPrint();
 
-    H5::Exception::dontPrint();
+    });
 
   }; // initialize
 
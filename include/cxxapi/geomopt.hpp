@@ -0,0 +1,62 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_CXXAPI_GEOMOPT_HPP__
+#define __INCLUDED_CXXAPI_GEOMOPT_HPP__
+
+#include <chronusq_sys.hpp>
+#include <molecule.hpp>
+#include <basisset.hpp>
+#include <aointegrals.hpp>
+#include <singleslater.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief A struct to hold the information pertaining to the control
+   *  of a (quasi-Newton) geometry optimization.
+   */ 
+  struct GeomOptControls {
+
+    size_t maxIter    = 50;     ///< Maximum number of geometry steps
+    double gradTol    = 4.5e-4; ///< Max |gradient| criteria (Eh / Bohr)
+    double rmsGradTol = 3.0e-4; ///< RMS gradient criteria (Eh / Bohr)
+    double maxStep    = 0.3;    ///< Max step length (Bohr)
+    double hessGuess  = 0.5;    ///< Initial (diagonal) Hessian (Eh / Bohr^2)
+
+  }; // GeomOptControls struct
+
+  // Move the nuclei of a calculation (see src/cxxapi/geomopt.cxx for docs)
+  void SetGeometry(const std::vector<double> &, Molecule &, BasisSet &, 
+    AOIntegrals &, SingleSlaterBase &);
+
+  // Print a nuclear gradient (see src/cxxapi/geomopt.cxx for docs)
+  void printGradient(std::ostream &, Molecule &, const std::vector<double> &);
+
+  // BFGS geometry optimization (see src/cxxapi/geomopt.cxx for docs)
+  void OptimizeGeometry(std::ostream &, GeomOptControls &, Molecule &, 
+    BasisSet &, AOIntegrals &, SingleSlaterBase &, EMPerturbation &);
+
+}; // namespace ChronusQ
+
+#endif
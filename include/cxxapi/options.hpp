@@ -31,6 +31,8 @@
 #include <aointegrals.hpp>
 #include <singleslater.hpp>
 #include <realtime.hpp>
+#include <cxxapi/geomopt.hpp>
+#include <cxxapi/finitefield.hpp>
 
 // Preprocessor directive to aid the digestion of optional 
 // input arguments
@@ -69,6 +71,15 @@ namespace ChronusQ {
 
   std::shared_ptr<CQMemManager> CQMiscOptions(std::ostream &,
     CQInputFile &);
+
+  // Parse the geometry optimization options
+  GeomOptControls CQGeomOptOptions(std::ostream &, CQInputFile &);
+
+  // Parse the finite field options
+  FiniteFieldControls CQFiniteFieldOptions(std::ostream &, CQInputFile &);
+
+  // Parse the linear response options
+  ResponseControls CQResponseOptions(std::ostream &, CQInputFile &);
 };
 
 
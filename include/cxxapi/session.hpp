@@ -0,0 +1,116 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_CXXAPI_SESSION_HPP__
+#define __INCLUDED_CXXAPI_SESSION_HPP__
+
+#include <chronusq_sys.hpp>
+#include <cxxapi/input.hpp>
+#include <memmanager.hpp>
+#include <molecule.hpp>
+#include <basisset.hpp>
+#include <aointegrals.hpp>
+#include <singleslater.hpp>
+#include <fields.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief An in-process ChronusQ calculation which persists between 
+   *  runs.
+   *
+   *  Holds the memory pool, Molecule, BasisSet, AOIntegrals and 
+   *  SingleSlater objects of an input file such that a series of related 
+   *  calculations (new geometries or fields) may be performed without
+   *  re-initializing the environment. Each SCF is started from the
+   *  density of the previous run.
+   *
+   *  i.e.
+   *
+   *    CQSession ses("h2o.inp");
+   *    double E0 = ses.runSCF();
+   *
+   *    ses.setField({0., 0., 0.001});
+   *    double E1 = ses.runSCF();
+   *
+   *  \warning The session is bound to std::cout (which is redirected for 
+   *  its lifetime if an output file is given).
+   */ 
+  class CQSession {
+
+    std::shared_ptr<std::ofstream> outFile_; ///< Output file
+    std::streambuf *coutBuf_ = nullptr;      ///< Original std::cout buffer
+
+    std::shared_ptr<CQInputFile>      input_;      ///< Parsed input
+    std::shared_ptr<CQMemManager>     memManager_; ///< Memory pool
+    std::shared_ptr<Molecule>         mol_;        ///< Molecule
+    std::shared_ptr<BasisSet>         basis_;      ///< Basis set on mol_
+    std::shared_ptr<AOIntegrals>      aoints_;     ///< Integrals over basis_
+    std::shared_ptr<SingleSlaterBase> ss_;         ///< Reference wave function
+
+    EMPerturbation pert_; ///< EM perturbation for the SCF
+
+    bool intsValid_ = false; ///< Whether the integrals are current
+    bool hasGuess_  = false; ///< Whether a density is available
+
+    void computeIntegrals();
+
+  public:
+
+    // Disable default, copy and move constructors and assignment operators
+    CQSession()                             = delete;
+    CQSession(const CQSession &)            = delete;
+    CQSession(CQSession &&)                 = delete;
+    CQSession& operator=(const CQSession &) = delete;
+    CQSession& operator=(CQSession &&)      = delete;
+
+    // Session from an input file (see src/cxxapi/session.cxx for docs)
+    CQSession(std::string inFileName, std::string outFileName = "STDOUT",
+      std::string rstFileName = "");
+
+    ~CQSession();
+
+    // Accessors
+    Molecule&         molecule()     { return *mol_;        }
+    BasisSet&         basisSet()     { return *basis_;      }
+    AOIntegrals&      aoints()       { return *aoints_;     }
+    SingleSlaterBase& singleSlater() { return *ss_;         }
+    EMPerturbation&   perturbation() { return pert_;        }
+    CQMemManager&     memManager()   { return *memManager_; }
+
+    // Update the calculation (see src/cxxapi/session.cxx for docs)
+    void setGeometry(const std::vector<double> &);
+    void setField(const cart_t &);
+    void clearField();
+    void resetGuess();
+
+    // Run the calculation (see src/cxxapi/session.cxx for docs)
+    double runSCF();
+    std::vector<double> runGradient();
+    void runRT();
+
+  }; // class CQSession
+
+}; // namespace ChronusQ
+
+#endif
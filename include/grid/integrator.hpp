@@ -620,6 +620,9 @@ namespace ChronusQ {
       std::chrono::duration<double> durWeight(0.)  ;
       std::chrono::duration<double> durBasis(0.) ;
       std::chrono::duration<double> durFunc(0.)  ;
+
+      // Submatrix fragmentation (sensitive to the shell ordering)
+      size_t nEvalBatch(0), nSubMatFrag(0);
 #endif
 
       size_t nthreads = GetNumThreads();
@@ -780,13 +783,20 @@ namespace ChronusQ {
           batchSubMat[0].second = 
             batchSubMat[0].first + basisSet_.shells[batchEvalShells[0]].size();
 
+#if INT_DEBUG_LEVEL >= 1
+        #pragma omp atomic
+        nEvalBatch++;
+        #pragma omp atomic
+        nSubMatFrag += batchSubMat.size();
+#endif
+
 #if INT_DEBUG_LEVEL >= 1
         // TIMING
         auto topBasis = std::chrono::high_resolution_clock::now();
 #endif
         
         evalShellSet(typ_,basisSet_.shells,evalShell,cenRSq_loc,cenXYZ_loc,batch.size(),molecule_.nAtoms,
-          basisSet_.mapSh2Cen,basisEvalDim,BasisEval_loc,SCR_Car_loc,shSizeCar,basisSet_.forceCart);
+          basisSet_.mapSh2Cen,basisSet_.mapSh2Fam,basisEvalDim,BasisEval_loc,SCR_Car_loc,shSizeCar,basisSet_.forceCart);
 
 #if INT_DEBUG_LEVEL >= 1
         // TIMNG
@@ -870,6 +880,10 @@ namespace ChronusQ {
       std::cerr << "Weight " << durWeight.count()/d_batch << std::endl;
       std::cerr << "Basis " << durBasis.count()/d_batch << std::endl;
       std::cerr << "Func " << durFunc.count()/d_batch << std::endl;
+
+      std::cerr << "SubMat Fragments / Batch " 
+                << double(nSubMatFrag) / std::max(nEvalBatch,size_t(1)) 
+                << std::endl;
 #endif
 
     };// integrate
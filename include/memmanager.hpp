@@ -125,39 +125,52 @@ namespace ChronusQ {
      T* malloc(size_t n) {
        // Determine the number of blocks to allocate
        size_t nBlocks = ( (n-1) * sizeof(T) ) / BlockSize_ + 1;
+
+       void * ptr = NULL;
+
+       // The segregated storage and the block record are shared, 
+       // serialize access so that thread teams may allocate
+       #pragma omp critical (CQMemManager)
+       {
       
        // Check to see if requested memory would overflow allocated
-       // memory. Throw a bad alloc if so
-       if( (NAlloc_ + nBlocks) * BlockSize_ > N_ ) {
-         std::bad_alloc excp;
-         throw excp;
-       }
+       // memory. Return a NULL pointer if so
+       if( (NAlloc_ + nBlocks) * BlockSize_ <= N_ ) {
 
-       // Update the number of allocated blocks
-       NAlloc_ += nBlocks; 
+         #ifdef MEM_PRINT
+           std::cerr << "Allocating " << n << " words of " 
+                     << typeid(T).name() << " data (" << nBlocks 
+                     << " blocks): ";
+         #endif
 
-       #ifdef MEM_PRINT
-         std::cerr << "Allocating " << n << " words of " << typeid(T).name()
-                   << " data (" << nBlocks << " blocks): ";
-       #endif
+         // Get a pointer from boost::simple_segregated_storage
+         ptr = mem_backend::malloc_n(nBlocks,BlockSize_);
 
-       // Get a pointer from boost::simple_segregated_storage
-       void * ptr = mem_backend::malloc_n(nBlocks,BlockSize_);
+         #ifdef MEM_PRINT
+           std::cerr << "  PTR = " << ptr << std::endl;
+         #endif
+
+         if( ptr != NULL ) {
+
+           // Update the number of allocated blocks
+           NAlloc_ += nBlocks; 
+
+           // Keep a record of the block
+           AllocatedBlocks_[ptr] = { n * sizeof(T), nBlocks }; 
+
+         }
+
+       }
 
-       // Throw an error if boost returned a NULL pointer (many
-       // possible causes)
+       } // omp critical
+
+       // Throw an error if the request would overflow the allocated memory
+       // or if boost returned a NULL pointer (many possible causes)
        if(ptr == NULL) {
          std::bad_alloc excp;
          throw excp;
        }
 
-       #ifdef MEM_PRINT
-         std::cerr << "  PTR = " << ptr << std::endl;
-       #endif
-
-       // Keep a record of the block
-       AllocatedBlocks_[ptr] = { n * sizeof(T), nBlocks }; 
-
        return static_cast<T*>(ptr); // Return the pointer
      }; // CQMemManager::malloc
 
@@ -174,28 +187,33 @@ namespace ChronusQ {
      template <typename T>
      void free( T* &ptr ) {
 
-       // Attempt to find the pointer in the list of 
-       // allocated blocks
-       auto it = AllocatedBlocks_.find(static_cast<void*>(ptr));
+       #pragma omp critical (CQMemManager)
+       {
 
-       // Kill the job if the pointer is not in the list of allocated
-       // blocks
-       assert( it != AllocatedBlocks_.end() );
+         // Attempt to find the pointer in the list of 
+         // allocated blocks
+         auto it = AllocatedBlocks_.find(static_cast<void*>(ptr));
 
-       #ifdef MEM_PRINT
-         std::cerr << "Freeing " << it->second 
-                   << " blocks of data starting from " 
-                   << static_cast<void*>(ptr) << std::endl;
-       #endif
+         // Kill the job if the pointer is not in the list of allocated
+         // blocks
+         assert( it != AllocatedBlocks_.end() );
+
+         #ifdef MEM_PRINT
+           std::cerr << "Freeing " << it->second 
+                     << " blocks of data starting from " 
+                     << static_cast<void*>(ptr) << std::endl;
+         #endif
 
-       NAlloc_ -= it->second.second; // deduct block size from allocated memory
+         NAlloc_ -= it->second.second; // deduct block size from allocated memory
   
-       // deallocate the memory in an ordered fashion
-       mem_backend::ordered_free_n(ptr,it->second.second,BlockSize_);
+         // deallocate the memory in an ordered fashion
+         mem_backend::ordered_free_n(ptr,it->second.second,BlockSize_);
+
+         // Remove pointer from allocated list
+         AllocatedBlocks_.erase(it);
+
+       } // omp critical
 
-       // Remove pointer from allocated list
-       AllocatedBlocks_.erase(it);
-                
        ptr = NULL; // NULL out the pointer
      }; // CQMemManager::free
 
@@ -230,15 +248,22 @@ namespace ChronusQ {
       */ 
      template <typename T>
      size_t getSize(T* ptr) {
-       // Attempt to find the pointer in the list of 
-       // allocated blocks
-       auto it = AllocatedBlocks_.find(static_cast<void*>(ptr));
+       size_t nBytes;
+
+       #pragma omp critical (CQMemManager)
+       {
+         // Attempt to find the pointer in the list of 
+         // allocated blocks
+         auto it = AllocatedBlocks_.find(static_cast<void*>(ptr));
+
+         // Kill the job if the pointer is not in the list of allocated
+         // blocks
+         assert( it != AllocatedBlocks_.end() );
 
-       // Kill the job if the pointer is not in the list of allocated
-       // blocks
-       assert( it != AllocatedBlocks_.end() );
+         nBytes = it->second.first;
+       } // omp critical
 
-       return std::floor(it->second.first / sizeof(T));
+       return std::floor(nBytes / sizeof(T));
      }; // CQMemManager::getSize
 
 
@@ -53,6 +53,12 @@ namespace ChronusQ {
 
     size_t iRstrt  = 50; ///< Restart every N steps
 
+    bool orbitalProp = false; ///< Propagate the occupied orbitals rather
+                              ///< than the full density
+
+    std::vector<size_t> cubeSteps;    ///< Steps at which to write cube files
+    double              cubeSpacing = 0.2; ///< Cube grid spacing (Bohr)
+
   }; // struct IntegrationScheme
 
   /**
@@ -141,6 +147,14 @@ namespace ChronusQ {
 
     oper_t_coll DOSav;
     oper_t_coll UH;
+
+    bool collinear_ = false; ///< Whether the current (2C) step is collinear
+
+    // Orbital (occupied space) propagation
+    oper_t_coll         COcc;    ///< Occupied orthonormal orbitals
+    oper_t_coll         COccSav; ///< Saved occupied orbitals (MMUT)
+    std::vector<size_t> nOcc;    ///< Number of orbitals in each space
+    oper_t              Ortho1C = nullptr; ///< Complex copy of ortho1
     
   public:
 
@@ -173,10 +187,21 @@ namespace ChronusQ {
 
     // RealTime procedural functions
     void doPropagation(); // From RealTimeBase
-    void formPropagator();
+    void formPropagatorInit();
+    void formPropagator(size_t);
+    void formPropagatorFin();
+    size_t nPropagatorComp() const { 
+      return (UH.size() == 2 or collinear_) ? 2 : 1; 
+    }
     void formFock(bool,double t);
     void propagateWFN();
 
+    // Orbital (occupied space) propagation
+    void formOccOrbitals();
+    void orthoFockAction(dcomplex*, size_t, dcomplex*, dcomplex*, dcomplex*);
+    void propagateOrbitals();
+    void occ2Den();
+
     // Progress functions
     void printRTHeader();
     void printRTStep();
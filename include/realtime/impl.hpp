@@ -27,6 +27,7 @@
 #include <realtime/print.hpp>
 #include <realtime/memory.hpp>
 #include <realtime/propagation.hpp>
+#include <realtime/orbitals.hpp>
 #include <realtime/fock.hpp>
 
 #endif
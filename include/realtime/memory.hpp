@@ -48,6 +48,10 @@ namespace ChronusQ {
     for(auto &X : DOSav) memManager_.free(X);
     for(auto &X : UH)    memManager_.free(X);
 
+    for(auto &X : COcc)    memManager_.free(X);
+    for(auto &X : COccSav) memManager_.free(X);
+    if( Ortho1C ) memManager_.free(Ortho1C);
+
   };
 
 }; // namespace ChronusQ
@@ -0,0 +1,293 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_REALTIME_ORBITALS_HPP__
+#define __INCLUDED_REALTIME_ORBITALS_HPP__
+
+#include <realtime.hpp>
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <cqlinalg/blasutil.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Form the occupied orthonormal orbitals for the orbital
+   *  (occupied space) propagation from the MOs of the propagator.
+   *
+   *  COcc[0] holds the alpha (or 2C) orbitals, COcc[1] the beta orbitals
+   *  (unrestricted). The MOs of the propagator are in the AO basis 
+   *  (see SingleSlater::ortho2aoMOs), CO = ortho2 * C.
+   */ 
+  template <template <typename> class _SSTyp, typename T>
+  void RealTime<_SSTyp,T>::formOccOrbitals() {
+
+    size_t NB  = propagator_.aoints.basisSet().nBasis;
+    size_t NC  = propagator_.nC;
+    size_t NBC = NC * NB;
+
+    nOcc.clear();
+    if( NC == 2 ) nOcc.emplace_back(propagator_.nO);
+    else {
+      nOcc.emplace_back(propagator_.nOA);
+      if( UH.size() == 2 ) nOcc.emplace_back(propagator_.nOB);
+    }
+
+    // Complex copies of the orthonormalization matricies
+    Ortho1C = memManager_.template malloc<dcomplex>(NB*NB);
+    dcomplex *O2 = memManager_.template malloc<dcomplex>(NB*NB);
+
+    std::copy_n(propagator_.aoints.ortho1,NB*NB,Ortho1C);
+    std::copy_n(propagator_.aoints.ortho2,NB*NB,O2);
+
+    for(auto i = 0; i < nOcc.size(); i++) {
+
+      size_t nAlloc = NBC * std::max(nOcc[i],1ul);
+      COcc.emplace_back(memManager_.template malloc<dcomplex>(nAlloc));
+      COccSav.emplace_back(memManager_.template malloc<dcomplex>(nAlloc));
+
+      dcomplex *C = i ? propagator_.mo2 : propagator_.mo1;
+
+      // Each spin block of the rows is transformed independently
+      for(auto b = 0; b < NC; b++)
+        Gemm('N','N',NB,nOcc[i],NB,dcomplex(1.),O2,NB,C + b*NB,NBC,
+          dcomplex(0.),COcc[i] + b*NB,NBC);
+
+    }
+
+    memManager_.free(O2);
+
+  }; // RealTime::formOccOrbitals
+
+
+
+  /**
+   *  \brief Apply the orthonormal Fock matrix of an orbital space to a set
+   *  of orbitals without forming it, FO * X = O1 * F * O1**T * X.
+   *
+   *  \param [in]  F   AO Fock matrix of the orbital space (NBC x NBC)
+   *  \param [in]  n   Number of orbitals
+   *  \param [in]  X   Orbitals (NBC x n)
+   *  \param [out] Y   FO * X   (NBC x n)
+   *  \param [in]  SCR Scratch  (2 * NBC x n)
+   */ 
+  template <template <typename> class _SSTyp, typename T>
+  void RealTime<_SSTyp,T>::orthoFockAction(dcomplex *F, size_t n, 
+    dcomplex *X, dcomplex *Y, dcomplex *SCR) {
+
+    size_t NB  = propagator_.aoints.basisSet().nBasis;
+    size_t NBC = propagator_.nC * NB;
+
+    dcomplex *SCR1 = SCR;
+    dcomplex *SCR2 = SCR + NBC*n;
+
+    for(auto b = 0; b < propagator_.nC; b++)
+      Gemm('T','N',NB,n,NB,dcomplex(1.),Ortho1C,NB,X + b*NB,NBC,
+        dcomplex(0.),SCR1 + b*NB,NBC);
+
+    Gemm('N','N',NBC,n,NBC,dcomplex(1.),F,NBC,SCR1,NBC,dcomplex(0.),
+      SCR2,NBC);
+
+    for(auto b = 0; b < propagator_.nC; b++)
+      Gemm('N','N',NB,n,NB,dcomplex(1.),Ortho1C,NB,SCR2 + b*NB,NBC,
+        dcomplex(0.),Y + b*NB,NBC);
+
+  }; // RealTime::orthoFockAction
+
+
+
+  /**
+   *  \brief Propagate the occupied orbitals, CO(k+1) = U**H(k) * CO, and
+   *  rebuild the densities from them.
+   *
+   *  For PropagatorAlgorithm::Diagonalization, U**H is that formed by
+   *  RealTime::formPropagator. For PropagatorAlgorithm::TaylorExpansion
+   *  the action of exp(-i * dt * FO) on CO is evaluated by a scaled 
+   *  and truncated Taylor series of FO actions (orthoFockAction), such
+   *  that neither FO nor U**H are formed.
+   */ 
+  template <template <typename> class _SSTyp, typename T>
+  void RealTime<_SSTyp,T>::propagateOrbitals() {
+
+    size_t NB  = propagator_.aoints.basisSet().nBasis;
+    size_t NC  = propagator_.nC;
+    size_t NBC = NC * NB;
+
+    size_t nMax = std::max(1ul,*std::max_element(nOcc.begin(),nOcc.end()));
+
+    dcomplex *SCR  = memManager_.template malloc<dcomplex>(NBC*NBC);
+    dcomplex *SCR1 = memManager_.template malloc<dcomplex>(4*NBC*nMax);
+
+    for(auto i = 0; i < nOcc.size(); i++) {
+
+      size_t n = nOcc[i];
+      if( n == 0 ) continue;
+
+      dcomplex *C = COcc[i];
+
+      if( intScheme.prpAlg == Diagonalization ) {
+
+        // U**H of the orbital space in SCR
+        if( NC == 2 )
+          SpinGather(NB,SCR,NBC,UH[SCALAR],NB,UH[MZ],NB,UH[MY],NB,UH[MX],NB);
+        else if( UH.size() == 1 )
+          for(auto j = 0; j < NB*NB; j++) SCR[j] = 0.5 * UH[SCALAR][j];
+        else
+          for(auto j = 0; j < NB*NB; j++) 
+            SCR[j] = 0.5 * (UH[SCALAR][j] + (i ? -1. : 1.) * UH[MZ][j]);
+
+        Gemm('N','N',NBC,n,NBC,dcomplex(1.),SCR,NBC,C,NBC,dcomplex(0.),
+          SCR1,NBC);
+        std::copy_n(SCR1,NBC*n,C);
+
+        continue;
+
+      }
+
+      // AO Fock matrix of the orbital space in SCR
+      if( NC == 2 )
+        SpinGather(NB,SCR,NBC,propagator_.fock[SCALAR],NB,
+          propagator_.fock[MZ],NB,propagator_.fock[MY],NB,
+          propagator_.fock[MX],NB);
+      else if( UH.size() == 1 )
+        for(auto j = 0; j < NB*NB; j++) SCR[j] = 0.5 * propagator_.fock[SCALAR][j];
+      else
+        for(auto j = 0; j < NB*NB; j++) 
+          SCR[j] = 0.5 * (propagator_.fock[SCALAR][j] + 
+                     (i ? -1. : 1.) * propagator_.fock[MZ][j]);
+
+      dcomplex *TERM = SCR1;
+      dcomplex *NEXT = TERM + NBC*n;
+      dcomplex *ASCR = NEXT + NBC*n;
+
+      // Estimate the spectral radius of FO by power iteration
+      for(auto j = 0; j < NBC*n; j++) TERM[j] = C[j] + double(j % 7) / 7.;
+
+      double rho = 0.;
+      for(auto iter = 0; iter < 10; iter++) {
+        double nrm = TwoNorm<double>(NBC*n,TERM,1);
+        Scale(NBC*n,dcomplex(1./nrm),TERM,1);
+        orthoFockAction(SCR,n,TERM,NEXT,ASCR);
+        rho = TwoNorm<double>(NBC*n,NEXT,1);
+        std::swap(TERM,NEXT);
+      }
+
+      // Substeps such that |dt * FO| <= 1
+      size_t nSub = std::max(1.,std::ceil(1.1 * rho * curState.stepSize));
+      dcomplex fact(0.,-curState.stepSize / nSub);
+
+      double CNrm = TwoNorm<double>(NBC*n,C,1);
+
+      for(auto iSub = 0; iSub < nSub; iSub++) {
+
+        // C = sum_k (-i dt FO)^k / k! C
+        std::copy_n(C,NBC*n,TERM);
+
+        for(auto k = 1; k <= 30; k++) {
+
+          orthoFockAction(SCR,n,TERM,NEXT,ASCR);
+          Scale(NBC*n,fact / double(k),NEXT,1);
+          std::swap(TERM,NEXT);
+
+          for(auto j = 0; j < NBC*n; j++) C[j] += TERM[j];
+
+          if( TwoNorm<double>(NBC*n,TERM,1) < 1e-15 * CNrm ) break;
+
+        }
+
+      }
+
+    }
+
+    memManager_.free(SCR,SCR1);
+
+    occ2Den();
+
+  }; // RealTime::propagateOrbitals
+
+
+
+  /**
+   *  \brief Rebuild the orthonormal and AO densities of the propagator 
+   *  from the occupied orbitals, D = C * C**H (C = O1 * CO in the AO 
+   *  basis).
+   */ 
+  template <template <typename> class _SSTyp, typename T>
+  void RealTime<_SSTyp,T>::occ2Den() {
+
+    size_t NB  = propagator_.aoints.basisSet().nBasis;
+    size_t NC  = propagator_.nC;
+    size_t NBC = NC * NB;
+
+    size_t nMax = std::max(1ul,*std::max_element(nOcc.begin(),nOcc.end()));
+
+    dcomplex *CAO = memManager_.template malloc<dcomplex>(NBC*nMax);
+    dcomplex *DEN = memManager_.template malloc<dcomplex>(NBC*NBC);
+
+    // Scatter the density of the orbital spaces into the spin components
+    auto scatter = [&](oper_t_coll &D, size_t i) {
+
+      if( NC == 2 )
+        SpinScatter(NB,DEN,NBC,D[SCALAR],NB,D[MZ],NB,D[MY],NB,D[MX],NB);
+
+      else if( nOcc.size() == 1 )
+        for(auto j = 0; j < NB*NB; j++) D[SCALAR][j] = 2. * DEN[j];
+
+      else if( i == 0 ) {
+        std::copy_n(DEN,NB*NB,D[SCALAR]);
+        std::copy_n(DEN,NB*NB,D[MZ]);
+      } else 
+        for(auto j = 0; j < NB*NB; j++) {
+          D[SCALAR][j] += DEN[j];
+          D[MZ][j]     -= DEN[j];
+        }
+
+    };
+
+    for(auto i = 0; i < nOcc.size(); i++) {
+
+      size_t n = nOcc[i];
+
+      // Orthonormal density
+      Gemm('N','C',NBC,NBC,n,dcomplex(1.),COcc[i],NBC,COcc[i],NBC,
+        dcomplex(0.),DEN,NBC);
+      scatter(propagator_.onePDMOrtho,i);
+
+      // AO density
+      for(auto b = 0; b < NC; b++)
+        Gemm('N','N',NB,n,NB,dcomplex(1.),Ortho1C,NB,COcc[i] + b*NB,NBC,
+          dcomplex(0.),CAO + b*NB,NBC);
+
+      Gemm('N','C',NBC,NBC,n,dcomplex(1.),CAO,NBC,CAO,NBC,
+        dcomplex(0.),DEN,NBC);
+      scatter(propagator_.onePDM,i);
+
+    }
+
+    memManager_.free(CAO,DEN);
+
+  }; // RealTime::occ2Den
+
+}; // namespace ChronusQ
+
+#endif
@@ -152,6 +152,9 @@ namespace ChronusQ {
       expString = "Taylor Expansion";
 
     RTFormattedLine(std::cout,"Matrix Exponential Method:",expString);
+
+    if( intScheme.orbitalProp )
+      RTFormattedLine(std::cout,"Propagated Quantity:","Occupied Orbitals");
     
     std::cout << std::endl << BannerTop << std::endl;
 
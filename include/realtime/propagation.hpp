@@ -31,6 +31,7 @@
 #include <cqlinalg/matfunc.hpp>
 
 #include <util/matout.hpp>
+#include <util/threads.hpp>
 #include <unsupported/Eigen/MatrixFunctions>
 
 template <size_t N, typename T>
@@ -55,6 +56,8 @@ namespace ChronusQ {
 
     size_t NB = propagator_.aoints.basisSet().nBasis;
 
+    if( intScheme.orbitalProp ) formOccOrbitals();
+
     for( curState.xTime = 0., curState.iStep = 0; 
          curState.xTime <= (intScheme.tMax + intScheme.deltaT/4); 
          curState.xTime += intScheme.deltaT, curState.iStep++ ) {
@@ -122,6 +125,8 @@ namespace ChronusQ {
           
         // DOSav(k) = DO(k)
         // DO(k)    = DO(k-1)
+        if( intScheme.orbitalProp ) std::swap(COcc,COccSav);
+        else
         for(auto i = 0; i < DOSav.size(); i++)
           Swap(memManager_.template getSize<dcomplex>(DOSav[i]),
             DOSav[i],1,propagator_.onePDMOrtho[i],1);
@@ -133,6 +138,11 @@ namespace ChronusQ {
         // storage 
           
         // DOSav(k) = DO(k)
+        if( intScheme.orbitalProp )
+          for(auto i = 0; i < COcc.size(); i++)
+            std::copy_n(COcc[i],
+              memManager_.template getSize<dcomplex>(COcc[i]),COccSav[i]);
+        else
         for(auto i = 0; i < DOSav.size(); i++)
           std::copy_n(propagator_.onePDMOrtho[i],
             memManager_.template getSize<dcomplex>(DOSav[i]),
@@ -151,30 +161,67 @@ namespace ChronusQ {
       // Form the Fock matrix at the current time
       formFock(false,curState.xTime);
 
-      // Compute properties for D(k) 
-      propagator_.computeProperties(pert_t);
 
-      data.Time.push_back(curState.xTime);
-      data.Energy.push_back(propagator_.totalEnergy);
-      data.ElecDipole.push_back(propagator_.elecDipole);
-      if( pert_t.fields.size() > 0 )
-      data.ElecDipoleField.push_back( valarray2array<3,double>(pert_t.getAmp()) );
+      // Properties, progress and volumetric output for D(k)
+      auto stepProperties = [&]() {
+
+        // Compute properties for D(k) 
+        propagator_.computeProperties(pert_t);
+
+        data.Time.push_back(curState.xTime);
+        data.Energy.push_back(propagator_.totalEnergy);
+        data.ElecDipole.push_back(propagator_.elecDipole);
+        if( pert_t.fields.size() > 0 )
+        data.ElecDipoleField.push_back( valarray2array<3,double>(pert_t.getAmp()) );
+
+
+        // Print progress line in the output file
+        printRTStep();
+
+        // Volumetric output of D(k) at selected steps
+        if( std::find(intScheme.cubeSteps.begin(),intScheme.cubeSteps.end(),
+              curState.iStep) != intScheme.cubeSteps.end() ) {
+
+          std::string prefix = savFile.fName();
+          prefix = prefix.substr(0,prefix.rfind('.'));
 
+          propagator_.writeCube(prefix + "_rt_" + std::to_string(curState.iStep),
+            MoleculeCubeGrid(propagator_.aoints.molecule(),intScheme.cubeSpacing));
 
-      // Print progress line in the output file
-      printRTStep();
+        }
 
+      };
 
 
+      // The action of U**H on the occupied orbitals does not require
+      // FO or U**H
+      bool formU = not ( intScheme.orbitalProp and 
+                         intScheme.prpAlg == TaylorExpansion );
 
-      // Orthonormalize the AO Fock matrix
-      // F(k) -> FO(l)
-      propagator_.ao2orthoFock();
+      if( formU ) {
 
+        // Orthonormalize the AO Fock matrix
+        // F(k) -> FO(l)
+        propagator_.ao2orthoFock();
 
-      // Form the propagator from the orthonormal Fock matrix
-      // FO(k) -> U**H(k) = exp(- i * dt * FO(k) )
-      formPropagator();
+        // Form the propagator from the orthonormal Fock matrix
+        // FO(k) -> U**H(k) = exp(- i * dt * FO(k) )
+        //
+        // The properties of D(k) only depend on F(k) and D(k), they are
+        // evaluated concurrently with the (spin) components of U**H(k)
+        formPropagatorInit();
+
+        TeamParallel(nPropagatorComp() + 1,[&](size_t iTask) {
+          if( iTask == 0 ) stepProperties();
+          else             formPropagator(iTask - 1);
+        });
+
+        formPropagatorFin();
+
+      } else stepProperties();
+
+      // Orbital propagation: CO(k+1) = U**H(k) * CO and D(k+1) = CO CO**H
+      if( intScheme.orbitalProp ) { propagateOrbitals(); continue; }
 
       // Propagator the orthonormal density matrix
       // DO (in propagator_) will now store DO(k+1)
@@ -210,7 +257,45 @@ namespace ChronusQ {
 
 
   /**
-   *  \brief Form the adjoint of the unitary propagator
+   *  \brief Prepare the orthonormal Fock matrix for the formation of
+   *  the independent components of the propagator (formPropagator).
+   *
+   *  Unrestricted: FO(S/Z) -> FO(A/B)
+   *
+   *  Generalized (2C): if the transverse (MY / MX) components of FO and
+   *  DO vanish (see SingleSlater::isSpinCollinear) the step is treated as
+   *  unrestricted, i.e. the ALPHA and BETA blocks are propagated 
+   *  separately and the transverse components of U are zero.
+   */ 
+  template <template <typename> class _SSTyp, typename T>
+  void RealTime<_SSTyp,T>::formPropagatorInit() {
+
+    collinear_ = UH.size() == 4 and 
+      propagator_.isSpinCollinear(propagator_.fockOrtho) and
+      propagator_.isSpinCollinear(propagator_.onePDMOrtho);
+
+    if( UH.size() != 2 and not collinear_ ) return;
+
+    size_t NB = propagator_.aoints.basisSet().nBasis;
+
+    // Transform SCALAR / MZ -> ALPHA / BETA
+    for(auto i = 0; i < NB*NB; i++) {
+      dcomplex tmp = propagator_.fockOrtho[SCALAR][i];
+
+      propagator_.fockOrtho[SCALAR][i] = 
+        0.5 * (tmp + propagator_.fockOrtho[MZ][i]);
+
+      propagator_.fockOrtho[MZ][i] = 
+        0.5 * (tmp - propagator_.fockOrtho[MZ][i]);
+
+    }
+
+  }; // RealTime::formPropagatorInit
+
+
+
+  /**
+   *  \brief Form a component of the adjoint of the unitary propagator
    *
    *  \f[
    *    U = \exp\left( -i \delta t F \right) 
@@ -218,9 +303,15 @@ namespace ChronusQ {
    *                    \left(F^S \otimes I_2 + F^k \sigma_k\right) \right) 
    *      = \frac{1}{2}U^S \otimes I_2 + \frac{1}{2} U^k \otimes \sigma_k
    *  \f]
+   *
+   *  The components (nPropagatorComp, ALPHA and BETA for unrestricted, 
+   *  else one) are independent and may be formed concurrently between
+   *  formPropagatorInit and formPropagatorFin.
+   *
+   *  \param [in] iComp Component of the propagator
    */ 
   template <template <typename> class _SSTyp, typename T>
-  void RealTime<_SSTyp,T>::formPropagator() {
+  void RealTime<_SSTyp,T>::formPropagator(size_t iComp) {
 
     size_t NB = propagator_.aoints.basisSet().nBasis;
 
@@ -234,34 +325,11 @@ namespace ChronusQ {
 
       Scale(NB*NB,dcomplex(2.),UH[SCALAR],1);
 
-    // Unrestricted
-    } else if( UH.size() == 2 ) {
-
-      // Transform SCALAR / MZ -> ALPHA / BETA
-      for(auto i = 0; i < NB*NB; i++) {
-        dcomplex tmp = propagator_.fockOrtho[SCALAR][i];
-
-        propagator_.fockOrtho[SCALAR][i] = 
-          0.5 * (tmp + propagator_.fockOrtho[MZ][i]);
-
-        propagator_.fockOrtho[MZ][i] = 
-          0.5 * (tmp - propagator_.fockOrtho[MZ][i]);
-
-      }
+    // Unrestricted / collinear 2C (FO(A/B) from formPropagatorInit)
+    } else if( UH.size() == 2 or collinear_ ) {
 
       MatExp('D',NB,dcomplex(0.,-curState.stepSize),
-        propagator_.fockOrtho[SCALAR],NB,UH[SCALAR],NB,memManager_);
-      MatExp('D',NB,dcomplex(0.,-curState.stepSize),
-        propagator_.fockOrtho[MZ],NB,UH[MZ],NB,memManager_);
-
-      // Transform ALPHA / BETA -> SCALAR / MZ
-      for(auto i = 0; i < NB*NB; i++) {
-        dcomplex tmp = UH[SCALAR][i];
-
-        UH[SCALAR][i] = tmp + UH[MZ][i];
-        UH[MZ][i]     = tmp - UH[MZ][i];
-
-      }
+        propagator_.fockOrtho[iComp],NB,UH[iComp],NB,memManager_);
 
     // Generalized (2C)
     } else {
@@ -282,6 +350,38 @@ namespace ChronusQ {
       memManager_.free(SCR);
     }
 
+  }; // RealTime::formPropagator
+
+
+
+  /**
+   *  \brief Assemble the propagator from its components.
+   *
+   *  Unrestricted / collinear 2C: U(A/B) -> U(S/Z)
+   */ 
+  template <template <typename> class _SSTyp, typename T>
+  void RealTime<_SSTyp,T>::formPropagatorFin() {
+
+    size_t NB = propagator_.aoints.basisSet().nBasis;
+
+    if( collinear_ ) {
+      std::fill_n(UH[MY],NB*NB,dcomplex(0.));
+      std::fill_n(UH[MX],NB*NB,dcomplex(0.));
+    }
+
+    if( UH.size() == 2 or collinear_ ) {
+
+      // Transform ALPHA / BETA -> SCALAR / MZ
+      for(auto i = 0; i < NB*NB; i++) {
+        dcomplex tmp = UH[SCALAR][i];
+
+        UH[SCALAR][i] = tmp + UH[MZ][i];
+        UH[MZ][i]     = tmp - UH[MZ][i];
+
+      }
+
+    }
+
 #if 0
 
     prettyPrintSmart(std::cout,"UH Scalar",UH[SCALAR],NB,NB,NB);
@@ -290,7 +390,7 @@ namespace ChronusQ {
 
 #endif
     
-  }; // RealTime::formPropagator
+  }; // RealTime::formPropagatorFin
 
 
 
@@ -299,72 +399,71 @@ namespace ChronusQ {
   void RealTime<_SSTyp,T>::propagateWFN() {
 
     size_t NB = propagator_.aoints.basisSet().nBasis;
-    size_t NC = propagator_.nC;
-    dcomplex *SCR  = memManager_.template malloc<dcomplex>(NC*NC*NB*NB);
-    dcomplex *SCR1 = memManager_.template malloc<dcomplex>(NC*NC*NB*NB);
 
-    if( UH.size() <= 2 ) {
+    if( UH.size() == 1 ) {
 
-      // Create X(S) = (U**H * DO)(S) in SCR 
+      dcomplex *SCR = memManager_.template malloc<dcomplex>(NB*NB);
+
+      // DO(S) = 0.25 * U(S)**H * DO(S) * U(S)
 
       // SCR = 0.5 * U(S)**H * DO(S)
       Gemm('N','N',NB,NB,NB,dcomplex(0.5),UH[SCALAR],NB,
         propagator_.onePDMOrtho[SCALAR],NB,dcomplex(0.),SCR,NB);
 
-      // SCR += 0.5 * U(Z)**H * DO(Z)
-      if( UH.size() != 1 )
-        Gemm('N','N',NB,NB,NB,dcomplex(0.5),UH[MZ],NB,
-          propagator_.onePDMOrtho[MZ],NB,dcomplex(1.),SCR,NB);
-
-
-
-
+      // DO(S) = 0.5 * SCR * U(S)
+      Gemm('N','C',NB,NB,NB,dcomplex(0.5),SCR,NB,UH[SCALAR],NB,dcomplex(0.),
+        propagator_.onePDMOrtho[SCALAR],NB);
 
-      // Create X(Z) = (U**H * DO)(Z) in SCR1
-        
-      // SCR1 = 0.5 * U(S)**H * DO(Z)
-      Gemm('N','N',NB,NB,NB,dcomplex(0.5),UH[SCALAR],NB,
-        propagator_.onePDMOrtho[MZ],NB,dcomplex(0.),SCR1,NB);
+      memManager_.free(SCR);
 
-      // SCR1 += 0.5 * U(Z)**H * DO(S)
-      if( UH.size() != 1 )
-        Gemm('N','N',NB,NB,NB,dcomplex(0.5),UH[MZ],NB,
-          propagator_.onePDMOrtho[SCALAR],NB,dcomplex(1.),SCR1,NB);
+    } else if( UH.size() == 2 or collinear_ ) {
 
+      // The ALPHA and BETA densities propagate independently (the 
+      // transverse components of a collinear 2C DO are below 
+      // collinearTol and are carried unchanged)
+      //   DO(A/B) = U(A/B)**H * DO(A/B) * U(A/B)
+      // with U(A/B) = 0.5 * (U(S) +/- U(Z)), DO(A/B) = 0.5 * (DO(S) +/- DO(Z))
+      dcomplex *USpin = memManager_.template malloc<dcomplex>(6*NB*NB);
+      dcomplex *DSpin = USpin + 2*NB*NB;
+      dcomplex *XSpin = DSpin + 2*NB*NB;
 
+      for(auto i = 0; i < NB*NB; i++) {
+        USpin[i]         = 0.5 * (UH[SCALAR][i] + UH[MZ][i]);
+        USpin[i + NB*NB] = 0.5 * (UH[SCALAR][i] - UH[MZ][i]);
 
+        DSpin[i]         = 0.5 * (propagator_.onePDMOrtho[SCALAR][i] + 
+                                  propagator_.onePDMOrtho[MZ][i]);
+        DSpin[i + NB*NB] = 0.5 * (propagator_.onePDMOrtho[SCALAR][i] - 
+                                  propagator_.onePDMOrtho[MZ][i]);
+      }
 
+      TeamParallel(2,[&](size_t iSpin) {
 
+        dcomplex *U = USpin + iSpin*NB*NB;
+        dcomplex *D = DSpin + iSpin*NB*NB;
+        dcomplex *X = XSpin + iSpin*NB*NB;
 
-      // DO(S) = 0.5 * ( X(S) * U(S) + X(Z) * U(Z) )
-      //       = 0.5 * ( SCR  * U(S) + SCR1 * U(Z) )
+        // X = U**H * D
+        Gemm('N','N',NB,NB,NB,dcomplex(1.),U,NB,D,NB,dcomplex(0.),X,NB);
 
-      // DO(S) = 0.5 * SCR * U(S)
-      Gemm('N','C',NB,NB,NB,dcomplex(0.5),SCR,NB,UH[SCALAR],NB,dcomplex(0.),
-        propagator_.onePDMOrtho[SCALAR],NB);
- 
-      // DO(S) += 0.5 * SCR1 * U(Z)
-      if( UH.size() != 1 )
-        Gemm('N','C',NB,NB,NB,dcomplex(0.5),SCR1,NB,UH[MZ],NB,dcomplex(1.),
-          propagator_.onePDMOrtho[SCALAR],NB);
+        // D = X * U
+        Gemm('N','C',NB,NB,NB,dcomplex(1.),X,NB,U,NB,dcomplex(0.),D,NB);
 
+      });
 
-      if( UH.size() != 1) {
+      // DO(S) = DO(A) + DO(B), DO(Z) = DO(A) - DO(B)
+      for(auto i = 0; i < NB*NB; i++) {
+        propagator_.onePDMOrtho[SCALAR][i] = DSpin[i] + DSpin[i + NB*NB];
+        propagator_.onePDMOrtho[MZ][i]     = DSpin[i] - DSpin[i + NB*NB];
+      }
 
-        // DO(Z) = 0.5 * ( X(S) * U(Z) + X(Z) * U(S) )
-        //       = 0.5 * ( SCR  * U(Z) + SCR1 * U(S) )
-          
-        // DO(Z) = 0.5 * SCR * U(Z)
-        Gemm('N','C',NB,NB,NB,dcomplex(0.5),SCR,NB,UH[MZ],NB,dcomplex(0.),
-          propagator_.onePDMOrtho[MZ],NB);
- 
-        // DO(Z) += 0.5 * SCR1 * U(S)
-        Gemm('N','C',NB,NB,NB,dcomplex(0.5),SCR1,NB,UH[SCALAR],NB,dcomplex(1.),
-          propagator_.onePDMOrtho[MZ],NB);
+      memManager_.free(USpin);
 
-      }
     } else {
 
+      dcomplex *SCR  = memManager_.template malloc<dcomplex>(4*NB*NB);
+      dcomplex *SCR1 = memManager_.template malloc<dcomplex>(4*NB*NB);
+
       // Gather DO
       dcomplex *DO = memManager_.malloc<dcomplex>(4*NB*NB);
       SpinGather(NB,DO,2*NB,propagator_.onePDMOrtho[SCALAR],NB,
@@ -388,14 +487,12 @@ namespace ChronusQ {
         propagator_.onePDMOrtho[MX],NB);
 
       // Free memory
-      memManager_.free(DO);
+      memManager_.free(DO,SCR,SCR1);
     }
 
 
     propagator_.ortho2aoDen();
 
-    memManager_.free(SCR,SCR1);
-
   }; // RealTime::propagatorWFN
 
 
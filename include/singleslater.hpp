@@ -27,6 +27,7 @@
 #include <chronusq_sys.hpp>
 #include <wavefunction.hpp>
 #include <singleslater/base.hpp>
+#include <cqlinalg/blasext.hpp>
 
 // Debug print triggered by Wavefunction
   
@@ -57,6 +58,16 @@ namespace ChronusQ {
     typedef std::vector<oper_t_coll>  oper_t_coll2;
 
   private:
+
+    // Pending state of a split G[D] build (see formGDPrep / formGDFin)
+    T*     JContract_ = nullptr; ///< Complex Coulomb scratch (T = dcomplex)
+    double gdXHFX_    = 1.;      ///< Exchange scaling of the pending G[D]
+    bool   collinear_ = false;   ///< Whether the last G[D] was collinear (2C)
+
+    // # of pseudo-diagonalizations since the last full diagonalization
+    // (-1 = the orthonormal MOs / eigenvalues are not available)
+    int nPseudoDiag_ = -1;
+
   public:
 
     // Operator storage
@@ -179,11 +190,30 @@ namespace ChronusQ {
     virtual void formFock(EMPerturbation &, bool increment = false, double xHFX = 1.);
     void formGD(bool increment = false, double xHFX = 1.);
 
+    // Split Fock build: the G[D] contractions of several determinants
+    // may be batched into a single twoBodyContract call between the
+    // Prep and Fin stages (see include/singleslater/fock.hpp for docs)
+    void formGDPrep(bool, double, std::vector<TwoBodyContraction<T,T>> &);
+    void formGDFin(bool increment = false);
+    virtual void formFockPrep(bool, std::vector<TwoBodyContraction<T,T>> &);
+    void formFockFin(EMPerturbation &, bool increment = false);
+    void assembleFock(EMPerturbation &);
+
+    // Two-component spin collinearity (see include/singleslater/fock.hpp)
+    bool isSpinCollinear(const oper_t_coll &) const;
+
+    /**
+     *  \brief Append method specific (real) terms to the i-th component
+     *  of the Fock matrix (see formFock)
+     */ 
+    virtual void addFockTerms(size_t, std::vector<RealLinCombTerm>&) { };
+
     // Form initial guess orbitals
     // see include/singleslater/guess.hpp for docs)
     void formGuess();
     void CoreGuess();
     void SADGuess();
+    void SAPGuess();
     void RandomGuess();
     
 
@@ -201,9 +231,12 @@ namespace ChronusQ {
 
     // Obtain new orbitals
     void getNewOrbitals(EMPerturbation &, bool frmFock = true);
+    void getNewOrbitalsFromFock(bool doExtrap = true);
 
     // Misc procedural
+    void gatherOrthoFock(T*, T*);
     void diagOrthoFock();
+    bool pseudoDiagOrthoFock();
     void FDCommutator(oper_t_coll &);
     virtual void saveCurrentState();
     virtual void formDelta();
@@ -219,6 +252,29 @@ namespace ChronusQ {
     void printMiscProperties(std::ostream&);
     void printMOInfo(std::ostream&); 
 
+    // Volumetric output (see include/singleslater/cube.hpp for docs)
+    void writeCube(const std::string &prefix, const CubeGrid &,
+      const std::vector<size_t> &moIdx = {});
+
+    // Nuclear gradients (see include/singleslater/gradient.hpp for docs)
+    std::vector<double> formGradient(double xHFX = 1.);
+    virtual std::vector<double> computeGradient() { return formGradient(); }
+
+    // Linear response (see include/singleslater/response.hpp for docs)
+    std::vector<double> formPolarizability(ResponseControls &, 
+      double xHFX = 1.);
+    virtual std::vector<double> computePolarizability(ResponseControls &ctl) {
+      return formPolarizability(ctl);
+    }
+
+    /**
+     *  \brief Increment the (S,Z) components of the Fock matrix response
+     *  with the method specific response to a set of trial densities
+     *  (see formPolarizability)
+     */ 
+    virtual void formKernelResponse(std::vector<std::vector<double*>> &,
+      std::vector<std::vector<double*>> &) { };
+
     // SCF extrapolation functions (see include/singleslater/extrap.hpp for docs)
     void allocExtrapStorage();
     void deallocExtrapStorage();
@@ -228,6 +284,13 @@ namespace ChronusQ {
 
   }; // class SingleSlater
 
+
+  // Converge a set of SingleSlater objects in lockstep
+  // (see include/singleslater/lockstep.hpp for docs)
+  template <typename T>
+  void LockstepSCF(std::vector<SingleSlater<T>*> &,
+    std::vector<EMPerturbation> &);
+
 }; // namespace ChronusQ
 
 
@@ -29,6 +29,8 @@
 
 #include <fields.hpp>
 #include <util/files.hpp>
+#include <basisset/cube.hpp>
+#include <cqlinalg/krylov.hpp>
 
 namespace ChronusQ {
 
@@ -45,7 +47,17 @@ namespace ChronusQ {
   enum SS_GUESS {
     CORE,
     SAD,
-    RANDOM
+    RANDOM,
+    SAP
+  };
+
+  /**
+   *  Fractional occupation (smearing) types for the SCF
+   */ 
+  enum SMEARING_TYPE {
+    NO_SMEARING,
+    FERMI_SMEARING,   ///< Fermi-Dirac occupations
+    GAUSSIAN_SMEARING ///< Gaussian (erfc) occupations
   };
 
   /**
@@ -82,9 +94,39 @@ namespace ChronusQ {
     bool   doIncFock = true; ///< Whether to perform an incremental fock build
     size_t nIncFock  = 20;   ///< Restart incremental fock build after n steps
 
+    // Level shift settings
+    double levelShift      = 0.;   ///< Virtual space level shift (Eh)
+    double levelShiftTol   = 1e-3; ///< Density change to anneal the shift
+    double levelShiftScale = 0.5;  ///< Annealing factor of the shift
+    double curLevelShift   = 0.;   ///< Current level shift (Eh)
+
+    // Fractional occupation settings
+    SMEARING_TYPE smearType = NO_SMEARING; ///< Type of smearing
+    double smearTemp    = 1e-2; ///< Starting smearing width kT (Eh)
+    double smearTol     = 1e-3; ///< Density change to anneal the width
+    double smearScale   = 0.5;  ///< Annealing factor of the width
+    double smearMinTemp = 1e-5; ///< Width below which smearing is disabled
+    double curSmearTemp = 0.;   ///< Current smearing width (Eh)
+
+    // Two-component collinearity settings
+    double collinearTol = 0.; ///< Max transverse magnetization treated
+                              ///< as collinear (0 = off). Opt-in: a
+                              ///< collinear density never develops the
+                              ///< transverse K needed to break symmetry
+
+    // Pseudo-diagonalization settings
+    double pseudoDiagTol = 0.; ///< DIIS error below which the Fock matrix
+                               ///< is pseudo-diagonalized (0 = off)
+    size_t nPseudoDiag   = 5;  ///< Full diagonalization every n steps
+
     // Misc control
     size_t maxSCFIter = 128; ///< Maximum SCF iterations.
 
+    // Cube output of the converged wave function
+    bool   cubeOutput  = false; ///< Whether to write cube files
+    double cubeSpacing = 0.2;   ///< Cube grid spacing (Bohr)
+    std::vector<size_t> cubeMOs; ///< MOs to write (0-based)
+
   }; // SCFControls struct
 
   /**
@@ -105,6 +147,20 @@ namespace ChronusQ {
   }; // SCFConvergence struct
 
 
+  /**
+   *  \brief A struct to hold the information pertaining to the control
+   *  of a (frequency dependent) linear response calculation.
+   */ 
+  struct ResponseControls {
+
+    std::vector<double> freq = {0.};   ///< Frequencies (Eh)
+    KRYLOV_ALGORITHM alg = KRYLOV_MINRES; ///< Krylov solver
+    double convTol = 1e-6;             ///< Relative residual criteria
+    size_t maxIter = 100;              ///< Maximum Krylov iterations
+
+  }; // ResponseControls struct
+
+
   /**
    *  \brief The SingleSlaterBase class. The abstraction of information
    *  relating to the SingleSlater class which are independent of storage
@@ -188,6 +244,20 @@ namespace ChronusQ {
     virtual void printJ(std::ostream&)         = 0;
     virtual void printK(std::ostream&)         = 0;
 
+    //  10. Write the densities (and selected MOs) to cube files
+    virtual void writeCube(const std::string &prefix, const CubeGrid &,
+      const std::vector<size_t> &moIdx = {}) = 0;
+
+    //  11. Evaluate the analytic nuclear gradient of the energy
+    virtual std::vector<double> computeGradient() = 0;
+
+    //  12. Discard geometry dependent intermediates after the nuclei
+    //      have been moved
+    virtual void clearGeometry() { };
+
+    //  13. Evaluate the dipole polarizability by linear response
+    virtual std::vector<double> computePolarizability(ResponseControls &) = 0;
+
     // Procedural Functions to be shared among all derived classes
       
     // Perform an SCF procedure (see include/singleslater/scf.hpp for docs)
@@ -45,6 +45,11 @@ namespace ChronusQ {
     scfControls.dampParam = scfControls.dampStartParam;
     scfControls.doIncFock = scfControls.doIncFock and (aoints.cAlg == DIRECT);
 
+    // Convergence aids start at their full strength
+    scfControls.curLevelShift = scfControls.levelShift;
+    scfControls.curSmearTemp  = 
+      (scfControls.smearType == NO_SMEARING) ? 0. : scfControls.smearTemp;
+
     if( printLevel > 0 ) printSCFHeader(std::cout,pert);
 
     for( scfConv.nSCFIter = 0; scfConv.nSCFIter < scfControls.maxSCFIter; 
@@ -68,6 +73,9 @@ namespace ChronusQ {
 
     }; // Iteration loop
 
+    scfControls.curLevelShift = 0.;
+    scfControls.curSmearTemp  = 0.;
+
     // Save current state of the wave function (method specific)
     saveCurrentState();
 
@@ -145,6 +153,32 @@ namespace ChronusQ {
     }
 
 
+    if( scfControls.levelShift > 0. ) {
+      out << std::setw(38)   << std::left << "  Level Shift (Eh):" 
+             <<  scfControls.levelShift << std::endl;
+      out << std::left << "    * Level shift is annealed below a density"
+          << " change of " << scfControls.levelShiftTol << std::endl;
+    }
+
+    if( scfControls.pseudoDiagTol > 0. ) {
+      out << std::setw(38)   << std::left << "  Pseudo-Diagonalization Tol:" 
+             <<  scfControls.pseudoDiagTol << std::endl;
+      out << std::left << "    * Full diagonalization every " 
+          << scfControls.nPseudoDiag << " iterations" << std::endl;
+    }
+
+    if( scfControls.smearType != NO_SMEARING ) {
+      out << std::setw(38)   << std::left << "  Occupation Smearing:";
+      if( scfControls.smearType == FERMI_SMEARING ) out << "Fermi-Dirac";
+      else                                          out << "Gaussian";
+      out << std::endl;
+      out << std::setw(38)   << std::left << "  Smearing Width (Eh):" 
+             <<  scfControls.smearTemp << std::endl;
+      out << std::left << "    * Smearing width is annealed below a density"
+          << " change of " << scfControls.smearTol << std::endl;
+    }
+
+
     if( scfControls.doIncFock ) {
       out << "\n  * Will Perform Incremental Fock Build -- Restarting Every "
           << scfControls.nIncFock << " SCF Steps\n";
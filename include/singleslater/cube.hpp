@@ -0,0 +1,96 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_SINGLESLATER_CUBE_HPP__
+#define __INCLUDED_SINGLESLATER_CUBE_HPP__
+
+#include <singleslater.hpp>
+#include <basisset/cube.hpp>
+#include <cqlinalg/blasutil.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Write the densities and, optionally, a set of MOs to cube
+   *  files.
+   *
+   *  Writes <prefix>_den.cube (scalar density), the magnetization
+   *  components <prefix>_mz.cube (spin density), <prefix>_my.cube and
+   *  <prefix>_mx.cube if present, and the requested (real part of the)
+   *  MOs to <prefix>_mo.cube (and <prefix>_mo_beta.cube for unrestricted
+   *  references).
+   *
+   *  \param [in] prefix  Prefix of the cube files
+   *  \param [in] grid    Volumetric grid
+   *  \param [in] moIdx   MOs to write (0-based)
+   */ 
+  template <typename T>
+  void SingleSlater<T>::writeCube(const std::string &prefix, 
+    const CubeGrid &grid, const std::vector<size_t> &moIdx) {
+
+    BasisSet &basis = aoints.basisSet();
+    const size_t NB = basis.nBasis;
+
+    CubeWriter cube(this->memManager,aoints.molecule(),basis,grid);
+
+    double *ReSCR = this->memManager.template malloc<double>(this->nC*this->nC*NB*NB);
+
+    std::array<std::string,4> denNames = {"den","mz","my","mx"};
+    std::array<std::string,4> denLabel = 
+      {"Scalar Density", "Magnetization (Z)", "Magnetization (Y)",
+       "Magnetization (X)"};
+
+    for(auto i = 0; i < this->onePDM.size(); i++) {
+      GetMatRE('N',NB,NB,1.,this->onePDM[i],NB,ReSCR,NB);
+      cube.writeDensity(prefix + "_" + denNames[i] + ".cube",
+        refShortName_ + " " + denLabel[i],ReSCR,NB);
+    }
+
+    if( not moIdx.empty() ) {
+
+      if( this->nC != 1 )
+        CErr("Cube output of 2C MOs NYI",std::cout);
+
+      for(auto &i : moIdx)
+        if( i >= NB ) CErr("Requested MO for cube output out of range",
+          std::cout);
+
+      GetMatRE('N',NB,NB,1.,this->mo1,NB,ReSCR,NB);
+      cube.writeOrbitals(prefix + "_mo.cube", 
+        refShortName_ + " Molecular Orbitals",ReSCR,NB,moIdx);
+
+      if( not this->iCS ) {
+        GetMatRE('N',NB,NB,1.,this->mo2,NB,ReSCR,NB);
+        cube.writeOrbitals(prefix + "_mo_beta.cube", 
+          refShortName_ + " Molecular Orbitals (Beta)",ReSCR,NB,moIdx);
+      }
+
+    }
+
+    this->memManager.free(ReSCR);
+
+  }; // SingleSlater::writeCube
+
+}; // namespace ChronusQ
+
+#endif
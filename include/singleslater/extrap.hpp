@@ -76,7 +76,11 @@ namespace ChronusQ {
           prevFock[i], NB, fockOrtho[i], NB);
     else {
 
-      T* FSCR = this->memManager.template malloc<T>(NB*NB);
+      const BasisSet &basis = aoints.basisSet();
+
+      T* FSCR  = this->memManager.template malloc<T>(NB*NB);
+      T* FSCR2 = basis.reordered ? 
+        this->memManager.template malloc<T>(NB*NB) : nullptr;
       const std::array<std::string,4> spinLabel =
         { "SCALAR", "MZ", "MY", "MX" };
 
@@ -84,12 +88,19 @@ namespace ChronusQ {
 
         savFile.readData("/SCF/FOCK_ORTHO_" + spinLabel[i],FSCR);
 
+        // Saved in the original (input) basis ordering
+        if( basis.reordered ) {
+          basis.toInternalOrder(NB,true,FSCR,NB,FSCR2,NB);
+          std::copy_n(FSCR2,NB*NB,FSCR);
+        }
+
         MatAdd('N','N', NB, NB, T(1-dp), fockOrtho[i], NB, T(dp), 
          FSCR, NB, fockOrtho[i], NB);
 
       }
 
       this->memManager.free(FSCR);
+      if( FSCR2 ) this->memManager.free(FSCR2);
     }
 
   }; // SingleSlater<T>::fockDamping
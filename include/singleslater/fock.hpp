@@ -41,40 +41,96 @@ namespace ChronusQ {
   template <typename T>
   void SingleSlater<T>::formFock(EMPerturbation &pert, bool increment, double xHFX) {
 
-    size_t NB = aoints.basisSet().nBasis;
-    size_t NB2 = NB*NB;
-
     // Form G[D]
     formGD(increment,xHFX);
 
-    // Zero out the Fock
-    for(auto &F : fock) std::fill_n(F,NB2,0.);
+    // F = H + G[D] + ...
+    assembleFock(pert);
+
+#if 0
+    printFock(std::cout);
+#endif
+
+  }; // SingleSlater<T>::fockFock
+
+
+  /**
+   *  \brief First stage of a split Fock build. Performs the method
+   *  specific work which precedes G[D] and appends the G[D]
+   *  contractions of this determinant to a (possibly shared) list.
+   *
+   *  Equivalent to formFock when followed by aoints.twoBodyContract
+   *  and formFockFin.
+   *
+   *  \param [in]     increment Whether or not the Fock matrix is being 
+   *                            incremented using a previous density
+   *  \param [in/out] contract  List of contractions
+   */ 
+  template <typename T>
+  void SingleSlater<T>::formFockPrep(bool increment,
+    std::vector<TwoBodyContraction<T,T>> &contract) {
+
+    formGDPrep(increment,1.,contract);
+
+  }; // SingleSlater<T>::formFockPrep
+
+
+  /**
+   *  \brief Final stage of a split Fock build (see formFockPrep). 
+   *  Requires that the contractions from formFockPrep have been
+   *  evaluated.
+   *
+   *  Populates / overwrites fock strorage
+   */ 
+  template <typename T>
+  void SingleSlater<T>::formFockFin(EMPerturbation &pert, bool increment) {
+
+    formGDFin(increment);
+    assembleFock(pert);
 
-    // Copy over the Core Hamiltonian
-    SetMatRE('N',NB,NB,1.,aoints.coreH[SCALAR],NB,fock[SCALAR],NB);
-    for(auto i = 1; i < aoints.coreH.size(); i++) 
-      SetMatIM('N',NB,NB,1.,aoints.coreH[i],NB,fock[i],NB);
+  }; // SingleSlater<T>::formFockFin
 
-    // Add in the perturbation tensor
-    for(auto i = 0ul; i < fock.size(); i++)
-      MatAdd('N','N', NB, NB, T(1.), fock[i], NB, T(1.), GD[i], NB,
-        fock[i], NB);
 
+  /**
+   *  \brief Assembles the Fock matrix from the core Hamiltonian, G[D],
+   *  the dipole field and the method specific terms.
+   *
+   *  Populates / overwrites fock strorage
+   */ 
+  template <typename T>
+  void SingleSlater<T>::assembleFock(EMPerturbation &pert) {
 
-    if(pert.fields.size() != 0) {
-      auto dipole = pert.getAmp();
+    size_t NB = aoints.basisSet().nBasis;
 
+    // Dipole field amplitude
+    std::valarray<double> dipole(0.,3);
+    if(pert.fields.size() != 0) dipole = pert.getAmp();
+
+    // F = H + G[D] (- 2 * E.dipole) (+ method specific terms) in a 
+    // single sweep for each component
+    for(auto i = 0ul; i < fock.size(); i++) {
+
+      std::vector<LinCombTerm<T>> terms = { {T(1.), GD[i], NB} };
+      std::vector<RealLinCombTerm> realTerms;
+
+      // Core Hamiltonian (spin components are purely imaginary)
+      if( i < aoints.coreH.size() )
+        realTerms.push_back({1., aoints.coreH[i], NB, i != SCALAR});
+
+      // Dipole field
+      if( i == SCALAR )
       for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
         if(std::abs(dipole[iXYZ]) > 1e-10)
-          MatAdd('N','N', NB, NB, T(1.), fock[0], NB, T(-2*dipole[iXYZ]), 
-            this->aoints.lenElecDipole[iXYZ], NB, fock[0], NB);
-    };
+          realTerms.push_back(
+            {-2*dipole[iXYZ], this->aoints.lenElecDipole[iXYZ], NB, false});
 
-#if 0
-    printFock(std::cout);
-#endif
+      addFockTerms(i,realTerms);
 
-  }; // SingleSlater<T>::fockFock
+      MatLinComb(NB,NB,T(0.),fock[i],NB,terms,realTerms);
+
+    }
+
+  }; // SingleSlater<T>::assembleFock
 
 
   /**
@@ -85,72 +141,145 @@ namespace ChronusQ {
   template <typename T>
   void SingleSlater<T>::formGD(bool increment, double xHFX) {
 
+    std::vector<TwoBodyContraction<T,T>> contract;
+
+    formGDPrep(increment,xHFX,contract);
+    aoints.twoBodyContract(contract);
+    formGDFin(increment);
+      
+#if 0
+    printJ(std::cout);
+    printK(std::cout);
+    printGD(std::cout);
+#endif
+
+  }; // SingleSlater<T>::formGD
+
+
+  /**
+   *  \brief Prepares the J / K storage for a G[D] build and appends
+   *  the associated contractions to a list.
+   *
+   *  \param [in]     increment Whether or not G[D] is being incremented
+   *  \param [in]     xHFX      Scaling of the exact exchange
+   *  \param [in/out] contract  List of contractions
+   */ 
+  template <typename T>
+  void SingleSlater<T>::formGDPrep(bool increment, double xHFX,
+    std::vector<TwoBodyContraction<T,T>> &contract) {
+
     // Decide list of onePDMs to use
     oper_t_coll &contract1PDM  = increment ? deltaOnePDM : this->onePDM;
 
     size_t NB = aoints.basisSet().nBasis;
     size_t NB2 = NB*NB;
 
+    gdXHFX_ = xHFX;
+
     // Possibly allocate a temporary for J matrix
-    T* JContract;
     if(std::is_same<double,T>::value) 
-      JContract = reinterpret_cast<T*>(JScalar);
+      JContract_ = reinterpret_cast<T*>(JScalar);
     else {
-      JContract = this->memManager.template malloc<T>(NB2);
+      JContract_ = this->memManager.template malloc<T>(NB2);
     }
 
     // Zero out J
     if(not increment or not std::is_same<double,T>::value)
-      memset(JContract,0,NB2*sizeof(T));
+      memset(JContract_,0,NB2*sizeof(T));
+
+    contract.push_back({contract1PDM[SCALAR], JContract_, true, COULOMB});
 
-    std::vector<TwoBodyContraction<T,T>> contract =
-      { {contract1PDM[SCALAR], JContract, true, COULOMB} };
+    // Two-component: the transverse (MY / MX) exchange vanishes while the
+    // magnetization is collinear. On the loss of collinearity it is
+    // rebuilt from the full density.
+    bool wasCollinear = collinear_;
+    collinear_ = isSpinCollinear(this->onePDM);
 
     // Determine how many (if any) exchange terms to calculate
     if( std::abs(xHFX) > 1e-12 )
     for(auto i = 0; i < K.size(); i++) {
-      contract.push_back({contract1PDM[i], K[i], true, EXCHANGE});
+
+      bool transverse = (i == MY or i == MX);
+
+      if( collinear_ and transverse ) {
+        memset(K[i],0,NB2*sizeof(T));
+        continue;
+      }
+
+      bool fullK = not increment or (wasCollinear and transverse);
+
+      contract.push_back({fullK ? this->onePDM[i] : contract1PDM[i], K[i], 
+        true, EXCHANGE});
 
       // Zero out K[i]
-      if(not increment) memset(K[i],0,NB2*sizeof(T));
+      if(fullK) memset(K[i],0,NB2*sizeof(T));
     }
 
-    aoints.twoBodyContract(contract);
+  }; // SingleSlater<T>::formGDPrep
+
+
+  /**
+   *  \brief Forms G[D] from the evaluated contractions of formGDPrep.
+   *
+   *  Populates / overwrites GD storage (and JScalar storage)
+   */ 
+  template <typename T>
+  void SingleSlater<T>::formGDFin(bool increment) {
+
+    size_t NB = aoints.basisSet().nBasis;
+    double xHFX = gdXHFX_;
 
     if(not std::is_same<double,T>::value) {
       if(not increment)
-        GetMatRE('N',NB,NB,1.,JContract,NB,JScalar,NB);
+        GetMatRE('N',NB,NB,1.,JContract_,NB,JScalar,NB);
       else {
-        MatAdd('N','N',NB,NB,T(1.),JContract,NB,T(1.),
-          JScalar,NB,JContract,NB);
-        GetMatRE('N',NB,NB,1.,JContract,NB,JScalar,NB);
+        MatAdd('N','N',NB,NB,T(1.),JContract_,NB,T(1.),
+          JScalar,NB,JContract_,NB);
+        GetMatRE('N',NB,NB,1.,JContract_,NB,JScalar,NB);
       }
-      this->memManager.free(JContract);
+      this->memManager.free(JContract_);
     }
+    JContract_ = nullptr;
 
     // Form GD: G[D] = 2.0*J[D] - K[D]
+    for(auto i = 0; i < fock.size(); i++) {
 
-    if( std::abs(xHFX) > 1e-12 )
-    for(auto i = 0; i < K.size(); i++)
-      MatAdd('N','N', NB, NB, T(0.), GD[i], NB, T(-xHFX), K[i], NB,
-        GD[i], NB);
-    else
-    for(auto i = 0; i < fock.size(); i++)
-      memset(GD[i],0,NB2*sizeof(T));
-    
-    
-
-    // G[D] += 2*J[D]
-    MatAdd('N','N', NB, NB, T(1.), GD[SCALAR], NB, T(2.), JScalar, NB,
-      GD[SCALAR], NB);
-      
-#if 0
-    printJ(std::cout);
-    printK(std::cout);
-    printGD(std::cout);
-#endif
+      std::vector<LinCombTerm<T>> terms;
+      std::vector<RealLinCombTerm> realTerms;
 
-  }; // SingleSlater<T>::formGD
+      if( std::abs(xHFX) > 1e-12 ) terms.push_back({T(-xHFX), K[i], NB});
+      if( i == SCALAR ) realTerms.push_back({2., JScalar, NB, false});
+
+      MatLinComb(NB,NB,T(0.),GD[i],NB,terms,realTerms);
+
+    }
+
+  }; // SingleSlater<T>::formGDFin
+
+
+  /**
+   *  \brief Determine whether or not a (two-component) spin operator is
+   *  collinear along Z, i.e. whether its transverse (MY / MX) components
+   *  vanish to within SCFControls::collinearTol.
+   *
+   *  \param [in] X  Spin components of the operator
+   *  \returns       Collinearity (always false for 1C or collinearTol = 0)
+   */ 
+  template <typename T>
+  bool SingleSlater<T>::isSpinCollinear(const oper_t_coll &X) const {
+
+    if( this->nC != 2 or X.size() != 4 or scfControls.collinearTol <= 0. ) 
+      return false;
+
+    size_t NB2 = aoints.basisSet().nBasis * aoints.basisSet().nBasis;
+
+    for(auto i : {MY, MX})
+    for(auto j = 0ul; j < NB2; j++)
+      if( std::abs(X[i][j]) > scfControls.collinearTol ) return false;
+
+    return true;
+
+  }; // SingleSlater<T>::isSpinCollinear
 
 }; // namespace ChronusQ
 
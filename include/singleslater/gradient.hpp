@@ -0,0 +1,125 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_SINGLESLATER_GRADIENT_HPP__
+#define __INCLUDED_SINGLESLATER_GRADIENT_HPP__
+
+#include <singleslater.hpp>
+#include <cqlinalg/blas3.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Evaluate the analytic nuclear gradient of a converged
+   *  (real, 1C) single determinant energy, excluding any XC contribution.
+   *
+   *  \f[
+   *    \frac{\partial E}{\partial R_A} = 
+   *      \sum_{\mu\nu} P_{\mu\nu} \frac{\partial h_{\mu\nu}}{\partial R_A}
+   *      - \sum_{\mu\nu} W_{\mu\nu} \frac{\partial S_{\mu\nu}}{\partial R_A}
+   *      + \frac{\partial E_2}{\partial R_A} 
+   *      + \frac{\partial V_{NN}}{\partial R_A}
+   *  \f]
+   *
+   *  with the energy weighted density 
+   *  \f$ W = \sum_s \sum_i^{occ} \varepsilon_i^s C^s_i C^{s\dagger}_i \f$.
+   *
+   *  \warning Assumes the SCF has converged and the MOs are in the AO
+   *  basis (see SCFFin).
+   *
+   *  \param [in] xHFX  Scaling of the exact exchange
+   *  \returns          Gradient, stored (x,y,z) for each atom
+   */ 
+  template <typename T>
+  std::vector<double> SingleSlater<T>::formGradient(double xHFX) {
+
+    if( not std::is_same<T,double>::value or this->nC != 1 )
+      CErr("Analytic gradients are only implemented for real 1C references",
+        std::cout);
+
+    if( aoints.coreType != NON_RELATIVISTIC )
+      CErr("Analytic gradients are only implemented for the "
+           "non-relativistic Hamiltonian",std::cout);
+
+    size_t NB  = aoints.basisSet().nBasis;
+    size_t NB2 = NB*NB;
+    Molecule &mol = aoints.molecule();
+
+    // Real storage is assured above
+    double *DS  = reinterpret_cast<double*>(this->onePDM[SCALAR]);
+    double *MO1 = reinterpret_cast<double*>(this->mo1);
+    double *MO2 = this->iCS ? MO1 : reinterpret_cast<double*>(this->mo2);
+
+    // Spin densities DA = 0.5 * (DS + DZ), DB = 0.5 * (DS - DZ)
+    std::vector<double*> DSpin;
+    for(auto iS = 0; iS < 2; iS++) {
+      DSpin.emplace_back(this->memManager.template malloc<double>(NB2));
+
+      if( this->iCS ) 
+        for(auto j = 0ul; j < NB2; j++) DSpin.back()[j] = 0.5 * DS[j];
+      else {
+        double *DZ = reinterpret_cast<double*>(this->onePDM[MZ]);
+        double fZ  = iS ? -0.5 : 0.5;
+        for(auto j = 0ul; j < NB2; j++) 
+          DSpin.back()[j] = 0.5 * DS[j] + fZ * DZ[j];
+      }
+    }
+
+    // Energy weighted density
+    double *W   = this->memManager.template malloc<double>(NB2);
+    double *SCR = this->memManager.template malloc<double>(NB2);
+    std::fill_n(W,NB2,0.);
+
+    for(auto iS = 0; iS < 2; iS++) {
+
+      double *C   = iS ? MO2 : MO1;
+      double *eps = (iS and not this->iCS) ? this->eps2 : this->eps1;
+      size_t nOcc = iS ? this->nOB : this->nOA;
+
+      if( nOcc == 0 ) continue;
+
+      for(auto i = 0ul; i < nOcc; i++)
+      for(auto mu = 0ul; mu < NB; mu++)
+        SCR[mu + i*NB] = eps[i] * C[mu + i*NB];
+
+      Gemm('N','T',NB,NB,nOcc,1.,SCR,NB,C,NB,1.,W,NB);
+
+    }
+
+    std::vector<double> grad = aoints.oneEGradient(DS,W);
+    std::vector<double> grad2e = aoints.twoEGradient(DS,DSpin,xHFX);
+
+    for(auto iAtm = 0; iAtm < mol.nAtoms; iAtm++)
+    for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+      grad[3*iAtm + iXYZ] += grad2e[3*iAtm + iXYZ] + 
+        mol.nucRepForce[iAtm][iXYZ];
+
+    this->memManager.free(W,SCR,DSpin[0],DSpin[1]);
+
+    return grad;
+
+  }; // SingleSlater<T>::formGradient
+
+}; // namespace ChronusQ
+
+#endif
@@ -27,6 +27,7 @@
 #include <singleslater.hpp>
 #include <cqlinalg.hpp>
 #include <util/matout.hpp>
+#include <grid/integrator.hpp>
 
 namespace ChronusQ {
 
@@ -89,7 +90,8 @@ namespace ChronusQ {
       std::cout << "  *** Forming Initial Guess Density for SCF Procedure ***"
                 << std::endl << std::endl;
 
-    if( aoints.molecule().nAtoms == 1  or scfControls.guess == CORE)
+    if( scfControls.guess == SAP ) SAPGuess();
+    else if( aoints.molecule().nAtoms == 1  or scfControls.guess == CORE)
       CoreGuess();
     else if( scfControls.guess == SAD ) SADGuess();
     else if( scfControls.guess == RANDOM ) RandomGuess();
@@ -257,6 +259,9 @@ namespace ChronusQ {
       Molecule atom(0,defaultMultip,{ uniqueElements[iUn] });
       BasisSet basis(aoints.basisSet().basisName, atom, 
                  aoints.basisSet().forceCart, false);
+
+      // Match the intra-atomic shell ordering of the molecular basis
+      if( aoints.basisSet().reordered ) basis.reorderShells();
      
       AOIntegrals aointsAtom(this->memManager,atom,basis);
       
@@ -309,6 +314,152 @@ namespace ChronusQ {
 
 
 
+  /**
+   *  \brief Forms the Superposition of Atomic Potentials (SAP) guess
+   *  Fock matrix.
+   *
+   *  F = H + V_SAP, where V_SAP is the sum of the potentials of the 
+   *  neutral atom electron clouds in the Thomas-Fermi model using the
+   *  Moliere screening function
+   *
+   *    V_A(r) = Z_A (1 - phi(r / b_A)) / r,  b_A = 0.8853 Z_A^{-1/3}
+   *    phi(x) = 0.35 exp(-0.3x) + 0.55 exp(-1.2x) + 0.10 exp(-6x)
+   *
+   *  As the nuclear attraction is contained in H, V_SAP is smooth and
+   *  is integrated on the Becke grid. Only the scalar part of the Fock 
+   *  matrix is modified, so the guess is applicable to all references.
+   */ 
+  template <typename T>
+  void SingleSlater<T>::SAPGuess() {
+
+    if( printLevel > 0 )
+      std::cout << "    * Forming the Superposition of Atomic Potentials Guess"
+                << " (SAP)\n\n";
+
+    Molecule &mol   = aoints.molecule();
+    BasisSet &basis = aoints.basisSet();
+
+    size_t NB       = basis.nBasis;
+    size_t nthreads = GetNumThreads();
+
+    // Grid parameters
+    const size_t nRad         = 100;
+    const size_t nAng         = 302;
+    const size_t nRadPerBatch = 4;
+    const double epsilon      = 1e-12;
+
+    const size_t NPtsMaxPerBatch = nRadPerBatch * nAng;
+
+
+    // Zero out the Fock
+    for(auto &F : fock) std::fill_n(F,NB*NB,0.);
+
+    // Copy over the Core Hamiltonian
+    SetMatRE('N',NB,NB,1.,aoints.coreH[SCALAR],NB,fock[SCALAR],NB);
+    for(auto i = 1; i < aoints.coreH.size(); i++) 
+      SetMatIM('N',NB,NB,1.,aoints.coreH[i],NB,fock[i],NB);
+
+
+    // Thomas-Fermi screening lengths
+    std::vector<double> bTF;
+    for(auto &atom : mol.atoms)
+      bTF.emplace_back(0.8853 * std::pow(double(atom.atomicNumber),-1./3.));
+
+    // Moliere screening function
+    auto moliere = [](double x) -> double {
+      return 0.35 * std::exp(-0.3 * x) + 0.55 * std::exp(-1.2 * x) +
+             0.10 * std::exp(-6.0 * x);
+    };
+
+    // Limit of (1 - phi(x)) / x as x -> 0
+    const double dMoliere0 = 0.35 * 0.3 + 0.55 * 1.2 + 0.10 * 6.0;
+
+
+    size_t LAThreads = GetLAThreads();
+    SetLAThreads(1);
+
+    double *VSAP = memManager.template malloc<double>(nthreads*NB*NB);
+    double *SCR  = memManager.template malloc<double>(nthreads*NB*NB);
+    double *ZMAT = 
+      memManager.template malloc<double>(nthreads*NPtsMaxPerBatch*NB);
+
+    std::fill_n(VSAP,nthreads*NB*NB,0.);
+
+    // The result and the evaluated shell list are not needed
+    auto sapbuild = [&](size_t &, std::vector<cart_t> &batch, 
+      std::vector<double> &weights, size_t NBE, double *BasisEval, 
+      std::vector<size_t> &, 
+      std::vector<std::pair<size_t,size_t>> &subMatCut) {
+
+      size_t thread_id = GetThreadID();
+      size_t NPts      = batch.size();
+
+      double *ZMAT_loc = ZMAT + thread_id * NPtsMaxPerBatch * NB;
+      double *SCR_loc  = SCR  + thread_id * NB * NB;
+
+      for(auto iPt = 0; iPt < NPts; iPt++) {
+
+        // Evaluate the SAP at the current point
+        double V = 0.;
+        for(auto iAtm = 0; iAtm < mol.nAtoms; iAtm++) {
+
+          double dx = batch[iPt][0] - mol.atoms[iAtm].coord[0];
+          double dy = batch[iPt][1] - mol.atoms[iAtm].coord[1];
+          double dz = batch[iPt][2] - mol.atoms[iAtm].coord[2];
+          double r  = std::sqrt(dx*dx + dy*dy + dz*dz);
+
+          double Z = mol.atoms[iAtm].atomicNumber;
+          double x = r / bTF[iAtm];
+
+          if( x < 1e-8 ) V += Z * dMoliere0 / bTF[iAtm];
+          else           V += Z * (1. - moliere(x)) / r;
+
+        }
+
+        // Factor of 1/2 as DSYR2K forms B * Z**T + Z * B**T
+        double fact = 0.5 * weights[iPt] * V;
+        for(auto mu = 0; mu < NBE; mu++)
+          ZMAT_loc[mu + iPt*NBE] = fact * BasisEval[mu + iPt*NBE];
+
+      }
+
+      // V(mu,nu) = sum_p w(p) V(p) chi_mu(p) chi_nu(p)
+      DSYR2K('L','N',NBE,NPts,1.,BasisEval,NBE,ZMAT_loc,NBE,0.,SCR_loc,NBE);
+
+      IncBySubMat(NB,NB,NBE,NBE,VSAP + thread_id*NB*NB,NB,SCR_loc,NBE,
+        subMatCut);
+
+    }; // SAP integrate
+
+
+    BeckeIntegrator<EulerMac> 
+      integrator(memManager,mol,basis,EulerMac(nRad),nAng,nRadPerBatch,
+        NOGRAD,epsilon);
+
+    integrator.integrate<size_t>(sapbuild);
+
+    SetLAThreads(LAThreads);
+
+
+    // Reduce the thread contributions, factor in the 4 pi (Lebedev) and
+    // build the upper triangle
+    for(auto ithread = 1; ithread < nthreads; ithread++)
+      MatAdd('N','N',NB,NB,1.,VSAP,NB,1.,VSAP + ithread*NB*NB,NB,VSAP,NB);
+
+    Scale(NB*NB,4*M_PI,VSAP,1);
+    HerMat('L',NB,VSAP,NB);
+
+    // F = H + V_SAP. The scalar component is ALPHA + BETA (as is 
+    // H(S) = 2(T + V)), such that each spin sees the full V_SAP
+    MatAdd('N','N',NB,NB,T(1.),fock[SCALAR],NB,T(2.),VSAP,NB,
+      fock[SCALAR],NB);
+
+    memManager.free(VSAP,SCR,ZMAT);
+
+  }; // SingleSlater<T>::SAPGuess
+
+
+
   template <typename T>
   void SingleSlater<T>::RandomGuess() {
 
@@ -167,6 +167,10 @@ namespace ChronusQ {
 #include <singleslater/extrap.hpp>  // Extrapolate header
 #include <singleslater/print.hpp>   // Print header
 #include <singleslater/pop.hpp>     // Population analysis
+#include <singleslater/cube.hpp>    // Volumetric output
+#include <singleslater/gradient.hpp> // Nuclear gradients
+#include <singleslater/lockstep.hpp> // Lockstep SCF
+#include <singleslater/response.hpp> // Linear response
 
 #include <singleslater/kohnsham/impl.hpp> // KS headers
 
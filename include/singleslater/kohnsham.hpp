@@ -48,6 +48,10 @@ namespace ChronusQ {
     size_t nAng         = 302;   ///< # Angular points
     size_t nRad         = 100;   ///< # Radial points
     size_t nRadPerBatch = 4;     ///< # Radial points / macro batch
+
+    double incXCTol      = 0.;   ///< Batch |dRho| tolerance for incremental VXC (0 = off)
+    size_t nIncXCRebuild = 20;   ///< Full VXC rebuild every N incremental builds
+    size_t incXCMem      = 32;   ///< Memory budget (MB) of the incremental VXC cache
   };
 
 
@@ -78,6 +82,30 @@ namespace ChronusQ {
 
     oper_t_coll VXC; ///< VXC terms
 
+  protected:
+
+    /**
+     *  \brief Cached contribution of a single grid batch to VXC / EXC
+     *  for incremental VXC builds (see formVXC).
+     */ 
+    struct XCBatchCache {
+      double dRhoAccum = 0.;      ///< Accumulated |dRho| bound since last evaluation
+      double XCEnergy  = 0.;      ///< Batch contribution to EXC
+      double *slot     = nullptr; ///< nComp x NBE x NBE block in the cache arena
+                                  ///< (nullptr = over budget, always evaluated)
+      std::vector<double*> VXC;   ///< Batch blocks within slot (nullptr = 0)
+    };
+
+    std::vector<std::vector<XCBatchCache>> xcBatchCache_; ///< [thread][batch]
+    std::vector<std::vector<double>>       xcPrevDen_;    ///< Density of last build
+    size_t nIncXCBuild_ = 0; ///< # incremental builds since last full build
+
+    double *xcCacheMem_  = nullptr; ///< Batch cache arena (from memManager)
+    size_t  xcCacheSize_ = 0;       ///< Length of xcCacheMem_
+    std::vector<size_t> xcCacheUsed_; ///< Used length of each thread's arena
+
+  public:
+
     // Inherit ctors from SingleSlater<T>
 
     template <typename... Args>
@@ -146,6 +174,8 @@ namespace ChronusQ {
     KohnSham(const KohnSham<T> &other);
     KohnSham(KohnSham<T> &&other);
 
+    ~KohnSham() { resetIncrementalXC(); }
+
 
     /**
      *  \brief Kohn-Sham specialization of formFock
@@ -158,14 +188,6 @@ namespace ChronusQ {
 #if KS_DEBUG_LEVEL > 0
       std::chrono::duration<double> durHF(0.) ;
       std::chrono::duration<double> durXC(0.) ;
-      std::chrono::duration<double> duraddXC(0.) ;
-      auto topHFpart = std::chrono::high_resolution_clock::now();
-#endif
-
-      SingleSlater<T>::formFock(pert,increment,functionals.back()->xHFX);
-
-#if KS_DEBUG_LEVEL > 0
-      auto botHFpart = std::chrono::high_resolution_clock::now();
       auto topXCpart = std::chrono::high_resolution_clock::now();
 #endif
 
@@ -173,27 +195,47 @@ namespace ChronusQ {
 
 #if KS_DEBUG_LEVEL > 0
       auto botXCpart = std::chrono::high_resolution_clock::now();
-      auto topaddXCpart = std::chrono::high_resolution_clock::now();
+      auto topHFpart = std::chrono::high_resolution_clock::now();
 #endif
 
-      // Add VXC in Fock matrix
-      size_t NB = this->aoints.basisSet().nBasis;
-      for(auto i = 0ul; i < this->fock.size(); i++)
-        MatAdd('N','N', NB, NB, T(1.), this->fock[i], NB, T(1.), VXC[i], NB,
-          this->fock[i], NB);
+      // VXC is added to the Fock matrix through addFockTerms
+      SingleSlater<T>::formFock(pert,increment,functionals.back()->xHFX);
 
 #if KS_DEBUG_LEVEL > 0
-      auto botaddXCpart = std::chrono::high_resolution_clock::now();
+      auto botHFpart = std::chrono::high_resolution_clock::now();
       durHF = botHFpart - topHFpart;
       durXC = botXCpart - topXCpart;
-      duraddXC = botaddXCpart - topaddXCpart;
       std::cerr << "HF FormFock " << durHF.count() << std::endl;
       std::cerr << "XC FormFock " << durXC.count() << std::endl;
-      std::cerr << "addXC FormFock " << duraddXC.count() << std::endl;
 #endif
 
     }; // formFock
 
+    /**
+     *  \brief Kohn-Sham specialization of formFockPrep
+     *
+     *  Compute VXC and append the (scaled) G[D] contractions
+     */
+    virtual void formFockPrep(bool increment,
+      std::vector<TwoBodyContraction<T,T>> &contract) {
+
+      formVXC();
+      this->formGDPrep(increment,functionals.back()->xHFX,contract);
+
+    }; // formFockPrep
+
+    /**
+     *  \brief Kohn-Sham specialization of addFockTerms
+     *
+     *  Adds VXC to the Fock matrix
+     */  
+    void addFockTerms(size_t i, std::vector<RealLinCombTerm> &realTerms) {
+
+      realTerms.push_back({1., VXC[i], this->aoints.basisSet().nBasis, 
+        false});
+
+    }; // addFockTerms
+
     /**
      *  \brief Kohn-Sham specialization of computeEnergy
      *
@@ -207,11 +249,63 @@ namespace ChronusQ {
         
     }; // computeEnergy
 
+    /**
+     *  \brief Kohn-Sham specialization of computeGradient
+     *
+     *  Add the XC contribution to the (scaled exchange) HF gradient
+     */  
+    virtual std::vector<double> computeGradient() {
+
+      std::vector<double> grad = 
+        SingleSlater<T>::formGradient(functionals.back()->xHFX);
+      formXCGradient(grad);
+      return grad;
+
+    }; // computeGradient
+
+    /**
+     *  \brief Kohn-Sham specialization of clearGeometry
+     *
+     *  The cached batch contributions to VXC refer to the old grid
+     */  
+    virtual void clearGeometry() { resetIncrementalXC(); }
+
+    /**
+     *  \brief Kohn-Sham specialization of computePolarizability
+     *
+     *  Linear response with the (scaled exchange) HF and XC kernels
+     */  
+    virtual std::vector<double> computePolarizability(ResponseControls &ctl) {
+
+      return SingleSlater<T>::formPolarizability(ctl,functionals.back()->xHFX);
+
+    }; // computePolarizability
+
+    // XC kernel response
+    // See include/singleslater/kohnsham/response.hpp for docs.
+    void formKernelResponse(std::vector<std::vector<double*>>&,
+      std::vector<std::vector<double*>>&);
+
+    // XC nuclear gradient 
+    // See include/singleslater/kohnsham/gradient.hpp for docs.
+    void formXCGradient(std::vector<double>&);
+
     // KS specific functions
     // See include/singleslater/kohnsham/vxc.hpp for docs.
 
     void formVXC(); 
 
+    /**
+     *  \brief Discard the cached batch contributions to VXC, forcing
+     *  the next call to formVXC to perform a full build.
+     */ 
+    void resetIncrementalXC() {
+      xcBatchCache_.clear(); xcPrevDen_.clear(); nIncXCBuild_ = 0;
+      xcCacheUsed_.clear();
+      if( xcCacheMem_ ) this->memManager.free(xcCacheMem_);
+      xcCacheMem_ = nullptr; xcCacheSize_ = 0;
+    }; // resetIncrementalXC
+
     void evalDen(SHELL_EVAL_TYPE typ, size_t NPts,size_t NBE, size_t NB, 
       std::vector<std::pair<size_t,size_t>> &subMatCut, double *SCR1,
       double *SCR2, double *DENMAT, double *Den, double *GDenX, double *GDenY, double *GDenZ,
@@ -0,0 +1,278 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_SINGLESLATER_KOHNSHAM_GRADIENT_HPP__
+#define __INCLUDED_SINGLESLATER_KOHNSHAM_GRADIENT_HPP__
+
+#include <singleslater/kohnsham.hpp>
+
+#include <grid/integrator.hpp>
+#include <basisset/basisset_util.hpp>
+#include <cqlinalg/blasutil.hpp>
+#include <cqlinalg/blasext.hpp>
+
+#include <util/threads.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Increment a nuclear gradient by the XC contribution of a 
+   *  (real, 1C) Kohn--Sham determinant.
+   *
+   *  \f[
+   *    \frac{\partial E_{XC}}{\partial R_{A\xi}} = -2 \sum_s \int 
+   *      \sum_{\mu \in A} \left[ \left( v^s_\rho \partial_\xi\phi_\mu +
+   *        \mathbf{V}^s \cdot \nabla \partial_\xi \phi_\mu \right) 
+   *        (P^s \phi)_\mu + 
+   *        \partial_\xi\phi_\mu (P^s \mathbf{V}^s \cdot \nabla \phi)_\mu 
+   *      \right]
+   *  \f]
+   *
+   *  with \f$ \mathbf{V}^s = 2 v_{\gamma^{ss}} \nabla\rho_s + 
+   *  v_{\gamma^{ss'}} \nabla\rho_{s'} \f$ (GGA only). The basis Hessian
+   *  is only needed along \f$ \mathbf{V}^s \f$ and is evaluated by central
+   *  differences of the basis gradients. The derivatives of the Becke
+   *  partition weights are neglected.
+   *
+   *  \param [in/out] grad  Gradient, stored (x,y,z) for each atom
+   */ 
+  template <typename T>
+  void KohnSham<T>::formXCGradient(std::vector<double> &grad) {
+
+    if( not std::is_same<T,double>::value or this->nC != 1 )
+      CErr("Analytic gradients are only implemented for real 1C references",
+        std::cout);
+
+    BasisSet &basis = this->aoints.basisSet();
+    Molecule &mol   = this->aoints.molecule();
+
+    const size_t NB   = basis.nBasis;
+    const size_t NB2  = NB*NB;
+    const size_t nCen = basis.centers.size();
+
+    // Cartesian shell size for the basis evaluation scratch
+    const size_t shSizeCar = ((basis.maxL+1)*(basis.maxL+2))/2;
+
+    // Central difference step (Bohr) for the basis Hessian
+    const double hFD = 1e-4;
+
+    bool isGGA = std::any_of(functionals.begin(),functionals.end(),
+                   [](std::shared_ptr<DFTFunctional> &x) {return x->isGGA(); }); 
+
+    size_t nthreads  = GetNumThreads();
+    size_t LAThreads = GetLAThreads();
+
+    // Turn off LA threads
+    SetLAThreads(1);
+
+    // Spin densities DA = 0.5 * (DS + DZ), DB = 0.5 * (DS - DZ) 
+    // (real storage is assured by formGradient)
+    double *DS = reinterpret_cast<double*>(this->onePDM[SCALAR]);
+    std::vector<double*> DSpin;
+    for(auto iS = 0; iS < 2; iS++) {
+      DSpin.emplace_back(this->memManager.template malloc<double>(NB2));
+
+      if( this->iCS ) 
+        for(auto j = 0ul; j < NB2; j++) DSpin.back()[j] = 0.5 * DS[j];
+      else {
+        double *DZ = reinterpret_cast<double*>(this->onePDM[MZ]);
+        double fZ  = iS ? -0.5 : 0.5;
+        for(auto j = 0ul; j < NB2; j++) 
+          DSpin.back()[j] = 0.5 * DS[j] + fZ * DZ[j];
+      }
+    }
+
+    std::vector<std::vector<double>> gradThread(nthreads,
+      std::vector<double>(3*mol.nAtoms,0.));
+
+    auto xcgrad = [&](size_t &res, std::vector<cart_t> &batch, 
+      std::vector<double> &weights, size_t NBE, double *BasisEval, 
+      std::vector<size_t> &batchEvalShells, 
+      std::vector<std::pair<size_t,size_t>> &subMatCut) {
+
+      const size_t thread_id = GetThreadID();
+      const size_t NPts = batch.size();
+      const size_t IOff = NBE*NPts;
+
+      std::vector<double> &G = gradThread[thread_id];
+
+      // Atom of each evaluated basis function
+      std::vector<size_t> bfAtom;
+      for(auto iSh : batchEvalShells)
+        bfAtom.insert(bfAtom.end(),basis.shells[iSh].size(),
+          basis.mapSh2Cen[iSh]);
+
+      std::vector<double> DSub(NBE*NBE), X(2*IOff), Y, Psi;
+      std::vector<double> rho(2*NPts), gRho(6*NPts);
+      std::vector<double> U_n(2*NPts), U_gamma(3*NPts,0.), eps(NPts), 
+        vRho(2*NPts), vGamma(3*NPts,0.), epsSCR(NPts), vRhoSCR(2*NPts), 
+        vGammaSCR(3*NPts);
+
+      // rho_s, grad rho_s and (P^s phi)
+      for(auto iS = 0; iS < 2; iS++)
+        evalDen(GRADIENT,NPts,NBE,NB,subMatCut,&DSub[0],&X[iS*IOff],
+          DSpin[iS],&rho[iS*NPts],&gRho[3*iS*NPts],&gRho[(3*iS+1)*NPts],
+          &gRho[(3*iS+2)*NPts],BasisEval);
+
+      for(auto iPt = 0; iPt < NPts; iPt++) {
+        U_n[2*iPt]   = rho[iPt];
+        U_n[2*iPt+1] = rho[NPts + iPt];
+
+        if( isGGA )
+        for(auto iXYZ = 0; iXYZ < 3; iXYZ++) {
+          double gA = gRho[iXYZ*NPts + iPt];
+          double gB = gRho[(3 + iXYZ)*NPts + iPt];
+          U_gamma[3*iPt]   += gA * gA;
+          U_gamma[3*iPt+1] += gA * gB;
+          U_gamma[3*iPt+2] += gB * gB;
+        }
+      }
+
+      loadVXCder(NPts,&U_n[0],&U_gamma[0],&eps[0],&vRho[0],&vGamma[0],
+        &epsSCR[0],&vRhoSCR[0],&vGammaSCR[0]);
+
+      // Basis gradients at the batch points displaced along a direction
+      std::vector<bool>   evalShell;
+      std::vector<double> r, rSq, BPlus, BMinus, SCRCar;
+      if( isGGA ) {
+        evalShell.assign(basis.nShell,false);
+        for(auto iSh : batchEvalShells) evalShell[iSh] = true;
+
+        Y.resize(IOff); Psi.resize(IOff);
+        r.resize(3*nCen*NPts); rSq.resize(nCen*NPts);
+        BPlus.resize(4*IOff); BMinus.resize(4*IOff); 
+        SCRCar.resize(4*shSizeCar);
+      }
+
+      auto evalDisplaced = [&](std::vector<double> &dir, double h, 
+        double *B) {
+
+        for(auto iPt = 0; iPt < NPts; iPt++)
+        for(auto iCen = 0; iCen < nCen; iCen++) {
+          double *rCur = &r[3*iCen + 3*nCen*iPt];
+          for(auto k = 0; k < 3; k++)
+            rCur[k] = batch[iPt][k] + h * dir[3*iPt + k] - 
+              basis.centers[iCen][k];
+          rSq[iCen + nCen*iPt] = 
+            rCur[0]*rCur[0] + rCur[1]*rCur[1] + rCur[2]*rCur[2];
+        }
+
+        evalShellSet(GRADIENT,basis.shells,evalShell,&rSq[0],&r[0],NPts,
+          nCen,basis.mapSh2Cen,basis.mapSh2Fam,NBE,B,&SCRCar[0],shSizeCar,
+          basis.forceCart);
+
+      };
+
+      for(auto iS = 0; iS < 2; iS++) {
+
+        const double *XS = &X[iS*IOff];
+        std::vector<double> VHat, VNorm;
+
+        if( isGGA ) {
+
+          VHat.assign(3*NPts,0.); VNorm.assign(NPts,0.);
+
+          // V^s and Psi = V^s . grad phi
+          for(auto iPt = 0; iPt < NPts; iPt++) {
+            double V[3];
+            for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+              V[iXYZ] = 
+                2. * vGamma[3*iPt + 2*iS] * gRho[(3*iS+iXYZ)*NPts + iPt] +
+                vGamma[3*iPt+1] * gRho[(3*(1-iS)+iXYZ)*NPts + iPt];
+
+            VNorm[iPt] = std::sqrt(V[0]*V[0] + V[1]*V[1] + V[2]*V[2]);
+            if( VNorm[iPt] > 0. )
+              for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+                VHat[3*iPt + iXYZ] = V[iXYZ] / VNorm[iPt];
+
+            for(auto mu = 0; mu < NBE; mu++) {
+              const size_t idx = mu + iPt*NBE;
+              Psi[idx] = V[0] * BasisEval[IOff + idx] + 
+                         V[1] * BasisEval[2*IOff + idx] + 
+                         V[2] * BasisEval[3*IOff + idx];
+            }
+          }
+
+          // Y = P^s Psi
+          SubMatSet(NB,NB,NBE,NBE,DSpin[iS],NB,&DSub[0],NBE,subMatCut);
+          Gemm('N','N',NBE,NPts,NBE,1.,&DSub[0],NBE,&Psi[0],NBE,0.,
+            &Y[0],NBE);
+
+          evalDisplaced(VHat, hFD,&BPlus[0]);
+          evalDisplaced(VHat,-hFD,&BMinus[0]);
+
+        }
+
+        for(auto iPt = 0; iPt < NPts; iPt++) {
+
+          // Factor of 4 pi for the Lebedev weights
+          const double wGrad = 8. * M_PI * weights[iPt];
+          const double vR    = vRho[2*iPt + iS];
+          const double hFac  = isGGA ? VNorm[iPt] / (2. * hFD) : 0.;
+
+          for(auto mu = 0; mu < NBE; mu++) {
+            const size_t idx = mu + iPt*NBE;
+            const size_t A   = bfAtom[mu];
+
+            for(auto iXYZ = 0; iXYZ < 3; iXYZ++) {
+              const size_t dIdx = (iXYZ + 1)*IOff + idx;
+              const double dPhi = BasisEval[dIdx];
+
+              double val = vR * dPhi * XS[idx];
+              if( isGGA )
+                val += hFac * (BPlus[dIdx] - BMinus[dIdx]) * XS[idx] +
+                  dPhi * Y[idx];
+
+              G[3*A + iXYZ] -= wGrad * val;
+            }
+          }
+
+        }
+
+      } // loop over spin
+
+    }; // XC gradient integrate
+
+
+    // Create the BeckeIntegrator object
+    BeckeIntegrator<EulerMac> 
+      integrator(this->memManager,mol,basis,
+      EulerMac(intParam.nRad), intParam.nAng, intParam.nRadPerBatch,
+        GRADIENT, intParam.epsilon);
+
+    // Integrate the XC gradient
+    integrator.integrate<size_t>(xcgrad);
+
+    for(auto &Gt : gradThread)
+    for(auto i = 0ul; i < grad.size(); i++) grad[i] += Gt[i];
+
+    this->memManager.free(DSpin[0],DSpin[1]);
+
+    // Turn back on LA threads
+    SetLAThreads(LAThreads);
+
+  }; // KohnSham<T>::formXCGradient
+
+}; // namespace ChronusQ
+
+#endif
@@ -70,5 +70,7 @@ namespace ChronusQ {
 }; // namespace ChronusQ
 
 #include <singleslater/kohnsham/vxc.hpp> // VXC build
+#include <singleslater/kohnsham/gradient.hpp> // XC gradient
+#include <singleslater/kohnsham/response.hpp> // XC kernel response
 
 #endif
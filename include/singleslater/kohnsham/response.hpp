@@ -0,0 +1,119 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_SINGLESLATER_KOHNSHAM_RESPONSE_HPP__
+#define __INCLUDED_SINGLESLATER_KOHNSHAM_RESPONSE_HPP__
+
+#include <singleslater/kohnsham.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Increment the (S,Z) Fock response of a set of trial 
+   *  densities by the XC kernel contribution, 
+   *  \f$ \delta V_{XC} = f_{XC} \star \delta D \f$.
+   *
+   *  The kernel is applied by central differences of VXC along each 
+   *  trial density, 
+   *  \f$ \delta V_{XC} \approx [V_{XC}(D + h\delta D) - 
+   *      V_{XC}(D - h\delta D)] / 2h \f$, 
+   *  which requires only formVXC (and is exact through second order in
+   *  h for any LDA / GGA functional). The 1PDM, VXC and EXC are restored 
+   *  on exit.
+   *
+   *  \param [in]     dD  AO trial densities (S,Z) for each vector
+   *  \param [in/out] dV  AO Fock response (S,Z) for each vector
+   */ 
+  template <typename T>
+  void KohnSham<T>::formKernelResponse(
+    std::vector<std::vector<double*>> &dD, 
+    std::vector<std::vector<double*>> &dV) {
+
+    if( not std::is_same<T,double>::value or this->nC != 1 )
+      CErr("XC kernel response is only implemented for real 1C references",
+        std::cout);
+
+    const size_t NB2   = this->aoints.basisSet().nBasis *
+                         this->aoints.basisSet().nBasis;
+    const size_t nComp = this->onePDM.size();
+
+    // Save the reference state
+    std::vector<double*> D0, V0;
+    for(auto i = 0ul; i < nComp; i++) {
+      D0.emplace_back(this->memManager.template malloc<double>(NB2));
+      V0.emplace_back(this->memManager.template malloc<double>(NB2));
+      std::copy_n(reinterpret_cast<double*>(this->onePDM[i]),NB2,D0[i]);
+      std::copy_n(VXC[i],NB2,V0[i]);
+    }
+    double EXC0 = XCEnergy;
+
+    // Incremental builds would reuse the reference contributions
+    double incXCTol = intParam.incXCTol;
+    intParam.incXCTol = 0.;
+    resetIncrementalXC();
+
+    for(auto k = 0ul; k < dD.size(); k++) {
+
+      double maxD = 0.;
+      for(auto i = 0ul; i < dD[k].size(); i++)
+      for(auto j = 0ul; j < NB2; j++)
+        maxD = std::max(maxD,std::abs(dD[k][i][j]));
+
+      if( maxD < 1e-14 ) continue;
+
+      const double h = 1e-4 / maxD;
+
+      for(double sgn : {1., -1.}) {
+
+        for(auto i = 0ul; i < dD[k].size(); i++) {
+          double *D = reinterpret_cast<double*>(this->onePDM[i]);
+          for(auto j = 0ul; j < NB2; j++) D[j] = D0[i][j] + sgn*h*dD[k][i][j];
+        }
+
+        formVXC();
+
+        for(auto i = 0ul; i < dV[k].size(); i++)
+        for(auto j = 0ul; j < NB2; j++)
+          dV[k][i][j] += sgn * VXC[i][j] / (2.*h);
+
+      }
+
+    }
+
+    // Restore the reference state
+    for(auto i = 0ul; i < nComp; i++) {
+      std::copy_n(D0[i],NB2,reinterpret_cast<double*>(this->onePDM[i]));
+      std::copy_n(V0[i],NB2,VXC[i]);
+      this->memManager.free(D0[i],V0[i]);
+    }
+    XCEnergy = EXC0;
+
+    intParam.incXCTol = incXCTol;
+    resetIncrementalXC();
+
+  }; // KohnSham<T>::formKernelResponse
+
+}; // namespace ChronusQ
+
+#endif
@@ -848,16 +848,16 @@ namespace ChronusQ {
     // Clean up all VXC components for a the evaluation for a new batch of points
 
     std::vector<std::vector<double*>> integrateVXC;
-    double* intVXC_RAW = nullptr;
 
-    if( nthreads != 1 )
-      intVXC_RAW = this->memManager.template malloc<double>(VXC.size() * nthreads * NB*NB);
+    // NUMA-local per-thread VXC accumulators
+    ThreadScratch<double> intVXC_RAW( (nthreads != 1) ? VXC.size()*NB*NB : 0, 
+      nthreads );
 
     for(auto k = 0; k < VXC.size(); k++) {
       if( nthreads != 1 ) {
         integrateVXC.emplace_back();
         for(auto ith = 0; ith < nthreads; ith++)
-          integrateVXC.back().emplace_back(intVXC_RAW + (ith + k*nthreads) * NB*NB);
+          integrateVXC.back().emplace_back(intVXC_RAW[ith] + k*NB*NB);
       } else {
         integrateVXC.emplace_back();
         integrateVXC.back().emplace_back(VXC[k]);
@@ -967,6 +967,79 @@ namespace ChronusQ {
     // ---------------------------------------------------------------------//
     // End allocating Memory
 
+
+    // Incremental VXC: batches whose (accumulated) density change since
+    // their last evaluation is below intParam.incXCTol reuse their cached
+    // contribution. Batches are identified by their order of evaluation
+    // on each thread, which is fixed for a fixed grid / thread count.
+    //
+    // The cached blocks live in a single arena from the memory manager of
+    // at most intParam.incXCMem MB (less if the manager cannot provide it),
+    // split evenly among the threads. Batches which do not fit are simply
+    // evaluated on every build.
+    bool incXC = intParam.incXCTol > 0.;
+    bool fullXCBuild = not incXC or xcBatchCache_.size() != nthreads or
+      xcPrevDen_.size() != Re1PDM.size() or 
+      nIncXCBuild_ >= intParam.nIncXCRebuild;
+
+    size_t nShell = basis.nShell;
+    std::vector<double> shBlkDelta;
+    std::vector<size_t> nBatchEval(nthreads,0), nBatchSkip(nthreads,0);
+
+    if( incXC ) {
+
+      if( fullXCBuild ) {
+
+        xcBatchCache_.clear(); xcBatchCache_.resize(nthreads);
+        nIncXCBuild_ = 0;
+
+        if( not xcCacheMem_ ) {
+
+          xcCacheSize_ = intParam.incXCMem * 1024 * 1024 / sizeof(double);
+          while( xcCacheSize_ >= NB*NB ) {
+            try {
+              xcCacheMem_ = this->memManager.template malloc<double>(
+                xcCacheSize_);
+              break;
+            } catch(std::bad_alloc &) { xcCacheSize_ /= 2; }
+          }
+
+          if( not xcCacheMem_ ) xcCacheSize_ = 0;
+
+        }
+
+        xcCacheUsed_.assign(nthreads,0);
+
+      } else {
+
+        // Shell-block max norms of dD (summed over components)
+        shBlkDelta.resize(nShell*nShell,0.);
+        for(auto k = 0; k < Re1PDM.size(); k++)
+        for(size_t s2 = 0; s2 < nShell; s2++)
+        for(size_t s1 = 0; s1 < nShell; s1++) {
+
+          double blkMax = 0.;
+          for(size_t nu = basis.mapSh2Bf[s2];
+              nu < basis.mapSh2Bf[s2] + basis.shells[s2].size(); nu++)
+          for(size_t mu = basis.mapSh2Bf[s1];
+              mu < basis.mapSh2Bf[s1] + basis.shells[s1].size(); mu++)
+            blkMax = std::max(blkMax,
+              std::abs(Re1PDM[k][mu + nu*NB] - xcPrevDen_[k][mu + nu*NB]));
+
+          shBlkDelta[s1 + s2*nShell] += blkMax;
+
+        }
+
+        nIncXCBuild_++;
+
+      }
+
+      xcPrevDen_.resize(Re1PDM.size());
+      for(auto k = 0; k < Re1PDM.size(); k++)
+        xcPrevDen_[k].assign(Re1PDM[k],Re1PDM[k] + NB*NB);
+
+    }
+
 #if VXC_DEBUG_LEVEL >= 1
     // TIMING
     auto botMem = std::chrono::high_resolution_clock::now();
@@ -1001,6 +1074,80 @@ namespace ChronusQ {
 
       size_t thread_id = GetThreadID();
 
+      XCBatchCache *cache = nullptr;
+      if( incXC ) {
+
+        auto &thrCache = xcBatchCache_[thread_id];
+        size_t iBatch  = nBatchEval[thread_id]++;
+
+        if( iBatch == thrCache.size() ) {
+
+          thrCache.emplace_back();
+
+          // Reserve the batch blocks in this thread's arena
+          size_t slotLen = VXC.size() * NBE * NBE;
+          size_t thrLen  = xcCacheSize_ / nthreads;
+          if( xcCacheUsed_[thread_id] + slotLen <= thrLen ) {
+            thrCache.back().slot = xcCacheMem_ + thread_id * thrLen + 
+              xcCacheUsed_[thread_id];
+            xcCacheUsed_[thread_id] += slotLen;
+          }
+
+        }
+
+        cache = &thrCache[iBatch];
+
+        if( not cache->slot ) cache = nullptr;
+        else if( not fullXCBuild ) {
+
+          // Bound |dRho| over the batch by
+          //   sum_{st} |dD_st|_max * (n_s max|phi_s|) * (n_t max|phi_t|)
+          std::vector<double> shPhiMax(batchEvalShells.size(),0.);
+          for(size_t iPt = 0; iPt < NPts; iPt++) {
+            size_t mu = 0;
+            for(auto iSh = 0; iSh < batchEvalShells.size(); iSh++) {
+              size_t shSize = basis.shells[batchEvalShells[iSh]].size();
+              for(size_t i = 0; i < shSize; i++, mu++)
+                shPhiMax[iSh] = std::max(shPhiMax[iSh],
+                  std::abs(BasisEval[mu + iPt*NBE]));
+            }
+          }
+
+          for(auto iSh = 0; iSh < batchEvalShells.size(); iSh++)
+            shPhiMax[iSh] *= basis.shells[batchEvalShells[iSh]].size();
+
+          double dRho = 0.;
+          for(auto jSh = 0; jSh < batchEvalShells.size(); jSh++)
+          for(auto iSh = 0; iSh < batchEvalShells.size(); iSh++)
+            dRho += shPhiMax[iSh] * shPhiMax[jSh] * 
+              shBlkDelta[batchEvalShells[iSh] + batchEvalShells[jSh]*nShell];
+
+          cache->dRhoAccum += dRho;
+
+          // Reuse the cached contribution
+          if( cache->dRhoAccum < intParam.incXCTol ) {
+
+            integrateXCEnergy[thread_id] += cache->XCEnergy;
+            for(auto k = 0; k < cache->VXC.size(); k++)
+              if( cache->VXC[k] )
+                IncBySubMat(NB,NB,NBE,NBE,integrateVXC[k][thread_id],NB,
+                  cache->VXC[k],NBE,subMatCut);
+
+            nBatchSkip[thread_id]++;
+            return;
+
+          }
+
+        }
+
+      }
+
+      if( cache ) {
+        cache->dRhoAccum = 0.;
+        cache->XCEnergy  = 0.;
+        cache->VXC.assign(VXC.size(),nullptr);
+      }
+
 #if VXC_DEBUG_LEVEL >= 1
       // TIMING
       auto topevalDen = std::chrono::high_resolution_clock::now();
@@ -1124,7 +1271,9 @@ namespace ChronusQ {
 #endif
 
       // Compute for the current batch the XC energy and increment the total XC energy.
-      integrateXCEnergy[thread_id] += energy_vxc(NPts, weights, epsEval_loc, DenS_loc);
+      double batchXCEnergy = energy_vxc(NPts, weights, epsEval_loc, DenS_loc);
+      integrateXCEnergy[thread_id] += batchXCEnergy;
+      if( cache ) cache->XCEnergy = batchXCEnergy;
 
 #if VXC_DEBUG_LEVEL >= 1
       // TIMING
@@ -1184,6 +1333,10 @@ namespace ChronusQ {
        // Locating the submatrix in the right position given the subset of 
        // shells for the given batch.
        IncBySubMat(NB,NB,NBE,NBE,integrateVXC[SCALAR][thread_id],NB,SCRATCHNBNB_loc,NBE,subMatCut);
+       if( cache ) {
+         cache->VXC[SCALAR] = cache->slot + SCALAR*NBE*NBE;
+         std::copy_n(SCRATCHNBNB_loc,NBE*NBE,cache->VXC[SCALAR]);
+       }
  #if VXC_DEBUG_LEVEL >= 1
        // TIMING
        auto botIncBySubMat    = std::chrono::high_resolution_clock::now();
@@ -1253,6 +1406,10 @@ namespace ChronusQ {
         // Locating the submatrix in the right position given the subset of 
         // shells for the given batch.
         IncBySubMat(NB,NB,NBE,NBE,integrateVXC[MZ][thread_id],NB,SCRATCHNBNB_loc,NBE,subMatCut);           
+        if( cache ) {
+          cache->VXC[MZ] = cache->slot + MZ*NBE*NBE;
+          std::copy_n(SCRATCHNBNB_loc,NBE*NBE,cache->VXC[MZ]);
+        }
       }
  
 
@@ -1291,6 +1448,10 @@ namespace ChronusQ {
           // Locating the submatrix in the right position given the subset of 
           // shells for the given batch.
           IncBySubMat(NB,NB,NBE,NBE,integrateVXC[MY][thread_id],NB,SCRATCHNBNB_loc,NBE,subMatCut);           
+          if( cache ) {
+            cache->VXC[MY] = cache->slot + MY*NBE*NBE;
+            std::copy_n(SCRATCHNBNB_loc,NBE*NBE,cache->VXC[MY]);
+          }
         }
 
 //
@@ -1325,6 +1486,10 @@ namespace ChronusQ {
           // Locating the submatrix in the right position given the subset of 
           // shells for the given batch.
           IncBySubMat(NB,NB,NBE,NBE,integrateVXC[MX][thread_id],NB,SCRATCHNBNB_loc,NBE,subMatCut);           
+          if( cache ) {
+            cache->VXC[MX] = cache->slot + MX*NBE*NBE;
+            std::copy_n(SCRATCHNBNB_loc,NBE*NBE,cache->VXC[MX]);
+          }
         }
       } // 2C My and Mz
 
@@ -1427,8 +1592,6 @@ namespace ChronusQ {
     }
 
 
-    if( nthreads != 1 ) this->memManager.free(intVXC_RAW);
-
     if( not std::is_same<T,double>::value )
       for(auto &X : Re1PDM) this->memManager.free(X);
 
@@ -1455,6 +1618,12 @@ namespace ChronusQ {
    std::cerr << "formZ_vxc " << durformZ_vxc.count()/d_batch << std::endl;
    std::cerr << "DSYR2K " << durDSYR2K.count()/d_batch << std::endl;
    std::cerr << "IncBySubMat " << durIncBySubMat.count()/d_batch << std::endl;
+   if( incXC )
+     std::cerr << "Incremental VXC: reused " 
+               << std::accumulate(nBatchSkip.begin(),nBatchSkip.end(),0ul)
+               << " of " 
+               << std::accumulate(nBatchEval.begin(),nBatchEval.end(),0ul)
+               << " batches" << std::endl;
    std::cerr <<  std::endl << std::endl;
 #endif
 
@@ -0,0 +1,177 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_SINGLESLATER_LOCKSTEP_HPP__
+#define __INCLUDED_SINGLESLATER_LOCKSTEP_HPP__
+
+#include <singleslater.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Converges a set of SingleSlater objects which differ only in
+   *  their (static) EMPerturbation in lockstep.
+   *
+   *  Each SCF iteration gathers the G[D] contractions of every 
+   *  unconverged determinant into a single twoBodyContract call, such
+   *  that (for DIRECT) each ERI shell quartet is evaluated once for all
+   *  perturbations. The remainder of the iteration (extrapolation, 
+   *  diagonalization, convergence) is carried out independently for
+   *  each determinant with its own scfControls.
+   *
+   *  \warning All SingleSlater objects must share the same AOIntegrals
+   *  and have their 1PDM / orbital storage populated (see 
+   *  SingleSlaterBase::SCF).
+   *
+   *  \param [in/out] ss    SingleSlater objects to converge
+   *  \param [in]     perts Static perturbation of each SingleSlater object
+   */ 
+  template <typename T>
+  void LockstepSCF(std::vector<SingleSlater<T>*> &ss, 
+    std::vector<EMPerturbation> &perts) {
+
+    const size_t nSS = ss.size();
+
+    if( perts.size() != nSS )
+      CErr("LockstepSCF requires one EMPerturbation per SingleSlater object",
+        std::cout);
+
+    if( nSS == 0 ) return;
+
+    AOIntegrals &aoints = ss[0]->aoints;
+    for(auto &s : ss)
+      if( &s->aoints != &aoints )
+        CErr("LockstepSCF requires a common AOIntegrals object",std::cout);
+
+    // Initialize the SCF procedures (as in SingleSlaterBase::SCF)
+    for(auto &s : ss) {
+
+      s->SCFInit();
+
+      SCFControls &ctl = s->scfControls;
+
+      ctl.dampParam     = ctl.dampStartParam;
+      ctl.doIncFock     = ctl.doIncFock and (aoints.cAlg == DIRECT);
+      ctl.curLevelShift = ctl.levelShift;
+      ctl.curSmearTemp  = (ctl.smearType == NO_SMEARING) ? 0. : ctl.smearTemp;
+
+    }
+
+    const size_t maxSCFIter = ss[0]->scfControls.maxSCFIter;
+
+    std::vector<bool> isConverged(nSS,false), isActive(nSS,true);
+
+    std::cout << "  Lockstep SCF over " << nSS << " perturbations:" 
+              << std::endl << std::endl;
+    std::cout << std::setw(16) << std::left << "  Iteration";
+    std::cout << std::setw(12) << std::right << "Active";
+    std::cout << std::setw(18) << "Max |ΔE| (Eh)";
+    std::cout << std::setw(18) << "Max |ΔP(S)|" << std::endl;
+
+    for( size_t iter = 0; iter < maxSCFIter; iter++ ) {
+
+      // Save current state and retire the converged determinants
+      size_t nActive = 0;
+      for(auto i = 0ul; i < nSS; i++) {
+
+        if( not isActive[i] ) continue;
+
+        ss[i]->scfConv.nSCFIter = iter;
+        ss[i]->saveCurrentState();
+
+        if( isConverged[i] ) isActive[i] = false;
+        else                 nActive++;
+
+      }
+
+      if( nActive == 0 ) break;
+
+      // Form the G[D] contractions of all active determinants and
+      // evaluate them in a single pass over the ERIs
+      std::vector<bool> increment(nSS,false);
+      std::vector<TwoBodyContraction<T,T>> contract;
+
+      for(auto i = 0ul; i < nSS; i++) {
+
+        if( not isActive[i] ) continue;
+
+        SCFControls &ctl = ss[i]->scfControls;
+        increment[i] = ctl.doIncFock and iter % ctl.nIncFock != 0 and
+                       ctl.guess != RANDOM;
+
+        ss[i]->formFockPrep(increment[i],contract);
+
+      }
+
+      aoints.twoBodyContract(contract);
+
+      // Complete the SCF iteration for each determinant
+      double maxDE(0.), maxDP(0.);
+      for(auto i = 0ul; i < nSS; i++) {
+
+        if( not isActive[i] ) continue;
+
+        ss[i]->formFockFin(perts[i],increment[i]);
+        ss[i]->getNewOrbitalsFromFock();
+
+        isConverged[i] = ss[i]->evalConver(perts[i]);
+
+        maxDE = std::max(maxDE,std::abs(ss[i]->scfConv.deltaEnergy));
+        maxDP = std::max(maxDP,ss[i]->scfConv.RMSDenScalar);
+
+      }
+
+      std::cout << "  LockIt: " << std::setw(6) << std::left << iter + 1;
+      std::cout << std::setw(12) << std::right << nActive;
+      std::cout << std::scientific << std::setprecision(7);
+      std::cout << std::setw(18) << maxDE << std::setw(18) << maxDP;
+      std::cout << std::endl;
+
+    }; // Iteration loop
+
+    // Finalize the SCF procedures
+    for(auto i = 0ul; i < nSS; i++) {
+
+      ss[i]->scfControls.curLevelShift = 0.;
+      ss[i]->scfControls.curSmearTemp  = 0.;
+
+      ss[i]->saveCurrentState();
+      ss[i]->SCFFin();
+      ss[i]->computeProperties(perts[i]);
+
+    }
+
+    for(auto i = 0ul; i < nSS; i++)
+      if( not isConverged[i] )
+        CErr(std::string("Lockstep SCF ") + std::to_string(i) + 
+          std::string(" Failed to converged within ") + 
+          std::to_string(maxSCFIter) + std::string(" iterations"));
+
+    std::cout << std::endl;
+
+  }; // LockstepSCF
+
+}; // namespace ChronusQ
+
+#endif
@@ -43,13 +43,8 @@ namespace ChronusQ {
 
     for(auto iAtm = 0; iAtm < aoints.molecule().nAtoms; iAtm++) {
 
-      size_t iEnd;
-      if( iAtm == aoints.molecule().nAtoms-1 )
-        iEnd = NB;
-      else
-        iEnd = aoints.basisSet().mapCen2BfSt[iAtm+1];
-
-      size_t iSt = aoints.basisSet().mapCen2BfSt[iAtm];
+      size_t iSt  = aoints.basisSet().mapCen2BfSt[iAtm];
+      size_t iEnd = aoints.basisSet().mapCen2BfEnd[iAtm];
 
       mullikenCharges.emplace_back(aoints.molecule().atoms[iAtm].atomicNumber);
       for(auto i = iSt; i < iEnd; i++)
@@ -68,13 +63,8 @@ namespace ChronusQ {
 
     for(auto iAtm = 0; iAtm < aoints.molecule().nAtoms; iAtm++) {
 
-      size_t iEnd;
-      if( iAtm == aoints.molecule().nAtoms-1 )
-        iEnd = NB;
-      else
-        iEnd = aoints.basisSet().mapCen2BfSt[iAtm+1];
-
-      size_t iSt = aoints.basisSet().mapCen2BfSt[iAtm];
+      size_t iSt  = aoints.basisSet().mapCen2BfSt[iAtm];
+      size_t iEnd = aoints.basisSet().mapCen2BfEnd[iAtm];
 
       lowdinCharges.emplace_back(aoints.molecule().atoms[iAtm].atomicNumber);
       for(auto i = iSt; i < iEnd; i++)
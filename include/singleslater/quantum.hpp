@@ -32,11 +32,61 @@
 
 namespace ChronusQ {
 
+  /**
+   *  \brief Evaluate smeared (fractional) orbital occupations.
+   *
+   *  The Fermi level mu is determined by bisection such that the
+   *  occupations sum to nElec, with
+   *
+   *    Fermi-Dirac: f = 1 / (1 + exp((e - mu) / kT))
+   *    Gaussian:    f = erfc((e - mu) / kT) / 2
+   *
+   *  \param [in]  type  Smearing type
+   *  \param [in]  kT    Smearing width (Eh)
+   *  \param [in]  nElec Number of electrons to distribute
+   *  \param [in]  nOrb  Number of orbitals
+   *  \param [in]  eps   Orbital energies (ascending)
+   *  \param [out] occ   Occupations (0 <= f <= 1)
+   */ 
+  inline void smearedOccupations(SMEARING_TYPE type, double kT, size_t nElec,
+    size_t nOrb, const double *eps, std::vector<double> &occ) {
+
+    occ.assign(nOrb,0.);
+
+    auto fillOcc = [&](double mu) -> double {
+      double nTot = 0.;
+      for(auto i = 0; i < nOrb; i++) {
+        double x = (eps[i] - mu) / kT;
+        if( type == FERMI_SMEARING )
+          occ[i] = (x > 0.) ? std::exp(-x) / (1. + std::exp(-x)) :
+                              1. / (1. + std::exp(x));
+        else
+          occ[i] = 0.5 * std::erfc(x);
+        nTot += occ[i];
+      }
+      return nTot;
+    };
+
+    double muLow  = eps[0]      - 50. * kT;
+    double muHigh = eps[nOrb-1] + 50. * kT;
+
+    for(auto iter = 0; iter < 200; iter++) {
+      double mu = 0.5 * (muLow + muHigh);
+      double nTot = fillOcc(mu);
+      if( std::abs(nTot - nElec) < 1e-12 ) break;
+      if( nTot > nElec ) muHigh = mu;
+      else               muLow  = mu;
+    }
+
+  }; // smearedOccupations
+
   /**
    *  \brief Forms the 1PDM using a set of orbitals 
    *
    *  specialization of Quantum::formDensity. Populates / overwrites
-   *  onePDM storage
+   *  onePDM storage. If smearing is active (SCFControls::curSmearTemp),
+   *  the orbitals enter with fractional occupations about the Fermi
+   *  level.
    */ 
   template <typename T>
   void SingleSlater<T>::formDensity() {
@@ -44,17 +94,42 @@ namespace ChronusQ {
     size_t NB  = aoints.basisSet().nBasis * nC;
     size_t NB2 = NB*NB;
 
+    // D = C * f * C**H
+    auto occDensity = [&](size_t nOcc, T *C, double *eps, T *D) {
+
+      if( scfControls.curSmearTemp <= 0. ) {
+        Gemm('N', 'C', NB, NB, nOcc, T(1.), C, NB, C, NB, T(0.), D, NB);
+        return;
+      }
+
+      std::vector<double> occ;
+      smearedOccupations(scfControls.smearType,scfControls.curSmearTemp,
+        nOcc,NB,eps,occ);
+
+      // Only orbitals with non-negligible occupations contribute
+      size_t nAct = NB;
+      while( nAct > nOcc and occ[nAct-1] < 1e-14 ) nAct--;
+
+      T* SCR = this->memManager.template malloc<T>(NB*nAct);
+      for(auto j = 0; j < nAct; j++)
+      for(auto i = 0; i < NB; i++)
+        SCR[i + j*NB] = occ[j] * C[i + j*NB];
+
+      Gemm('N', 'C', NB, NB, nAct, T(1.), SCR, NB, C, NB, T(0.), D, NB);
+
+      this->memManager.free(SCR);
+
+    };
+
     if(nC == 1) { 
 
       // DS = DA = CA * CA**H
-      Gemm('N', 'C', NB, NB, this->nOA, T(1.), this->mo1, NB, this->mo1,
-        NB, T(0.), this->onePDM[SCALAR], NB);
+      occDensity(this->nOA,this->mo1,this->eps1,this->onePDM[SCALAR]);
 
       if(not iCS) {
 
         // DZ = DB = CB * CB**H
-        Gemm('N', 'C', NB, NB, this->nOB, T(1.), this->mo2, NB, this->mo2,
-          NB, T(0.), this->onePDM[MZ], NB);
+        occDensity(this->nOB,this->mo2,this->eps2,this->onePDM[MZ]);
 
         // DS = DA + DB
         // DZ = DA - DB
@@ -76,8 +151,7 @@ namespace ChronusQ {
 
       T * SCR = this->memManager.template malloc<T>(NB2);
 
-      Gemm('N', 'C', NB, NB, this->nO, T(1.), this->mo1, NB, this->mo1,
-        NB, T(0.), SCR, NB);
+      occDensity(this->nO,this->mo1,this->eps1,SCR);
 
       SpinScatter(NB/2,SCR,NB,this->onePDM[SCALAR],NB/2,this->onePDM[MZ],
         NB/2,this->onePDM[MY],NB/2,this->onePDM[MX],NB/2);
@@ -172,6 +246,8 @@ namespace ChronusQ {
   template <typename T>
   void SingleSlater<T>::computeMultipole(EMPerturbation &pert) {
 
+    // Make sure the length gauge multipole integrals are available
+    aoints.computeLenMultipole(3);
 
     // Compute elecric contribution to the dipoles
     for(auto iXYZ = 0; iXYZ < 3; iXYZ++) 
@@ -0,0 +1,381 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_SINGLESLATER_RESPONSE_HPP__
+#define __INCLUDED_SINGLESLATER_RESPONSE_HPP__
+
+#include <singleslater.hpp>
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <cqlinalg/krylov.hpp>
+#include <util/matout.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Evaluate the frequency dependent dipole polarizability of a
+   *  converged (real, 1C) single determinant by coupled perturbed 
+   *  HF / KS linear response.
+   *
+   *  In terms of P = X + Y and M = X - Y, the response to a real 
+   *  one-body perturbation V is given by the symmetric (indefinite for
+   *  w > 0) system
+   *
+   *  \f[
+   *    \begin{pmatrix} A + B & -\omega \\ -\omega & A - B \end{pmatrix}
+   *    \begin{pmatrix} P \\ M \end{pmatrix} = 
+   *    \begin{pmatrix} -2 V_{vo} \\ 0 \end{pmatrix}
+   *  \f]
+   *
+   *  where (A + B) P and (A - B) M are formed from the G[D] of the 
+   *  symmetric / antisymmetric AO trial densities. The trial densities of 
+   *  all unconverged right hand sides (3 field directions x frequencies) 
+   *  are contracted in a single twoBodyContract call per iteration, and 
+   *  the method specific kernel (XC) is added through 
+   *  formKernelResponse. The systems are solved with a preconditioned 
+   *  Krylov method (see KrylovSolve) using the orbital energy 
+   *  differences as preconditioner.
+   *
+   *  \warning Assumes the SCF has converged and the MOs are in the AO
+   *  basis (see SCFFin).
+   *
+   *  \param [in] ctl   Response controls
+   *  \param [in] xHFX  Scaling of the exact exchange
+   *  \returns          Polarizability, alpha_ij(w) stored at 
+   *                    [i + 3*j + 9*iFreq]
+   */ 
+  template <typename T>
+  std::vector<double> SingleSlater<T>::formPolarizability(
+    ResponseControls &ctl, double xHFX) {
+
+    if( not std::is_same<T,double>::value or this->nC != 1 )
+      CErr("Linear response is only implemented for real 1C references",
+        std::cout);
+
+    for(auto &w : ctl.freq)
+      if( ctl.alg == KRYLOV_CG and std::abs(w) > 1e-12 )
+        CErr("The CG response solver requires a static (w = 0) perturbation",
+          std::cout);
+
+    aoints.computeLenMultipole(1);
+
+    const size_t NB    = aoints.basisSet().nBasis;
+    const size_t NB2   = NB*NB;
+    const size_t nSpin = iCS ? 1 : 2;
+    const size_t nFreq = ctl.freq.size();
+    const size_t nRHS  = 3*nFreq;
+    const bool   doExch = std::abs(xHFX) > 1e-12;
+
+    const std::array<size_t,2> nOcc = {this->nOA, this->nOB};
+    const std::array<size_t,2> nVir = {this->nVA, this->nVB};
+    const std::array<double*,2> C = {
+      reinterpret_cast<double*>(this->mo1),
+      reinterpret_cast<double*>(iCS ? this->mo1 : this->mo2) };
+    const std::array<double*,2> eps = {this->eps1, 
+      iCS ? this->eps1 : this->eps2};
+
+    // Offsets of the spin blocks of P (and M)
+    std::array<size_t,2> off = {0, nVir[0]*nOcc[0]};
+    const size_t NP = off[nSpin-1] + nVir[nSpin-1]*nOcc[nSpin-1];
+    const size_t N  = 2*NP;
+
+    double *SCR = this->memManager.template malloc<double>(NB2);
+
+    // Y(vo) = C(v)**T * X * C(o) for spin block s
+    auto ao2vo = [&](size_t s, double *X, double *Y) {
+      Gemm('T','N',nVir[s],NB,NB,1.,C[s] + nOcc[s]*NB,NB,X,NB,0.,SCR,nVir[s]);
+      Gemm('N','N',nVir[s],nOcc[s],NB,1.,SCR,nVir[s],C[s],NB,0.,Y,nVir[s]);
+    };
+
+    // D = C(v) * X * C(o)**T +- (C(v) * X * C(o)**T)**T for spin block s
+    auto vo2ao = [&](size_t s, double *X, double fact, double *D) {
+      Gemm('N','N',NB,nOcc[s],nVir[s],1.,C[s] + nOcc[s]*NB,NB,X,nVir[s],
+        0.,SCR,NB);
+      Gemm('N','T',NB,NB,nOcc[s],1.,SCR,NB,C[s],NB,0.,D,NB);
+      for(auto j = 0ul; j < NB; j++)
+      for(auto i = 0ul; i < j ; i++) {
+        double Dij = D[i + j*NB], Dji = D[j + i*NB];
+        D[i + j*NB] = Dij + fact * Dji;
+        D[j + i*NB] = Dji + fact * Dij;
+      }
+      for(auto i = 0ul; i < NB; i++) D[i*(NB+1)] *= (1. + fact);
+    };
+
+    // Orbital energy differences
+    std::vector<double> dEps(NP);
+    for(auto s = 0ul; s < nSpin; s++)
+    for(auto i = 0ul; i < nOcc[s]; i++)
+    for(auto a = 0ul; a < nVir[s]; a++)
+      dEps[off[s] + a + i*nVir[s]] = eps[s][nOcc[s] + a] - eps[s][i];
+
+    // Dipole integrals in the vo space
+    std::vector<double> dipVO(3*NP);
+    for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+    for(auto s = 0ul; s < nSpin; s++)
+      ao2vo(s,aoints.lenElecDipole[iXYZ],&dipVO[iXYZ*NP + off[s]]);
+
+    // Right hand sides: -2 V(vo) with V = -r (see formFock), M = 0
+    double *B = this->memManager.template malloc<double>(N*nRHS);
+    double *X = this->memManager.template malloc<double>(N*nRHS);
+    std::fill_n(B,N*nRHS,0.);
+    for(auto iF = 0ul; iF < nFreq; iF++)
+    for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+    for(auto k = 0ul; k < NP; k++)
+      B[k + (iXYZ + 3*iF)*N] = 2. * dipVO[k + iXYZ*NP];
+
+
+    size_t nOpApply = 0;
+
+    // Response operator
+    KrylovOperator linOp = [&](size_t nVec, const size_t *iRHS, double *V, 
+      double *AV) {
+
+      nOpApply++;
+
+      // AO storage per vector: D+(S,Z), D-(S,Z), J+, K+(S,Z), K-(S,Z)
+      // and the kernel response (S,Z)
+      const size_t nMat = 11;
+      double *AO = this->memManager.template malloc<double>(nMat*NB2*nVec);
+      double *GX = this->memManager.template malloc<double>(NB2);
+      std::fill_n(AO,nMat*NB2*nVec,0.);
+
+      auto mat = [&](size_t k, size_t iMat) { 
+        return AO + (iMat + k*nMat)*NB2; 
+      };
+      enum { DPS, DPZ, DMS, DMZ, JP, KPS, KPZ, KMS, KMZ, VS, VZ };
+
+      std::vector<TwoBodyContraction<double,double>> contract;
+      std::vector<std::vector<double*>> kernDen, kernResp;
+
+      for(auto k = 0ul; k < nVec; k++) {
+
+        double *P = V + k*N, *M = P + NP;
+        bool doM = doExch and TwoNorm<double>(NP,M,1) > 1e-14;
+
+        // Spin resolved AO trial densities (S = a + b, Z = a - b)
+        for(auto s = 0ul; s < nSpin; s++) {
+
+          double fact = (s == 0) ? 1. : -1.;
+
+          vo2ao(s,P + off[s],1.,SCR);
+          DaxPy(NB2,1.,SCR,1,mat(k,DPS),1);
+          if( not iCS ) DaxPy(NB2,fact,SCR,1,mat(k,DPZ),1);
+
+          if( doM ) {
+            vo2ao(s,M + off[s],-1.,SCR);
+            DaxPy(NB2,1.,SCR,1,mat(k,DMS),1);
+            if( not iCS ) DaxPy(NB2,fact,SCR,1,mat(k,DMZ),1);
+          }
+
+        }
+
+        // Closed shell: DS = 2 * DA
+        if( iCS ) {
+          Scale(NB2,2.,mat(k,DPS),1);
+          Scale(NB2,2.,mat(k,DMS),1);
+        }
+
+        contract.push_back({mat(k,DPS),mat(k,JP),true,COULOMB});
+        if( doExch ) {
+          contract.push_back({mat(k,DPS),mat(k,KPS),true,EXCHANGE});
+          if( not iCS ) 
+            contract.push_back({mat(k,DPZ),mat(k,KPZ),true,EXCHANGE});
+        }
+
+        if( doM ) {
+          contract.push_back({mat(k,DMS),mat(k,KMS),false,EXCHANGE});
+          if( not iCS ) 
+            contract.push_back({mat(k,DMZ),mat(k,KMZ),false,EXCHANGE});
+        }
+
+        kernDen.push_back({mat(k,DPS)});
+        kernResp.push_back({mat(k,VS)});
+        if( not iCS ) {
+          kernDen.back().push_back(mat(k,DPZ));
+          kernResp.back().push_back(mat(k,VZ));
+        }
+
+      }
+
+      aoints.twoBodyContract(contract);
+      formKernelResponse(kernDen,kernResp);
+
+      for(auto k = 0ul; k < nVec; k++) {
+
+        double w = ctl.freq[iRHS[k] / 3];
+        double *P  = V  + k*N, *M  = P  + NP;
+        double *AP = AV + k*N, *AM = AP + NP;
+
+        // G(S) = 2J - xK(S) + V(S), G(Z) = -xK(Z) + V(Z) 
+        // G(a) = (G(S) + G(Z)) / 2, G(b) = (G(S) - G(Z)) / 2
+        for(auto s = 0ul; s < nSpin; s++) {
+
+          double fact = (s == 0) ? 0.5 : -0.5;
+
+          for(auto j = 0ul; j < NB2; j++)
+            GX[j] = mat(k,JP)[j] - 0.5 * xHFX * mat(k,KPS)[j] + 
+              0.5 * mat(k,VS)[j] +
+              (iCS ? 0. : fact * (mat(k,VZ)[j] - xHFX * mat(k,KPZ)[j]));
+          ao2vo(s,GX,AP + off[s]);
+
+          for(auto j = 0ul; j < NB2; j++)
+            GX[j] = -0.5 * xHFX * (mat(k,KMS)[j] + 
+              (iCS ? 0. : 2. * fact * mat(k,KMZ)[j]));
+          ao2vo(s,GX,AM + off[s]);
+
+        }
+
+        for(auto j = 0ul; j < NP; j++) {
+          AP[j] += dEps[j] * P[j] - w * M[j];
+          AM[j] += dEps[j] * M[j] - w * P[j];
+        }
+
+      }
+
+      this->memManager.free(AO,GX);
+
+    }; // linOp
+
+
+    // Orbital energy difference preconditioner. The 2x2 (P,M) blocks
+    // have eigenvalues dEps -+ w on (1,1) / (1,-1). MINRES requires an
+    // SPD preconditioner, hence the absolute values.
+    KrylovOperator precond = [&](size_t nVec, const size_t *iRHS, double *V, 
+      double *MV) {
+
+      for(auto k = 0ul; k < nVec; k++) {
+
+        double w = ctl.freq[iRHS[k] / 3];
+        double *P  = V  + k*N, *M  = P  + NP;
+        double *MP = MV + k*N, *MM = MP + NP;
+
+        for(auto j = 0ul; j < NP; j++) {
+
+          double dm = dEps[j] - w, dp = dEps[j] + w;
+          if( ctl.alg == KRYLOV_MINRES ) { 
+            dm = std::abs(dm); dp = std::abs(dp); 
+          }
+          if( std::abs(dm) < 1e-4 ) dm = std::copysign(1e-4,dm);
+          if( std::abs(dp) < 1e-4 ) dp = std::copysign(1e-4,dp);
+
+          double a = 0.5 * (P[j] + M[j]) / dm;
+          double b = 0.5 * (P[j] - M[j]) / dp;
+
+          MP[j] = a + b;
+          MM[j] = a - b;
+
+        }
+
+      }
+
+    }; // precond
+
+
+    if( printLevel > 0 ) {
+
+      std::cout << BannerTop << std::endl;
+      std::cout << "Linear Response Settings:" << std::endl << std::endl;
+
+      std::cout << std::setw(38) << std::left << "  Reference:" 
+                << refLongName_ << std::endl;
+      std::cout << std::setw(38) << std::left << "  Krylov Solver:";
+      if( ctl.alg == KRYLOV_CG )          std::cout << "CG";
+      else if( ctl.alg == KRYLOV_MINRES ) std::cout << "MINRES";
+      else                                std::cout << "GMRES";
+      std::cout << std::endl;
+
+      std::cout << std::scientific << std::setprecision(6);
+      std::cout << std::setw(38) << std::left << "  Convergence Tolerence:" 
+                << ctl.convTol << std::endl;
+      std::cout << std::setw(38) << std::left << "  Maximum Iterations:" 
+                << ctl.maxIter << std::endl;
+      std::cout << std::setw(38) << std::left << "  Number of Frequencies:" 
+                << nFreq << std::endl;
+      std::cout << std::setw(38) << std::left << "  Response Dimension:" 
+                << N << std::endl;
+
+    }
+
+    size_t nIter = 0;
+    bool converged = KrylovSolve(ctl.alg,N,nRHS,B,X,linOp,precond,
+      ctl.convTol,ctl.maxIter,nIter,this->memManager);
+
+    if( not converged )
+      CErr(std::string("Linear response failed to converge within ") + 
+        std::to_string(ctl.maxIter) + std::string(" iterations"));
+
+    // alpha_ij = sum_s <r_i(vo) | P_j> (x2 for closed shells)
+    std::vector<double> alpha(9*nFreq,0.);
+    for(auto iF = 0ul; iF < nFreq; iF++)
+    for(auto j = 0; j < 3; j++)
+    for(auto i = 0; i < 3; i++)
+      alpha[i + 3*j + 9*iF] = (iCS ? 2. : 1.) * 
+        InnerProd<double>(NP,&dipVO[i*NP],1,X + (j + 3*iF)*N,1);
+
+    if( printLevel > 0 ) {
+
+      std::cout << std::endl << "  Linear response converged in " << nIter 
+                << " iterations (" << nOpApply << " batched Fock builds)"
+                << std::endl;
+
+      const std::array<std::string,3> lab = {"X","Y","Z"};
+
+      for(auto iF = 0ul; iF < nFreq; iF++) {
+
+        std::cout << std::endl << "  Dipole Polarizability (au) at w = " 
+                  << std::fixed << std::setprecision(6) << ctl.freq[iF] 
+                  << " Eh:" << std::endl << BannerMid << std::endl;
+
+        std::cout << std::setw(8) << " ";
+        for(auto j = 0; j < 3; j++) 
+          std::cout << std::setw(20) << std::right << lab[j];
+        std::cout << std::endl;
+
+        for(auto i = 0; i < 3; i++) {
+          std::cout << "    " << std::setw(4) << std::left << lab[i];
+          for(auto j = 0; j < 3; j++)
+            std::cout << std::setw(20) << std::right 
+                      << alpha[i + 3*j + 9*iF];
+          std::cout << std::endl;
+        }
+
+        std::cout << std::endl << "    Isotropic Polarizability (au) = " 
+                  << (alpha[9*iF] + alpha[4 + 9*iF] + alpha[8 + 9*iF]) / 3.
+                  << std::endl;
+
+      }
+
+      std::cout << std::endl << BannerEnd << std::endl;
+
+    }
+
+    this->memManager.free(SCR,B,X);
+
+    return alpha;
+
+  }; // SingleSlater<T>::formPolarizability
+
+}; // namespace ChronusQ
+
+#endif
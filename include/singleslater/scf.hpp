@@ -26,8 +26,10 @@
 
 #include <singleslater.hpp>
 #include <util/matout.hpp>
+#include <util/threads.hpp>
 #include <cqlinalg/blas1.hpp>
 #include <cqlinalg/blasutil.hpp>
+#include <aointegrals/contract/direct.hpp>
 
 // SCF definitions for SingleSlaterBase
 #include <singleslater/base/scf.hpp> 
@@ -50,23 +52,37 @@ namespace ChronusQ {
       const std::array<std::string,4> spinLabel =
         { "SCALAR", "MZ", "MY", "MX" };
 
-      // Save Matricies
-      for(auto i = 0; i < this->fock.size(); i++) {
+      // AO quantities are saved in the original (input) basis ordering
+      const BasisSet &basis = this->aoints.basisSet();
+      T* SCR = basis.reordered ? 
+        this->memManager.template malloc<T>(NB*NB) : nullptr;
 
-        savFile.safeWriteData("SCF/1PDM_" + spinLabel[i],
-          this->onePDM[i],{NB,NB});
+      auto saveAO = [&](std::string name, T *X) {
+        if( basis.reordered ) {
+          basis.toOriginalOrder(NB,true,X,NB,SCR,NB);
+          X = SCR;
+        }
+        savFile.safeWriteData(name,X,{NB,NB});
+      };
 
-        savFile.safeWriteData("SCF/FOCK_" + spinLabel[i],
-          this->fock[i],{NB,NB});
+      // Save Matricies
+      for(auto i = 0; i < this->fock.size(); i++) {
 
-        savFile.safeWriteData("SCF/1PDM_ORTHO_" + spinLabel[i],
-          this->onePDMOrtho[i],{NB,NB});
+        saveAO("SCF/1PDM_" + spinLabel[i], this->onePDM[i]);
+        saveAO("SCF/FOCK_" + spinLabel[i], this->fock[i]);
 
-        savFile.safeWriteData("SCF/FOCK_ORTHO_" + spinLabel[i],
-          this->fockOrtho[i],{NB,NB});
+        // The orthonormal quantities are permuted in the same way. This
+        // is only valid for Lowdin orthonormalization, where the
+        // orthonormal functions map one to one onto the AOs
+        assert( not basis.reordered or 
+          this->aoints.orthoType == LOWDIN );
+        saveAO("SCF/1PDM_ORTHO_" + spinLabel[i], this->onePDMOrtho[i]);
+        saveAO("SCF/FOCK_ORTHO_" + spinLabel[i], this->fockOrtho[i]);
 
       }
 
+      if( SCR ) this->memManager.free(SCR);
+
       // Save Energies
       savFile.safeWriteData("SCF/TOTAL_ENERGY",&this->totalEnergy,
         {1});
@@ -132,14 +148,39 @@ namespace ChronusQ {
     // Form the Fock matrix D(k) -> F(k)
     if( frmFock ) formFock(pert,increment);
 
+    // F(k) -> C/D(k + 1)
+    getNewOrbitalsFromFock(frmFock);
+
+  }; // SingleSlater<T>::getNewOrbitals
+
+
+
+  /**
+   *  \brief Obtain a new set of orbitals from the current (AO) Fock
+   *  matrix.
+   *
+   *  \param [in] doExtrap Whether or not to apply the SCF extrapolation
+   *                       (damping / DIIS) to the Fock matrix
+   */ 
+  template <typename T>
+  void SingleSlater<T>::getNewOrbitalsFromFock(bool doExtrap) {
+
     // Transform AO fock into the orthonormal basis
     ao2orthoFock();
 
     // Modify fock matrix if requested
-    if( scfControls.doExtrap and frmFock ) modifyFock();
+    if( scfControls.doExtrap and doExtrap ) modifyFock();
+
+    // Diagonalize the orthonormal fock Matrix. Close to convergence 
+    // (small DIIS error) the previous MOs are instead corrected by 
+    // occupied-virtual rotations (see pseudoDiagOrthoFock)
+    bool pseudoDiag = scfControls.pseudoDiagTol > 0. and doExtrap and
+      scfControls.doExtrap and scfControls.diisAlg != NONE and 
+      scfConv.nSCFIter > 0 and scfConv.nrmFDC < scfControls.pseudoDiagTol and
+      nPseudoDiag_ >= 0 and nPseudoDiag_ < int(scfControls.nPseudoDiag) and
+      scfControls.curLevelShift == 0. and scfControls.curSmearTemp == 0.;
 
-    // Diagonalize the orthonormal fock Matrix
-    diagOrthoFock();
+    if( not (pseudoDiag and pseudoDiagOrthoFock()) ) diagOrthoFock();
 
     // Form the orthonormal density (in the AO storage)
     formDensity();
@@ -155,7 +196,7 @@ namespace ChronusQ {
     // Transform the orthonormal density to the AO basis
     ortho2aoDen();
 
-  }; // SingleSlater<T>::getNewOrbitals
+  }; // SingleSlater<T>::getNewOrbitalsFromFock
 
 
 
@@ -202,7 +243,53 @@ namespace ChronusQ {
     // Check FP convergence
     bool FDConv(false);
 
-    bool isConverged = FDConv or (energyConv and denConv);
+    // The SCF is not converged while the convergence aids are active,
+    // and the final orbitals must come from a full diagonalization
+    bool critConv = FDConv or (energyConv and denConv);
+    bool isConverged = critConv and nPseudoDiag_ <= 0 and
+      scfControls.curLevelShift == 0. and scfControls.curSmearTemp == 0.;
+
+    // Force a full diagonalization on the next iteration
+    if( critConv and nPseudoDiag_ > 0 ) 
+      nPseudoDiag_ = scfControls.nPseudoDiag;
+
+    // Anneal the level shift
+    if( scfControls.curLevelShift > 0. and 
+        scfConv.RMSDenScalar < scfControls.levelShiftTol ) {
+
+      scfControls.curLevelShift *= scfControls.levelShiftScale;
+
+      if( scfControls.curLevelShift < 1e-2 * scfControls.levelShift ) {
+
+        if( printLevel > 0 )
+          std::cout << "    *** Level Shift Disabled - Density Difference "
+                    << "Fell Below " << scfControls.levelShiftTol << " ***" 
+                    << std::endl;
+
+        scfControls.curLevelShift = 0.;
+
+      }
+
+    }
+
+    // Anneal the smearing width
+    if( scfControls.curSmearTemp > 0. and 
+        scfConv.RMSDenScalar < scfControls.smearTol ) {
+
+      scfControls.curSmearTemp *= scfControls.smearScale;
+
+      if( scfControls.curSmearTemp < scfControls.smearMinTemp ) {
+
+        if( printLevel > 0 )
+          std::cout << "    *** Smearing Disabled - Density Difference "
+                    << "Fell Below " << scfControls.smearTol << " ***" 
+                    << std::endl;
+
+        scfControls.curSmearTemp = 0.;
+
+      }
+
+    }
 
     // Toggle damping based on energy difference
     if( scfControls.doExtrap ) {
@@ -263,6 +350,13 @@ namespace ChronusQ {
 
         savFile.readData("/SCF/1PDM_" + spinLabel[i],DENSCR);
 
+        // Saved in the original (input) basis ordering
+        if( aoints.basisSet().reordered ) {
+          aoints.basisSet().toInternalOrder(NB,true,DENSCR,NB,
+            deltaOnePDM[i],NB);
+          std::copy_n(deltaOnePDM[i],NB*NB,DENSCR);
+        }
+
         MatAdd('N','N',NB,NB,T(1.),this->onePDM[i],NB,T(-1.),
           DENSCR,NB,deltaOnePDM[i],NB);
       }
@@ -292,38 +386,198 @@ namespace ChronusQ {
     size_t NB2 = NB*NB;
 
     // Copy over the fockOrtho into MO storage
+    gatherOrthoFock(this->mo1,this->mo2);
+
+    // Level shift the virtual space of the current density
+    //   F' = F + b * (I - P)
+    if( scfControls.curLevelShift > 0. ) {
+
+      const double shift = scfControls.curLevelShift;
+
+      auto levelShift = [&](T *F, T *P, double fact) {
+        for(auto j = 0; j < NB; j++) {
+          for(auto i = 0; i < NB; i++) 
+            F[i + j*NB] -= shift * fact * P[i + j*NB];
+          F[j*(NB+1)] += shift;
+        }
+      };
+
+      if(nC == 1 and iCS) 
+        levelShift(this->mo1,onePDMOrtho[SCALAR],0.5);
+      else if(nC == 1) {
+
+        // P(A) = (P(S) + P(Z)) / 2, P(B) = (P(S) - P(Z)) / 2
+        T* SCR = memManager.template malloc<T>(NB2);
+
+        MatAdd('N','N',NB,NB,T(1.),onePDMOrtho[SCALAR],NB,T(1.),
+          onePDMOrtho[MZ],NB,SCR,NB);
+        levelShift(this->mo1,SCR,0.5);
+
+        MatAdd('N','N',NB,NB,T(1.),onePDMOrtho[SCALAR],NB,T(-1.),
+          onePDMOrtho[MZ],NB,SCR,NB);
+        levelShift(this->mo2,SCR,0.5);
+
+        memManager.free(SCR);
+
+      } else {
+
+        T* SCR = memManager.template malloc<T>(NB2);
+
+        SpinGather(NB/2,SCR,NB,onePDMOrtho[SCALAR],NB/2,onePDMOrtho[MZ],
+          NB/2,onePDMOrtho[MY],NB/2,onePDMOrtho[MX],NB/2);
+        levelShift(this->mo1,SCR,1.);
+
+        memManager.free(SCR);
+
+      }
+
+    }
+
+    // Diagonalize the Fock Matrix (alpha and beta are independent)
+    std::array<int,2> INFO = {0,0};
+    TeamParallel((nC == 1 and not iCS) ? 2 : 1, [&](size_t i) {
+      INFO[i] = HermetianEigen('V', 'L', NB, i ? this->mo2 : this->mo1, NB, 
+        i ? this->eps2 : this->eps1, memManager );
+    });
+
+    if( INFO[0] != 0 ) CErr("HermetianEigen failed in Fock1",std::cout);
+    if( INFO[1] != 0 ) CErr("HermetianEigen failed in Fock2",std::cout);
+
+    nPseudoDiag_ = 0;
+
+#if 0
+    printMO(std::cout);
+#endif
+
+  }; // SingleSlater<T>::diagOrthoFock
+
+
+
+  /**
+   *  \brief Gather the spin components of the orthonormal fock matrix
+   *  into the form which is diagonalized for the MOs
+   *
+   *  \param [out] F1 Full (nC > 1) / ALPHA (nC == 1) orthonormal fock
+   *  \param [out] F2 BETA (nC == 1, not iCS) orthonormal fock
+   */ 
+  template <typename T>
+  void SingleSlater<T>::gatherOrthoFock(T *F1, T *F2) {
+
+    size_t NB = aoints.basisSet().nBasis * nC;
+    size_t NB2 = NB*NB;
+
     if(nC == 1 and iCS) 
-      std::transform(fockOrtho[SCALAR],fockOrtho[SCALAR] + NB2,this->mo1,
+      std::transform(fockOrtho[SCALAR],fockOrtho[SCALAR] + NB2,F1,
         [](T a){ return a / 2.; }
       );
     else if(nC == 1)
       for(auto j = 0; j < NB2; j++) {
-        this->mo1[j] = 0.5 * (fockOrtho[SCALAR][j] + fockOrtho[MZ][j]); 
-        this->mo2[j] = 0.5 * (fockOrtho[SCALAR][j] - fockOrtho[MZ][j]); 
+        F1[j] = 0.5 * (fockOrtho[SCALAR][j] + fockOrtho[MZ][j]); 
+        F2[j] = 0.5 * (fockOrtho[SCALAR][j] - fockOrtho[MZ][j]); 
       }
     else { 
 
-      SpinGather(NB/2,this->mo1,NB,fockOrtho[SCALAR],NB/2,fockOrtho[MZ],
+      SpinGather(NB/2,F1,NB,fockOrtho[SCALAR],NB/2,fockOrtho[MZ],
         NB/2,fockOrtho[MY],NB/2,fockOrtho[MX],NB/2);
 
     }
 
-    // Diagonalize the Fock Matrix
-    int INFO = HermetianEigen('V', 'L', NB, this->mo1, NB, this->eps1, 
-      memManager );
-    if( INFO != 0 ) CErr("HermetianEigen failed in Fock1",std::cout);
+  }; // SingleSlater<T>::gatherOrthoFock
 
-    if(nC == 1 and not iCS) {
-      INFO = HermetianEigen('V', 'L', NB, this->mo2, NB, this->eps2, 
-        memManager );
-      if( INFO != 0 ) CErr("HermetianEigen failed in Fock2",std::cout);
-    }
 
-#if 0
-    printMO(std::cout);
-#endif
 
-  }; // SingleSlater<T>::diagOrthoFock
+  /**
+   *  \brief Pseudo-diagonalize the orthonormal fock matrix
+   *
+   *  Rather than diagonalizing F, the (orthonormal) MOs of the previous
+   *  iteration are corrected by a single sweep of 2x2 (Jacobi) rotations
+   *  which decouple the occupied and virtual spaces to first order
+   *
+   *    t(a,i) = F(a,i) / (eps(i) - eps(a)), c = 1 / sqrt(1 + |t|**2)
+   *    C(i)  <- c * C(i) + c * t * C(a)
+   *    C(a)  <- c * C(a) - c * t** * C(i)
+   *
+   *  where eps are the orbital energies of the last full diagonalization
+   *  (which are left untouched). Beyond forming F(a,i), the rotations 
+   *  scale as O(NO * NV * NB).
+   *
+   *  \returns false (and leaves the MOs untouched) if the last HOMO-LUMO
+   *  gap is too small for the rotations to be reliable.
+   */ 
+  template <typename T>
+  bool SingleSlater<T>::pseudoDiagOrthoFock() {
+
+    size_t NB = aoints.basisSet().nBasis * nC;
+    size_t NB2 = NB*NB;
+    bool isUnrestricted = nC == 1 and not iCS;
+
+    size_t nOcc1 = (nC == 1) ? this->nOA : this->nO;
+    size_t nOcc2 = this->nOB;
+
+    // Smallest HOMO-LUMO gap (Eh) for which the rotations are performed
+    const double minGap = 1e-2;
+
+    auto smallGap = [&](size_t nOcc, double *eps) {
+      return nOcc > 0 and nOcc < NB and eps[nOcc] - eps[nOcc-1] < minGap;
+    };
+
+    if( smallGap(nOcc1,this->eps1) or 
+        (isUnrestricted and smallGap(nOcc2,this->eps2)) ) return false;
+
+    T* F1 = memManager.template malloc<T>(NB2);
+    T* F2 = isUnrestricted ? memManager.template malloc<T>(NB2) : nullptr;
+
+    gatherOrthoFock(F1,F2);
+
+    auto rotate = [&](size_t nOcc, T *F, T *C, double *eps) {
+
+      size_t nVir = NB - nOcc;
+      if( nOcc == 0 or nVir == 0 ) return;
+
+      T* FC  = memManager.template malloc<T>(NB*nOcc);
+      T* FVO = memManager.template malloc<T>(nVir*nOcc);
+
+      // F(a,i) = C(a)**H * F * C(i)
+      Gemm('N','N',NB,nOcc,NB,T(1.),F,NB,C,NB,T(0.),FC,NB);
+      Gemm('C','N',nVir,nOcc,NB,T(1.),C + nOcc*NB,NB,FC,NB,T(0.),FVO,nVir);
+
+      for(auto i = 0; i < nOcc; i++)
+      for(auto a = 0; a < nVir; a++) {
+
+        T t = FVO[a + i*nVir] / (eps[i] - eps[nOcc + a]);
+        if( std::abs(t) < 1e-14 ) continue;
+
+        double c = 1. / std::sqrt(1. + std::norm(t));
+        T s  = c * t;
+        T sc = SmartConj(s);
+
+        T *Ci = C + i*NB;
+        T *Ca = C + (nOcc + a)*NB;
+        for(auto k = 0; k < NB; k++) {
+          T ci  = Ci[k];
+          Ci[k] = c * ci    + s  * Ca[k];
+          Ca[k] = c * Ca[k] - sc * ci;
+        }
+
+      }
+
+      memManager.free(FC,FVO);
+
+    };
+
+    // Alpha and beta are independent
+    TeamParallel(isUnrestricted ? 2 : 1, [&](size_t i) {
+      if( i ) rotate(nOcc2,F2,this->mo2,this->eps2);
+      else    rotate(nOcc1,F1,this->mo1,this->eps1);
+    });
+
+    memManager.free(F1);
+    if( F2 ) memManager.free(F2);
+
+    nPseudoDiag_++;
+    return true;
+
+  }; // SingleSlater<T>::pseudoDiagOrthoFock
 
 
   /**
@@ -448,6 +702,9 @@ namespace ChronusQ {
     // extrapolation during the SCF procedure
     if ( scfControls.doExtrap ) allocExtrapStorage();
 
+    // The first step is always a full diagonalization
+    nPseudoDiag_ = -1;
+
   }; // SingleSlater<T>::SCFInit
 
 
@@ -462,6 +719,7 @@ namespace ChronusQ {
   void SingleSlater<T>::SCFFin() {
 
     ortho2aoMOs();
+    nPseudoDiag_ = -1;
 
     // Deallocate extrapolation storage
     if ( scfControls.doExtrap ) deallocExtrapStorage();
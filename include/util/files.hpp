@@ -94,6 +94,7 @@ namespace ChronusQ {
       // Member functions
 
       inline bool exists() const { return exists_; }
+      inline std::string fName() const { return fName_; }
       inline void setFile(const std::string &name) { fName_ = name; }
 
       inline void createFile() {
@@ -0,0 +1,251 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_UTIL_SHM_HPP__
+#define __INCLUDED_UTIL_SHM_HPP__
+
+#include <chronusq_sys.hpp>
+
+#include <atomic>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief 64-bit FNV-1a hash of a byte stream. Stable across processes
+   *  (unlike std::hash) and therefore usable to name shared objects.
+   */ 
+  inline uint64_t FNV1aHash(const void *data, size_t nBytes, 
+    uint64_t h = 14695981039346656037ull) {
+
+    const unsigned char *p = static_cast<const unsigned char*>(data);
+    for(size_t i = 0; i < nBytes; i++) {
+      h ^= p[i];
+      h *= 1099511628211ull;
+    }
+    return h;
+
+  }; // FNV1aHash
+
+
+  /**
+   *  \brief A named POSIX shared-memory segment holding read-only data
+   *  which is published by one process and attached to by other
+   *  processes on the same node.
+   *
+   *  The first process to open a given name becomes the owner: it
+   *  populates data() and calls publish(). Subsequent processes wait
+   *  for the data to be published and then map the data block
+   *  read-only (only the header, which holds the attachment count, is
+   *  writable). The segment is unlinked when the last attached process 
+   *  detaches.
+   *
+   *  A segment which cannot be created or attached to (or whose owner
+   *  abandons it) is flagged invalid, in which case the caller should
+   *  fall back to private storage. A segment left unpublished by an 
+   *  owner which no longer exists (e.g. after a crash) is stale: it is
+   *  unlinked by the first process to find it, so that a later run may
+   *  recreate it.
+   */ 
+  class SharedMemSegment {
+
+    struct Header {
+      std::atomic<int> state;     ///< 0 = publishing, 1 = ready, -1 = abandoned
+      std::atomic<int> nAttached; ///< # Processes attached to the segment
+      size_t           nBytes;    ///< Size of the data block
+      pid_t            ownerPID;  ///< PID of the publishing process
+    };
+
+    std::string name_;            ///< Segment name
+    char       *base_  = nullptr; ///< Start of the mapping
+    size_t      nBytes_;          ///< Size of the data block
+    size_t      headerBytes_;     ///< Header size (one page)
+    bool        owner_ = false;   ///< Whether this process publishes the data
+
+    Header* header() { return reinterpret_cast<Header*>(base_); }
+
+    /**
+     *  \brief Whether the owner recorded in the header no longer exists
+     */ 
+    bool ownerDead() {
+      pid_t pid = header()->ownerPID;
+      return pid > 0 and kill(pid,0) != 0 and errno == ESRCH;
+    }; // ownerDead
+
+  public:
+
+    SharedMemSegment(const SharedMemSegment &) = delete;
+    SharedMemSegment& operator=(const SharedMemSegment &) = delete;
+
+    /**
+     *  \brief Create or attach to a segment.
+     *
+     *  \param [in] name     Segment name (must start with "/")
+     *  \param [in] nBytes   Size of the data block
+     *  \param [in] maxWait  Max time (s) to wait for a live owner to 
+     *                       publish before falling back to private storage
+     */ 
+    SharedMemSegment(const std::string &name, size_t nBytes, 
+      double maxWait = 60.) : name_(name), nBytes_(nBytes),
+      headerBytes_(sysconf(_SC_PAGESIZE)) {
+
+      assert( sizeof(Header) <= headerBytes_ );
+
+      size_t mapBytes = headerBytes_ + nBytes_;
+
+      int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+      if( fd >= 0 ) {
+
+        // Owner: size, map and initialize the header
+        owner_ = true;
+        if( ftruncate(fd,mapBytes) != 0 ) { close(fd); abandon(); return; }
+
+        void *ptr = mmap(NULL,mapBytes,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+        close(fd);
+        if( ptr == MAP_FAILED ) { abandon(); return; }
+
+        base_ = static_cast<char*>(ptr);
+        new (base_) Header;
+        header()->nBytes   = nBytes_;
+        header()->ownerPID = getpid();
+        header()->nAttached.store(1);
+        header()->state.store(0,std::memory_order_release);
+
+        return;
+
+      }
+
+      if( errno != EEXIST ) return;
+
+      fd = shm_open(name_.c_str(), O_RDWR, 0600);
+      if( fd < 0 ) return;
+
+      auto tStart = std::chrono::high_resolution_clock::now();
+      auto elapsed = [&]() -> double {
+        return std::chrono::duration<double>(
+          std::chrono::high_resolution_clock::now() - tStart).count();
+      };
+
+      // Wait for the owner to size the segment. The owner does so 
+      // immediately after creating it, a segment which remains empty was
+      // left by an owner which failed in between
+      struct stat st;
+      while( fstat(fd,&st) == 0 and size_t(st.st_size) != mapBytes ) {
+        if( st.st_size != 0 ) { close(fd); return; } // Size mismatch
+        if( elapsed() > std::min(maxWait,5.) ) { 
+          close(fd); shm_unlink(name_.c_str()); return; 
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+
+      void *ptr = mmap(NULL,mapBytes,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+      close(fd);
+      if( ptr == MAP_FAILED ) return;
+
+      base_ = static_cast<char*>(ptr);
+
+      // The data block is read-only for the attached processes
+      if( nBytes_ and mprotect(base_ + headerBytes_,nBytes_,PROT_READ) != 0 ) {
+        munmap(base_,mapBytes); base_ = nullptr;
+        return;
+      }
+
+      // Wait for the data to be published
+      while( header()->state.load(std::memory_order_acquire) == 0 and
+             elapsed() < maxWait ) {
+
+        // Stale segment: the owner exited without publishing
+        if( ownerDead() ) {
+          shm_unlink(name_.c_str());
+          munmap(base_,mapBytes); base_ = nullptr;
+          return;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+      }
+
+      if( header()->state.load(std::memory_order_acquire) != 1 or
+          header()->nBytes != nBytes_ ) {
+        munmap(base_,mapBytes); base_ = nullptr;
+        return;
+      }
+
+      header()->nAttached++;
+
+    }; // SharedMemSegment constructor
+
+
+    /**
+     *  \brief Detach from the segment, unlinking it if this is the last
+     *  process attached.
+     */ 
+    ~SharedMemSegment() {
+
+      if( not base_ ) return;
+
+      if( owner_ and header()->state.load() == 0 ) abandon();
+      else if( --header()->nAttached == 0 ) shm_unlink(name_.c_str());
+
+      if( base_ ) munmap(base_,headerBytes_ + nBytes_);
+
+    }; // SharedMemSegment destructor
+
+
+    /**
+     *  \brief Flag the segment as abandoned (the data will not be
+     *  published) and remove the name.
+     */ 
+    void abandon() {
+      if( base_ ) header()->state.store(-1,std::memory_order_release);
+      shm_unlink(name_.c_str());
+      if( base_ ) { munmap(base_,headerBytes_ + nBytes_); base_ = nullptr; }
+    }; // abandon
+
+    /**
+     *  \brief Mark the data as published. Called by the owner once
+     *  data() has been populated.
+     */ 
+    void publish() {
+      if( owner_ and base_ ) 
+        header()->state.store(1,std::memory_order_release);
+    }; // publish
+
+    bool valid()   const { return base_ != nullptr; }
+    bool isOwner() const { return owner_; }
+    const std::string& name() const { return name_; }
+
+    template <typename T>
+    T* data() { return reinterpret_cast<T*>(base_ + headerBytes_); }
+
+  }; // class SharedMemSegment
+
+}; // namespace ChronusQ
+
+#endif
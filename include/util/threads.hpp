@@ -27,6 +27,11 @@
 #include <chronusq_sys.hpp>
 #include <cqlinalg/cqlinalg_config.hpp>
 
+#ifdef __linux__
+  #include <sched.h>
+  #include <sys/mman.h>
+#endif
+
 namespace ChronusQ {
 
   inline void SetLAThreads(size_t n) {
@@ -73,6 +78,261 @@ namespace ChronusQ {
   };
 
 
+
+  /**
+   *  \brief Thread placement policies
+   */ 
+  enum ThreadBinding {
+    BIND_NONE,   ///< Leave thread placement to the OS
+    BIND_CLOSE,  ///< Fill the sockets one at a time
+    BIND_SPREAD  ///< Distribute the threads round-robin over the sockets
+  };
+
+  /**
+   *  \brief Runtime threading model.
+   */ 
+  struct ThreadingModel {
+    ThreadBinding bind   = BIND_NONE; ///< Thread placement policy
+    size_t        nTeams = 1;         ///< # Thread teams for nested parallelism
+  };
+
+  inline ThreadingModel& GetThreadingModel() {
+    static ThreadingModel model;
+    return model;
+  };
+
+
+  /**
+   *  \brief Returns the CPUs available to the process grouped by socket
+   *  (physical package).
+   *
+   *  The topology is determined on the first call (prior to any binding)
+   *  and cached. Falls back to a single socket if the topology is not
+   *  available.
+   */ 
+  inline const std::vector<std::vector<int>>& SocketCPUs() {
+
+    static const std::vector<std::vector<int>> sockets = [](){
+
+      std::map<int,std::vector<int>> sockMap;
+
+#ifdef __linux__
+      cpu_set_t mask; CPU_ZERO(&mask);
+      if( sched_getaffinity(0,sizeof(mask),&mask) == 0 )
+        for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+          if( not CPU_ISSET(cpu,&mask) ) continue;
+
+          int sock = 0;
+          std::ifstream pkg("/sys/devices/system/cpu/cpu" + 
+            std::to_string(cpu) + "/topology/physical_package_id");
+          if( pkg.good() ) pkg >> sock;
+
+          sockMap[sock].push_back(cpu);
+        }
+#endif
+
+      std::vector<std::vector<int>> sockCPUs;
+      for(auto &X : sockMap) sockCPUs.emplace_back(std::move(X.second));
+
+      return sockCPUs;
+
+    }();
+
+    return sockets;
+
+  }; // SocketCPUs
+
+  inline size_t GetNumSockets() {
+    return std::max(SocketCPUs().size(),size_t(1));
+  };
+
+
+  /**
+   *  \brief Restricts the calling thread to a set of CPUs. A no-op
+   *  if thread affinity is not supported.
+   */ 
+  inline void BindThisThread(const std::vector<int> &cpus) {
+#ifdef __linux__
+    if( cpus.empty() ) return;
+    cpu_set_t mask; CPU_ZERO(&mask);
+    for(auto &cpu : cpus) CPU_SET(cpu,&mask);
+    sched_setaffinity(0,sizeof(mask),&mask);
+#endif
+  };
+
+
+  /**
+   *  \brief Binds the OpenMP threads according to a placement policy.
+   *
+   *  BIND_CLOSE places thread i on the i-th CPU in socket order,
+   *  BIND_SPREAD alternates sockets between consecutive threads and
+   *  BIND_NONE releases all threads to the full set of available CPUs.
+   */ 
+  inline void SetThreadBinding(ThreadBinding bind) {
+
+    GetThreadingModel().bind = bind;
+
+    auto &sockets = SocketCPUs();
+    if( sockets.empty() ) return;
+
+    // Order the CPUs according to the placement policy
+    std::vector<int> cpus;
+    if( bind == BIND_SPREAD ) {
+      size_t maxPerSock = 0;
+      for(auto &X : sockets) maxPerSock = std::max(maxPerSock,X.size());
+      for(size_t i = 0; i < maxPerSock; i++)
+      for(auto &X : sockets) if( i < X.size() ) cpus.push_back(X[i]);
+    } else
+      for(auto &X : sockets) cpus.insert(cpus.end(),X.begin(),X.end());
+
+    #pragma omp parallel
+    {
+      if( bind == BIND_NONE ) BindThisThread(cpus);
+      else BindThisThread({cpus[GetThreadID() % cpus.size()]});
+    }
+
+  }; // SetThreadBinding
+
+  inline void SetThreadTeams(size_t n) {
+    GetThreadingModel().nTeams = std::max(n,size_t(1));
+  };
+
+  inline size_t GetNumTeams() { return GetThreadingModel().nTeams; }
+
+
+  /**
+   *  \brief Executes nTask independent tasks over the thread teams.
+   *
+   *  Each team (one per socket for MISC.THREADTEAMS = SOCKET) executes its
+   *  tasks with threaded linear algebra restricted to the team, with the 
+   *  team bound to its socket if thread binding is enabled. Requires
+   *  thread-local LA thread control (MKL): the bundled OpenBLAS is neither
+   *  reentrant nor able to restrict its threads to a team, so MISC.THREADTEAMS
+   *  is rejected for non-MKL builds and the tasks are executed serially 
+   *  using all of the threads.
+   *
+   *  \param [in] nTask Number of tasks
+   *  \param [in] func  Task function, called as func(iTask)
+   */ 
+  template <typename F>
+  void TeamParallel(size_t nTask, const F &func) {
+
+#if defined(_OPENMP) && defined(_CQ_MKL)
+    size_t nTeams = std::min(GetNumTeams(),nTask);
+
+    if( nTeams > 1 ) {
+
+      size_t teamSize = std::max(GetNumThreads() / nTeams, size_t(1));
+      int maxLevels   = omp_get_max_active_levels();
+      int mklDynamic  = mkl_get_dynamic();
+
+      omp_set_max_active_levels(2);
+      mkl_set_dynamic(0);
+
+      auto &sockets = SocketCPUs();
+      bool bindTeams = GetThreadingModel().bind != BIND_NONE and 
+        not sockets.empty();
+
+      #pragma omp parallel num_threads(nTeams)
+      {
+        size_t iTeam = GetThreadID();
+
+        if( bindTeams ) BindThisThread(sockets[iTeam % sockets.size()]);
+        mkl_set_num_threads_local(teamSize);
+
+        for(size_t iTask = iTeam; iTask < nTask; iTask += nTeams)
+          func(iTask);
+
+        mkl_set_num_threads_local(0);
+      }
+
+      // Restore the outer level placement
+      if( bindTeams ) SetThreadBinding(GetThreadingModel().bind);
+
+      omp_set_max_active_levels(maxLevels);
+      mkl_set_dynamic(mklDynamic);
+
+      return;
+
+    }
+#endif
+
+    for(size_t iTask = 0; iTask < nTask; iTask++) func(iTask);
+
+  }; // TeamParallel
+
+
+  /**
+   *  \brief Thread-private scratch buffers.
+   *
+   *  The buffers are deliberately not taken from the CQMemManager pool,
+   *  whose pages are first touched by the master thread when the pool is
+   *  created and thus reside in its NUMA domain. Each buffer is instead
+   *  mapped (untouched) and zeroed by the thread which owns it, so that
+   *  under a first-touch NUMA policy its pages are placed in the memory 
+   *  local to that thread. The buffers are released on destruction.
+   */ 
+  template <typename T>
+  class ThreadScratch {
+
+    size_t           nByte_;   ///< Size of each buffer in bytes
+    std::vector<T*>  buffers_; ///< Per-thread buffers
+
+    static T* map(size_t nByte) {
+#ifdef __linux__
+      void *p = mmap(nullptr,nByte,PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+      return (p == MAP_FAILED) ? nullptr : static_cast<T*>(p);
+#else
+      return static_cast<T*>(std::malloc(nByte));
+#endif
+    }; // ThreadScratch::map
+
+    static void unmap(T *p, size_t nByte) {
+#ifdef __linux__
+      munmap(p,nByte);
+#else
+      std::free(p);
+#endif
+    }; // ThreadScratch::unmap
+
+    void release() {
+      for(auto &X : buffers_) if( X ) { unmap(X,nByte_); X = nullptr; }
+    }; // ThreadScratch::release
+
+  public:
+
+    ThreadScratch(size_t n, size_t nThreads = GetNumThreads()) : 
+      nByte_(n * sizeof(T)), buffers_(nThreads,nullptr) {
+
+      if( n == 0 ) return;
+
+      // Thread i maps and first touches buffer i
+      #pragma omp parallel for num_threads(nThreads) schedule(static,1)
+      for(size_t iThread = 0; iThread < nThreads; iThread++) {
+        T *X = map(nByte_);
+        if( X ) std::fill_n(X,n,T(0.));
+        buffers_[iThread] = X;
+      }
+
+      for(auto &X : buffers_) if( not X ) {
+        release();
+        throw std::bad_alloc();
+      }
+
+    }; // ThreadScratch constructor
+
+    ThreadScratch(const ThreadScratch &)            = delete;
+    ThreadScratch& operator=(const ThreadScratch &) = delete;
+
+    ~ThreadScratch() { release(); }
+
+    T* operator[](size_t iThread) { return buffers_[iThread]; }
+    T* local() { return buffers_[GetThreadID()]; }
+
+  }; // class ThreadScratch
+
+
 }; // namespace ChronusQ
 
 #endif
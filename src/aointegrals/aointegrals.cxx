@@ -30,6 +30,14 @@
   
 #define AOIntegrals_COLLECTIVE_OP(OP_MEMBER, OP_OP, OP_VEC_OP) \
     OP_MEMBER(this,other,threshSchwartz); \
+    OP_MEMBER(this,other,threshOneE); \
+    OP_MEMBER(this,other,nucFarField); \
+    OP_MEMBER(this,other,sigShellPairs_); \
+    OP_MEMBER(this,other,sharedMem); \
+    OP_MEMBER(this,other,eriCompress); \
+    OP_MEMBER(this,other,eriCompressTol); \
+    OP_MEMBER(this,other,shmPublished_); \
+    OP_MEMBER(this,other,collectERIStats); \
     OP_MEMBER(this,other,cAlg); \
     OP_MEMBER(this,other,orthoType); \
     OP_MEMBER(this,other,coreType); \
@@ -39,6 +47,10 @@
     OP_OP(double,this,other,memManager_,ortho1); \
     OP_OP(double,this,other,memManager_,ortho2); \
     \
+    /* Compressed ERIs */ \
+    OP_OP(unsigned char,this,other,memManager_,ERIComp); \
+    OP_OP(size_t,this,other,memManager_,ERICompOffset); \
+    \
     /* 1-e Integrals */ \
     OP_OP(double,this,other,memManager_,overlap); \
     OP_OP(double,this,other,memManager_,kinetic); \
@@ -51,10 +63,14 @@
     OP_VEC_OP(double,this,other,memManager_,velElecOctupole); \
     OP_VEC_OP(double,this,other,memManager_,magDipole); \
     OP_VEC_OP(double,this,other,memManager_,magQuadrupole); \
-    OP_VEC_OP(double,this,other,memManager_,coreH); \
-    \
-    /* 2-e Integrals */ \
-    OP_OP(double,this,other,memManager_,ERI)
+    OP_VEC_OP(double,this,other,memManager_,coreH);
+
+// The ERIs may reside in node-shared memory (not owned by the CQMemManager)
+#define AOIntegrals_ERI_OP(OP_OP) \
+  if( other.shmERI_ ) { \
+    shmERI_ = other.shmERI_; \
+    ERI     = other.ERI; \
+  } else { OP_OP(double,this,other,memManager_,ERI) }
 
 
 
@@ -70,6 +86,7 @@ namespace ChronusQ {
 
     AOIntegrals_COLLECTIVE_OP(COPY_OTHER_MEMBER,COPY_OTHER_MEMBER_OP,
       COPY_OTHER_MEMBER_VEC_OP);
+    AOIntegrals_ERI_OP(COPY_OTHER_MEMBER_OP);
 
   }; // AOIntegrals::AOIntegrals(const AOIntegrals &other)
 
@@ -86,6 +103,8 @@ namespace ChronusQ {
 
     AOIntegrals_COLLECTIVE_OP(COPY_OTHER_MEMBER,MOVE_OTHER_MEMBER_OP,
       MOVE_OTHER_MEMBER_VEC_OP);
+    AOIntegrals_ERI_OP(MOVE_OTHER_MEMBER_OP);
+    other.shmERI_ = nullptr; other.ERI = nullptr;
 
 
   }; // AOIntegrals::AOIntegrals(AOIntegrals &&other)
@@ -99,7 +118,96 @@ namespace ChronusQ {
 
     AOIntegrals_COLLECTIVE_OP(DUMMY3,DEALLOC_OP_5,DEALLOC_VEC_OP_5);
 
+    if( shmERI_ ) { ERI = nullptr; shmERI_ = nullptr; }
+    else DEALLOC_OP(memManager_,ERI);
+
   }; // AOIntegrals::dealloc()
 
 
+  /**
+   *  Discards all of the geometry dependent integral storage (1-e
+   *  integrals, ERIs, Schwartz bounds, orthonormalization and the
+   *  significant shell pairs) after the nuclei have been moved. The
+   *  integrals are to be recomputed (computeCoreHam, etc) before use.
+   */
+  void AOIntegrals::clearGeometry() {
+
+    dealloc();
+
+    schwartz = ortho1 = ortho2 = nullptr;
+    overlap  = kinetic = potential = ERI = nullptr;
+    ERIComp = nullptr; ERICompOffset = nullptr;
+
+    sigShellPairs_.clear();
+    shmPublished_.clear();
+
+  }; // AOIntegrals::clearGeometry
+
+
+  /**
+   *  \brief Key identifying the integrals of this AOIntegrals object
+   *  across processes.
+   *
+   *  Hash of the geometry, the basis and the integral settings which
+   *  affect the stored integrals.
+   */ 
+  std::string AOIntegrals::sharedKey() {
+
+    uint64_t h = FNV1aHash(nullptr,0);
+
+    auto hashVal = [&](const void *p, size_t n) { h = FNV1aHash(p,n,h); };
+
+    for(auto &atom : molecule_.atoms) {
+      hashVal(&atom.atomicNumber,sizeof(size_t));
+      hashVal(&atom.coord[0],3*sizeof(double));
+    }
+
+    for(auto &shell : basisSet_.shells) {
+      hashVal(&shell.O[0],3*sizeof(double));
+      hashVal(&shell.alpha[0],shell.alpha.size()*sizeof(double));
+      for(auto &c : shell.contr) {
+        hashVal(&c.l,sizeof(int));
+        hashVal(&c.pure,sizeof(bool));
+        hashVal(&c.coeff[0],c.coeff.size()*sizeof(double));
+      }
+    }
+
+    hashVal(&basisSet_.forceCart,sizeof(bool));
+    hashVal(&coreType,sizeof(coreType));
+    hashVal(&threshSchwartz,sizeof(double));
+    hashVal(&threshOneE,sizeof(double));
+    hashVal(&nucFarField,sizeof(double));
+
+    std::stringstream ss;
+    ss << "/chronusq_" << std::hex << h;
+    return ss.str();
+
+  }; // AOIntegrals::sharedKey
+
+
+  /**
+   *  \brief Create or attach to a node-shared segment for a set of
+   *  integrals.
+   *
+   *  \param [in] tag    Tag of the integral set
+   *  \param [in] nBytes Size of the integral set
+   *
+   *  \returns The segment, or nullptr if sharing is disabled or the 
+   *  segment is not usable (the caller then keeps private storage).
+   */ 
+  std::shared_ptr<SharedMemSegment> AOIntegrals::attachShared(
+    const std::string &tag, size_t nBytes) {
+
+    if( not sharedMem ) return nullptr;
+
+    auto seg = std::make_shared<SharedMemSegment>(sharedKey() + "_" + tag,
+      nBytes);
+
+    if( not seg->valid() ) return nullptr;
+
+    return seg;
+
+  }; // AOIntegrals::attachShared
+
+
 }; // namespace ChronusQ
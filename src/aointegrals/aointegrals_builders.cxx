@@ -23,6 +23,7 @@
  */
 
 #include <aointegrals.hpp>
+#include <aointegrals/quartets.hpp>
 #include <cqlinalg.hpp>
 #include <cqlinalg/blasutil.hpp>
 
@@ -42,6 +43,102 @@ namespace ChronusQ {
 
   typedef std::vector<libint2::Shell> shell_set; 
 
+  // Cartesian component labels for the saved 1-e operators
+  static const std::array<std::string,3> dipoleList =
+    { "X","Y","Z" };
+  static const std::array<std::string,6> quadrupoleList =
+    { "XX","XY","XZ","YY","YZ","ZZ" };
+  static const std::array<std::string,9> fullQuadrupoleList =
+    { "XX","XY","XZ","YX","YY","YZ","ZX","ZY","ZZ" };
+  static const std::array<std::string,10> octupoleList =
+    { "XXX","XXY","XXZ","XYY","XYZ","XZZ","YYY",
+      "YYZ","YZZ","ZZZ" };
+
+  /**
+   *  \brief A box of the octree of nuclear charges used for the far field
+   *  nuclear potential (see AOIntegrals::OneEDriver). The moments of the
+   *  point charges are taken about the center of the box.
+   */ 
+  struct NucBox {
+    std::array<double,3> center;   ///< Center of the box
+    double radius = 0.;            ///< Max distance of a nucleus from center
+    double charge = 0.;            ///< Total charge
+    std::array<double,3> dipole;   ///< sum_k q_k w_k
+    double quad[3][3];             ///< sum_k q_k w_k w_k**T
+    std::vector<size_t> nuclei;    ///< Nuclei in the box
+    std::vector<size_t> children;  ///< Child boxes (empty for leaves)
+  }; // struct NucBox
+
+  /**
+   *  \brief Recursively build the octree of a set of nuclear charges. 
+   *  Boxes are split about their center until they contain a single
+   *  nucleus (or coincident nuclei).
+   *
+   *  \param [in]     q    Nuclear charges and positions
+   *  \param [in]     idx  Nuclei of the box
+   *  \param [in/out] tree Octree boxes (root is tree[0])
+   *
+   *  \returns Index of the box in tree
+   */ 
+  static size_t buildNucTree(
+    const std::vector<std::pair<double,std::array<double,3>>> &q,
+    const std::vector<size_t> &idx, std::vector<NucBox> &tree) {
+
+    NucBox box;
+    box.nuclei = idx;
+
+    // Center of the bounding box of the nuclei
+    std::array<double,3> lo = q[idx[0]].second, hi = lo;
+    for(auto k : idx)
+    for(auto x = 0; x < 3; x++) {
+      lo[x] = std::min(lo[x],q[k].second[x]);
+      hi[x] = std::max(hi[x],q[k].second[x]);
+    }
+
+    for(auto x = 0; x < 3; x++) box.center[x] = 0.5 * (lo[x] + hi[x]);
+
+    // Moments about the center
+    box.dipole = {{ 0., 0., 0. }};
+    std::fill_n(&box.quad[0][0],9,0.);
+    for(auto k : idx) {
+
+      std::array<double,3> w;
+      for(auto x = 0; x < 3; x++) w[x] = q[k].second[x] - box.center[x];
+
+      box.radius = std::max(box.radius,
+        std::sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]));
+
+      box.charge += q[k].first;
+      for(auto x = 0; x < 3; x++) {
+        box.dipole[x] += q[k].first * w[x];
+        for(auto y = 0; y < 3; y++) box.quad[x][y] += q[k].first * w[x] * w[y];
+      }
+
+    }
+
+    size_t iBox = tree.size();
+    tree.emplace_back(box);
+
+    if( idx.size() == 1 or box.radius < 1e-10 ) return iBox;
+
+    // Split into octants about the center
+    std::array<std::vector<size_t>,8> oct;
+    for(auto k : idx) {
+      size_t iOct = 0;
+      for(auto x = 0; x < 3; x++)
+        if( q[k].second[x] > box.center[x] ) iOct |= (1 << x);
+      oct[iOct].emplace_back(k);
+    }
+
+    std::vector<size_t> children;
+    for(auto &O : oct)
+      if( not O.empty() ) children.emplace_back(buildNucTree(q,O,tree));
+
+    tree[iBox].children = children;
+    return iBox;
+
+  }; // buildNucTree
+
   /**
    *  \brief A general wrapper for 1-e (2 index) integral evaluation.
    *
@@ -77,6 +174,15 @@ namespace ChronusQ {
    *  The function will return a vector of 1 pointer
    *
    *  { kinetic }
+   *
+   *  Only the shell pairs which survive the overlap extent screening 
+   *  (threshOneE, see screenedShellPairs) are evaluated. If nucFarField
+   *  is positive, the nuclear potential due to nuclei further than 
+   *  nucFarField times the extent of a shell pair is evaluated from the
+   *  multipole expansion (through second order) of the interaction of the
+   *  shell pair with the nuclei. The nuclei are grouped in an octree, such
+   *  that a distant box of nuclei enters through its own moments and each
+   *  shell pair only visits O(log N) boxes.
    */ 
   AOIntegrals::oper_t_coll AOIntegrals::OneEDriver(libint2::Operator op, 
     shell_set& shells) {
@@ -119,8 +225,8 @@ namespace ChronusQ {
 
 
     // If engine is V, define nuclear charges
+    std::vector<std::pair<double,std::array<double,3>>> q;
     if(op == libint2::Operator::nuclear){
-      std::vector<std::pair<double,std::array<double,3>>> q;
       for(auto &atom : molecule_.atoms)
         q.push_back( { static_cast<double>(atom.atomicNumber), atom.coord } );
 
@@ -131,6 +237,35 @@ namespace ChronusQ {
     for(size_t i = 1; i < nthreads; i++) engines[i] = engines[0];
 
 
+    // Treat the nuclear potential of distant nuclei through a multipole 
+    // expansion of the shell pair charge distribution
+    bool farField = (op == libint2::Operator::nuclear) and (nucFarField > 0.);
+
+    std::vector<libint2::Engine> nearEngines, momEngines;
+    std::vector<NucBox> nucTree;
+    if( farField ) {
+      std::vector<size_t> allNuc(q.size());
+      std::iota(allNuc.begin(),allNuc.end(),0);
+      buildNucTree(q,allNuc,nucTree);
+
+      nearEngines = engines;
+      momEngines.emplace_back(libint2::Operator::emultipole2,maxPrim,maxL,0);
+      momEngines[0].set_precision(0.0);
+      for(size_t i = 1; i < nthreads; i++) 
+        momEngines.emplace_back(momEngines[0]);
+    }
+
+
+    // Significant shell pairs (shared with the 2-e engine for the CGTO
+    // basis)
+    std::vector<ShellPairTask> localPairs;
+    if( &shells != &basisSet_.shells ) 
+      localPairs = screenedShellPairs(shells,threshOneE);
+
+    const std::vector<ShellPairTask> &shellPairs = 
+      (&shells == &basisSet_.shells) ? significantShellPairs() : localPairs;
+
+
     // Determine the number of operators
     AOIntegrals::oper_t_coll mats( engines[0].results().size() );
 
@@ -151,19 +286,148 @@ namespace ChronusQ {
       int thread_id = GetThreadID();
 
       const auto& buf_vec = engines[thread_id].results();
-      size_t n1,n2;
 
-      // Loop over unique shell pairs
-      for(size_t s1(0), bf1_s(0), s12(0); s1 < shells.size(); bf1_s+=n1, s1++){ 
-        n1 = shells[s1].size(); // Size of Shell 1
-      for(size_t s2(0), bf2_s(0); s2 <= s1; bf2_s+=n2, s2++, s12++) {
-        n2 = shells[s2].size(); // Size of Shell 2
+      std::vector<std::pair<double,std::array<double,3>>> qNear;
+      std::vector<const NucBox*> farBoxes;
+      std::vector<size_t> boxStack;
+
+      // Loop over significant unique shell pairs
+      for(size_t iPair = 0; iPair < shellPairs.size(); iPair++) {
 
         // Round Robbin work distribution
         #ifdef _OPENMP
-        if( s12 % nthreads != thread_id ) continue;
+        if( iPair % nthreads != thread_id ) continue;
         #endif
 
+        const ShellPairTask &pair = shellPairs[iPair];
+        size_t s1 = pair.s1, bf1_s = pair.bf1, n1 = pair.n1;
+        size_t s2 = pair.s2, bf2_s = pair.bf2, n2 = pair.n2;
+
+
+        // Partition the nuclei into near and far field
+        if( farField ) {
+
+          std::array<double,3> P;
+          double extent = shellPairExtent(shells[s1],shells[s2],threshOneE,P);
+
+          // A box is far if all of its nuclei are further than 
+          // nucFarField times the combined extent of the shell pair and
+          // the box. The nuclei of the near leaves are treated exactly.
+          qNear.clear(); farBoxes.clear();
+          boxStack.assign(1,0);
+          while( not boxStack.empty() ) {
+
+            const NucBox &B = nucTree[boxStack.back()];
+            boxStack.pop_back();
+
+            double d = std::sqrt( 
+              (B.center[0] - P[0]) * (B.center[0] - P[0]) +
+              (B.center[1] - P[1]) * (B.center[1] - P[1]) +
+              (B.center[2] - P[2]) * (B.center[2] - P[2]) );
+
+            if( d > nucFarField * (extent + B.radius) ) 
+              farBoxes.push_back(&B);
+            else if( B.children.empty() )
+              for(auto k : B.nuclei) qNear.push_back(q[k]);
+            else
+              boxStack.insert(boxStack.end(),B.children.begin(),
+                B.children.end());
+
+          }
+
+          if( not farBoxes.empty() ) {
+
+            auto nucFarFieldBlock = matMaps[0].block(bf1_s,bf2_s,n1,n2);
+            nucFarFieldBlock.setZero();
+
+            // Near field from Libint
+            if( not qNear.empty() ) {
+
+              nearEngines[thread_id].set_params(qNear);
+              nearEngines[thread_id].compute(shells[s1],shells[s2]);
+
+              const auto& near_buf = nearEngines[thread_id].results();
+              if( near_buf[0] != nullptr ) {
+                Eigen::Map<
+                  const Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,
+                    Eigen::RowMajor>>
+                  bufMat(near_buf[0],n1,n2);
+
+                nucFarFieldBlock = bufMat;
+              }
+
+            }
+
+            // Far field from the multipoles (through quadrupole) of the 
+            // shell pair about P
+            momEngines[thread_id].compute(shells[s1],shells[s2]);
+            const auto& mom_buf = momEngines[thread_id].results();
+            if( mom_buf[0] == nullptr ) continue;
+
+            for(size_t i = 0, ij = 0; i < n1; i++)
+            for(size_t j = 0; j < n2; j++, ij++) {
+
+              // Moments about the origin
+              double S = mom_buf[0][ij];
+              std::array<double,3> M0 = 
+                {{ mom_buf[1][ij], mom_buf[2][ij], mom_buf[3][ij] }};
+              std::array<double,6> Q0 = 
+                {{ mom_buf[4][ij], mom_buf[5][ij], mom_buf[6][ij],
+                   mom_buf[7][ij], mom_buf[8][ij], mom_buf[9][ij] }};
+
+              // Translate to P
+              std::array<double,3> M;
+              for(auto k = 0; k < 3; k++) M[k] = M0[k] - P[k] * S;
+
+              double MQ[3][3];
+              for(size_t k = 0, kl = 0; k < 3; k++)
+              for(size_t l = k; l < 3; l++, kl++) {
+                MQ[k][l] = Q0[kl] - P[k] * M0[l] - P[l] * M0[k] + 
+                  P[k] * P[l] * S;
+                MQ[l][k] = MQ[k][l];
+              }
+
+              // 1/|r-R| = 1/d - D.v/d^3 + (3(D.v)^2 - d^2 v^2) / 2d^5
+              // D = P - C, v = (r - P) - (R - C) for a nucleus at R in
+              // the box centered at C
+              double V = 0.;
+              for(auto B : farBoxes) {
+                std::array<double,3> D = 
+                  {{ P[0] - B->center[0], P[1] - B->center[1], 
+                     P[2] - B->center[2] }};
+                double d2 = D[0]*D[0] + D[1]*D[1] + D[2]*D[2];
+                double d  = std::sqrt(d2);
+                double d3 = d2 * d;
+                double d5 = d3 * d2;
+
+                // sum_k q_k int rho v and sum_k q_k int rho v v**T
+                double DM = 0.;
+                for(auto k = 0; k < 3; k++) 
+                  DM += D[k] * (B->charge * M[k] - S * B->dipole[k]);
+
+                double DXD = 0., trX = 0.;
+                for(auto k = 0; k < 3; k++)
+                for(auto l = 0; l < 3; l++) {
+                  double X = B->charge * MQ[k][l] - M[k] * B->dipole[l] - 
+                    B->dipole[k] * M[l] + S * B->quad[k][l];
+                  DXD += D[k] * X * D[l];
+                  if( k == l ) trX += X;
+                }
+
+                V -= B->charge * S / d - DM / d3 + 
+                  (3. * DXD - d2 * trX) / (2. * d5);
+              }
+
+              nucFarFieldBlock(i,j) += V;
+
+            }
+
+            continue;
+
+          }
+
+        }
+
         // Compute the integrals       
         engines[thread_id].compute(shells[s1],shells[s2]);
 
@@ -183,8 +447,7 @@ namespace ChronusQ {
           matMaps[iMat].block(bf1_s,bf2_s,n1,n2) = bufMat;
         }
 
-      } // Loop over s2 <= s1
-      } // Loop over s1
+      } // Loop over shell pairs
 
     } // end OpenMP context
 
@@ -210,18 +473,22 @@ namespace ChronusQ {
    *  orthonormalization matricies over the given CGTO basis.
    *
    *  Computes:
-   *    Overlap + length gauge Electric Multipoles
+   *    Overlap + length gauge Electric Dipole
    *    Kinetic energy matrix
    *    Nuclear potential energy matrix
-   *    Core Hamiltonian (T + V)
    *    Orthonormalization matricies (Lowdin / Cholesky)
    *
+   *  Higher order multipoles, the magnetic dipole and the velocity
+   *  gauge integrals are evaluated on demand (see computeLenMultipole,
+   *  computeMagDipole and computeVelMultipole), or in computeCoreHam 
+   *  if a checkpoint file is attached.
+   *
    */ 
   void AOIntegrals::computeAOOneE(bool finiteWidthNuc ) {
 
     // Compute base 1-e integrals
     auto _multipole = 
-      OneEDriver(libint2::Operator::emultipole3,basisSet_.shells);
+      OneEDriver(libint2::Operator::emultipole1,basisSet_.shells);
 
     auto _kinetic = OneEDriver(libint2::Operator::kinetic,basisSet_.shells);
 
@@ -241,105 +508,181 @@ namespace ChronusQ {
                           std::placeholders::_3),
                 basisSet_.shells);
 
-;
 
-    auto _L = OneEDriverLocal<3,false>(
+    // Extract the pointers
+    overlap = _multipole[0];
+    std::copy_n(_multipole.begin()+1, 3, std::back_inserter(lenElecDipole));
+
+    kinetic   = _kinetic[0];
+    potential = _potential[0];
+
+
+    // Compute Orthonormalization trasformations
+    computeOrtho();
+
+    // Save Integrals to disk
+    std::string potentialTag = finiteWidthNuc ? "_FINITE_WIDTH" : "";
+
+    saveAOOper("INTS/OVERLAP", overlap);
+    saveAOOper("INTS/KINETIC", kinetic);
+    saveAOOper("INTS/POTENTIAL" + potentialTag, potential);
+
+    // Length Gauge electric dipole
+    for(auto i = 0; i < 3; i++)
+      saveAOOper("INTS/ELEC_DIPOLE_LEN_" + dipoleList[i], lenElecDipole[i]);
+
+  }; // AOIntegrals::computeAOOneE
+
+
+  /**
+   *  \brief Evaluate the length gauge electric multipoles up to a
+   *  given order if they have not already been evaluated.
+   *
+   *  The overlap and the dipole are always evaluated in computeAOOneE,
+   *  so only the quadrupole (order >= 2) and the octupole (order == 3)
+   *  are computed here.
+   *
+   *  \param [in] order Highest multipole order required (<= 3)
+   */ 
+  void AOIntegrals::computeLenMultipole(size_t order) {
+
+    assert( order <= 3 );
+
+    bool needQuad = (order >= 2) and lenElecQuadrupole.empty();
+    bool needOct  = (order >= 3) and lenElecOctupole.empty();
+
+    if( not needQuad and not needOct ) return;
+
+    auto _multipole = OneEDriver( needOct ? libint2::Operator::emultipole3 :
+      libint2::Operator::emultipole2, basisSet_.shells);
+
+    // The overlap and the dipoles are already known
+    for(auto i = 0; i < 4; i++) memManager_.free(_multipole[i]);
+
+    if( needQuad ) {
+
+      std::copy_n(_multipole.begin()+4, 6, 
+        std::back_inserter(lenElecQuadrupole));
+
+      for(auto i = 0; i < 6; i++)
+        saveAOOper("INTS/ELEC_QUADRUPOLE_LEN_" + quadrupoleList[i], 
+          lenElecQuadrupole[i]);
+
+    } else for(auto i = 4; i < 10; i++) memManager_.free(_multipole[i]);
+
+    if( needOct ) {
+
+      std::copy_n(_multipole.begin()+10,10,
+        std::back_inserter(lenElecOctupole));
+
+      for(auto i = 0; i < 10; i++)
+        saveAOOper("INTS/ELEC_OCTUPOLE_LEN_" + octupoleList[i], 
+          lenElecOctupole[i]);
+
+    }
+
+  }; // AOIntegrals::computeLenMultipole
+
+
+  /**
+   *  \brief Evaluate the magnetic dipole (angular momentum) integrals
+   *  if they have not already been evaluated.
+   */ 
+  void AOIntegrals::computeMagDipole() {
+
+    if( not magDipole.empty() ) return;
+
+    magDipole = OneEDriverLocal<3,false>(
                 std::bind(&AOIntegrals::computeAngularL,this,
                           std::placeholders::_1, std::placeholders::_2,
                           std::placeholders::_3),
                 basisSet_.shells);
 
-    auto _E1V = OneEDriverLocal<3,false>(
+    for(auto i = 0; i < 3; i++)
+      saveAOOper("INTS/MAG_DIPOLE_" + dipoleList[i], magDipole[i]);
+
+  }; // AOIntegrals::computeMagDipole
+
+
+  /**
+   *  \brief Evaluate the velocity gauge electric multipoles and the
+   *  magnetic quadrupole if they have not already been evaluated.
+   */ 
+  void AOIntegrals::computeVelMultipole() {
+
+    if( not velElecDipole.empty() ) return;
+
+    velElecDipole = OneEDriverLocal<3,false>(
                 std::bind(&AOIntegrals::computeEDipoleE1_vel,this,
                           std::placeholders::_1, std::placeholders::_2,
                           std::placeholders::_3),
                 basisSet_.shells);
 
 
-    auto _E2V = OneEDriverLocal<6,false>(
+    velElecQuadrupole = OneEDriverLocal<6,false>(
                 std::bind(&AOIntegrals::computeEQuadrupoleE2_vel,this,
                           std::placeholders::_1, std::placeholders::_2,
                           std::placeholders::_3),
                 basisSet_.shells);
 
 
-    auto _E3V = OneEDriverLocal<10,false>(
+    velElecOctupole = OneEDriverLocal<10,false>(
                 std::bind(&AOIntegrals::computeEOctupoleE3_vel,this,
                           std::placeholders::_1, std::placeholders::_2,
                           std::placeholders::_3),
                 basisSet_.shells);
 
 
-    auto _M2  = OneEDriverLocal<9,false>(
+    magQuadrupole = OneEDriverLocal<9,false>(
                 std::bind(&AOIntegrals::computeMQuadrupoleM2_vel,this,
                           std::placeholders::_1, std::placeholders::_2,
                           std::placeholders::_3),
                 basisSet_.shells);
 
 
+    for(auto i = 0; i < 3; i++)
+      saveAOOper("INTS/ELEC_DIPOLE_VEL_" + dipoleList[i], velElecDipole[i]);
 
-    // Extract the pointers
-    overlap = _multipole[0];
-    std::copy_n(_multipole.begin()+1, 3, std::back_inserter(lenElecDipole));
-    std::copy_n(_multipole.begin()+4, 6, std::back_inserter(lenElecQuadrupole));
-    std::copy_n(_multipole.begin()+10,10,std::back_inserter(lenElecOctupole));
-
-    kinetic   = _kinetic[0];
-    potential = _potential[0];
+    for(auto i = 0; i < 6; i++)
+      saveAOOper("INTS/ELEC_QUADRUPOLE_VEL_" + quadrupoleList[i], 
+        velElecQuadrupole[i]);
 
-    magDipole = { _L[0], _L[1], _L[2] };
+    for(auto i = 0; i < 10; i++)
+      saveAOOper("INTS/ELEC_OCTUPOLE_VEL_" + octupoleList[i], 
+        velElecOctupole[i]);
 
-    // FIXME: Save velocity gague integrals!
+    for(auto i = 0; i < 9; i++)
+      saveAOOper("INTS/MAG_QUADRUPOLE_" + fullQuadrupoleList[i], 
+        magQuadrupole[i]);
 
+  }; // AOIntegrals::computeVelMultipole
 
-    // Compute Orthonormalization trasformations
-    computeOrtho();
 
-    // Save Integrals to disk
-    if( savFile.exists() ) {
+  /**
+   *  \brief Write a 1-e operator to the checkpoint file (if one exists)
+   *  in the original (input) basis ordering.
+   *
+   *  \param [in] name Dataset name
+   *  \param [in] X    NB x NB operator in the internal basis ordering
+   */ 
+  void AOIntegrals::saveAOOper(std::string name, double *X) {
 
-      std::string potentialTag = finiteWidthNuc ? "_FINITE_WIDTH" : "";
+    if( not savFile.exists() ) return;
 
-      size_t NB = basisSet_.nBasis;
-      savFile.safeWriteData("INTS/OVERLAP", overlap, {NB,NB});
-      savFile.safeWriteData("INTS/KINETIC", kinetic, {NB,NB});
-      savFile.safeWriteData("INTS/POTENTIAL" + potentialTag,
-        potential, {NB,NB});
-  
-
-      const std::array<std::string,3> dipoleList =
-        { "X","Y","Z" };
-      const std::array<std::string,6> quadrupoleList =
-        { "XX","XY","XZ","YY","YZ","ZZ" };
-      const std::array<std::string,10> octupoleList =
-        { "XXX","XXY","XXZ","XYY","XYZ","XZZ","YYY",
-          "YYZ","YZZ","ZZZ" };
-
-      // Length Gauge electric dipole
-      for(auto i = 0; i < 3; i++)
-        savFile.safeWriteData("INTS/ELEC_DIPOLE_LEN_" + 
-          dipoleList[i], lenElecDipole[i], {NB,NB} );
+    size_t NB = basisSet_.nBasis;
 
-      // Length Gauge electric quadrupole
-      for(auto i = 0; i < 6; i++)
-        savFile.safeWriteData("INTS/ELEC_QUADRUPOLE_LEN_" + 
-          quadrupoleList[i], lenElecQuadrupole[i], {NB,NB} );
+    double *SCR = nullptr;
+    if( basisSet_.reordered ) {
+      SCR = memManager_.malloc<double>(nSQ_);
+      basisSet_.toOriginalOrder(NB,true,X,NB,SCR,NB);
+      X = SCR;
+    }
 
-      // Length Gauge electric octupole
-      for(auto i = 0; i < 10; i++)
-        savFile.safeWriteData("INTS/ELEC_OCTUPOLE_LEN_" + 
-          octupoleList[i], lenElecOctupole[i], {NB,NB} );
+    savFile.safeWriteData(name, X, {NB,NB});
 
+    if( SCR ) memManager_.free(SCR);
 
-      // Magnetic Dipole
-      for(auto i = 0; i < 3; i++)
-        savFile.safeWriteData("INTS/MAG_DIPOLE_" + 
-          dipoleList[i], magDipole[i], {NB,NB} );
-
-      // FIXME: Write valocity gauge integrals!
-    }
-
-  }; // AOIntegrals::computeAOOneE
+  }; // AOIntegrals::saveAOOper
 
 
   /**
@@ -351,7 +694,37 @@ namespace ChronusQ {
 
     assert(kinetic == nullptr); // Make sure we havent computed 1-e ints
 
-    if( typ == NON_RELATIVISTIC ) {
+    // Node-shared S, T, V, dipole and core Hamiltonian
+    size_t nCH = (typ == NON_RELATIVISTIC) ? 1 : 4;
+    auto shm = attachShared("core",(6 + nCH)*nSQ_*sizeof(double));
+
+    if( shm and not shm->isOwner() ) {
+
+      // Copy the published integrals
+      double *X = shm->data<double>();
+      auto fetch = [&]() -> double* {
+        double *P = memManager_.malloc<double>(nSQ_);
+        std::copy_n(X,nSQ_,P); X += nSQ_;
+        return P;
+      };
+
+      overlap   = fetch();
+      kinetic   = fetch();
+      potential = fetch();
+      for(auto i = 0; i < 3;   i++) lenElecDipole.emplace_back(fetch());
+      for(auto i = 0; i < nCH; i++) coreH.emplace_back(fetch());
+
+      computeOrtho();
+
+      std::string potentialTag = (typ == EXACT_2C) ? "_FINITE_WIDTH" : "";
+
+      saveAOOper("INTS/OVERLAP", overlap);
+      saveAOOper("INTS/KINETIC", kinetic);
+      saveAOOper("INTS/POTENTIAL" + potentialTag, potential);
+      for(auto i = 0; i < 3; i++)
+        saveAOOper("INTS/ELEC_DIPOLE_LEN_" + dipoleList[i], lenElecDipole[i]);
+
+    } else if( typ == NON_RELATIVISTIC ) {
 
       computeAOOneE(false);
 
@@ -376,6 +749,21 @@ namespace ChronusQ {
 
     }
 
+    // Publish the integrals to the node
+    if( shm and shm->isOwner() ) {
+
+      double *X = shm->data<double>();
+      auto put = [&](double *P) { std::copy_n(P,nSQ_,X); X += nSQ_; };
+
+      put(overlap); put(kinetic); put(potential);
+      for(auto &P : lenElecDipole) put(P);
+      for(auto &P : coreH)         put(P);
+
+      shm->publish();
+      shmPublished_.emplace_back(shm);
+
+    }
+
 
     // Save the Core Hamiltonian
     if( savFile.exists() ) {
@@ -384,10 +772,29 @@ namespace ChronusQ {
       const std::array<std::string,4> spinLabel =
         { "SCALAR", "MZ", "MY", "MX" };
 
-      for(auto i = 0; i < coreH.size(); i++)
-        savFile.safeWriteData("INTS/CORE_HAMILTONIAN_" +
-          spinLabel[i], coreH[i], {NB,NB});
+      // Save in the original (input) basis ordering
+      double *SCR = basisSet_.reordered ? 
+        memManager_.malloc<double>(nSQ_) : nullptr;
+
+      for(auto i = 0; i < coreH.size(); i++) {
+        double *X = coreH[i];
+        if( basisSet_.reordered ) {
+          basisSet_.toOriginalOrder(NB,true,X,NB,SCR,NB);
+          X = SCR;
+        }
+        savFile.safeWriteData("INTS/CORE_HAMILTONIAN_" + spinLabel[i], 
+          X, {NB,NB});
+      }
+
+      if( SCR ) memManager_.free(SCR);
+
+    }
 
+    // The property integrals are part of the checkpoint file
+    if( savFile.exists() ) {
+      computeLenMultipole(3);
+      computeMagDipole();
+      computeVelMultipole();
     }
 
 
@@ -420,6 +827,9 @@ namespace ChronusQ {
    */ 
   void AOIntegrals::computeERI() {
 
+    // Compressed storage (not node-shared)
+    if( eriCompress != ERI_FULL ) { computeERICompressed(); return; }
+
     // Determine the number of OpenMP threads
     int nthreads = GetNumThreads();
     
@@ -443,17 +853,44 @@ namespace ChronusQ {
     size_t NB3 = NB2*NB;
     size_t NB4 = NB2*NB2;
 
-    try { ERI = memManager_.malloc<double>(NB4); } 
-    catch(...) {
-      std::cout << std::fixed;
-      std::cout << "Insufficient memory for the full ERI tensor (" 
-                << (NB4/1e9) * sizeof(double) << " GB)" << std::endl;
-      std::cout << std::endl << memManager_ << std::endl;
-      CErr();
+    // Attach to the node-shared ERIs if they have been published
+    shmERI_ = attachShared("eri",NB4*sizeof(double));
+
+    if( shmERI_ ) {
+
+      ERI = shmERI_->data<double>();
+      if( not shmERI_->isOwner() ) return;
+
+    } else {
+
+      try { ERI = memManager_.malloc<double>(NB4); } 
+      catch(...) {
+        std::cout << std::fixed;
+        std::cout << "Insufficient memory for the full ERI tensor (" 
+                  << (NB4/1e9) * sizeof(double) << " GB)" << std::endl;
+        std::cout << std::endl << memManager_ << std::endl;
+        CErr();
+      }
+
     }
     std::fill_n(ERI,NB4,0.);
 
 
+    // Significant unique shell pairs sorted by integral class such that 
+    // quartets of the same class are evaluated contiguously
+    const std::vector<ShellPairTask> &shellPairs = significantShellPairs();
+    const size_t NPair = shellPairs.size();
+
+#ifdef _REPORT_QUARTET_CLASS_STATS
+    std::vector<QuartetClassStats> classStats(nthreads);
+#endif
+
+    // Screening statistics (opt-in), the in-core ERIs are not Schwartz 
+    // screened, the bounds are only collected
+    std::vector<ERIScreenStats> screenStats(collectERIStats ? nthreads : 0);
+    if( collectERIStats and schwartz == nullptr ) computeSchwartz();
+    const size_t NS = basisSet_.nShell;
+
     #pragma omp parallel
     {
       int thread_id = GetThreadID();
@@ -461,31 +898,40 @@ namespace ChronusQ {
       // Get threads result buffer
       const auto& buf_vec = engines[thread_id].results();
 
-      size_t n1,n2,n3,n4,i,j,k,l,ijkl,bf1,bf2,bf3,bf4;
-      size_t s4_max;
-      for(size_t s1(0), bf1_s(0), s1234(0); s1 < basisSet_.nShell; 
-          bf1_s+=n1, s1++) { 
+      ERIScreenStats *stats_loc = 
+        collectERIStats ? &screenStats[thread_id] : nullptr;
+      auto topThread = std::chrono::high_resolution_clock::now();
+
+      size_t i,j,k,l,ijkl,bf1,bf2,bf3,bf4;
 
-        n1 = basisSet_.shells[s1].size(); // Size of Shell 1
+      // Loop over class sorted bra shell pairs
+      for(size_t iBra = 0; iBra < NPair; iBra++) {
 
-      for(size_t s2(0), bf2_s(0); s2 <= s1; bf2_s+=n2, s2++) {
+        // Round Robbin work distribution
+        #ifdef _OPENMP
+        if( iBra % nthreads != thread_id ) continue;
+        #endif
 
-        n2 = basisSet_.shells[s2].size(); // Size of Shell 2
+        const ShellPairTask &bra = shellPairs[iBra];
 
-      for(size_t s3(0), bf3_s(0); s3 <= s1; bf3_s+=n3, s3++) {
+        const size_t s1 = bra.s1, bf1_s = bra.bf1, n1 = bra.n1;
+        const size_t s2 = bra.s2, bf2_s = bra.bf2, n2 = bra.n2;
 
-        n3 = basisSet_.shells[s3].size(); // Size of Shell 3
-        s4_max = (s1 == s3) ? s2 : s3; // Determine the unique max of Shell 4
+      // Loop over class sorted ket shell pairs, the 8-fold unique
+      // quartets are those with ket.pairIndex <= bra.pairIndex
+      for(auto &ket : shellPairs) {
 
-      for(size_t s4(0), bf4_s(0); s4 <= s4_max; bf4_s+=n4, s4++, s1234++) {
+        if( ket.pairIndex > bra.pairIndex ) continue;
 
-        n4 = basisSet_.shells[s4].size(); // Size of Shell 4
+        const size_t s3 = ket.s1, bf3_s = ket.bf1, n3 = ket.n1;
+        const size_t s4 = ket.s2, bf4_s = ket.bf2, n4 = ket.n2;
 
-        // Round Robbin work distribution
-        #ifdef _OPENMP
-        if( s1234 % nthreads != thread_id ) continue;
-        #endif
+        if( stats_loc ) 
+          stats_loc->addBound(schwartz[s1 + s2*NS] * schwartz[s3 + s4*NS]);
 
+#ifdef _REPORT_QUARTET_CLASS_STATS
+        auto topERI = std::chrono::high_resolution_clock::now();
+#endif
 
         // Evaluate ERI for shell quartet
         engines[thread_id].compute2<
@@ -496,9 +942,20 @@ namespace ChronusQ {
           basisSet_.shells[s4]
         );
 
+#ifdef _REPORT_QUARTET_CLASS_STATS
+        std::chrono::duration<double> durERI = 
+          std::chrono::high_resolution_clock::now() - topERI;
+        classStats[thread_id].add(bra,ket,durERI.count());
+#endif
+
         // Libint2 internal screening
         const double *buff = buf_vec[0];
-        if(buff == nullptr) continue;
+        if(buff == nullptr) { 
+          if( stats_loc ) stats_loc->nLibint++; 
+          continue; 
+        }
+
+        if( stats_loc ) stats_loc->addSurvivor(bra,ket);
 
         // Place shell quartet into persistent storage with
         // permutational symmetry
@@ -525,12 +982,24 @@ namespace ChronusQ {
             ERI[bf4 + bf3*NB + bf2*NB2 + bf1*NB3] = buff[ijkl];
 
         }; // ijkl loop
-      }; // s4
-      }; // s3
-      }; // s2
-      }; // s1
+      }; // ket pairs
+      }; // bra pairs
+
+      if( stats_loc ) {
+        std::chrono::duration<double> durThread = 
+          std::chrono::high_resolution_clock::now() - topThread;
+        stats_loc->time = durThread.count();
+      }
+
     }; // omp region
 
+#ifdef _REPORT_QUARTET_CLASS_STATS
+    for(auto iTh = 1; iTh < nthreads; iTh++) classStats[0] += classStats[iTh];
+    classStats[0].print(std::cerr,"In-Core ERI Class Statistics");
+#endif
+
+    if( collectERIStats ) reportERIScreenStats(screenStats);
+
     // Debug output of the ERIs
 #ifdef _DEBUGERI
     std::cout << "Two-Electron Integrals (ERIs)" << std::endl;
@@ -542,6 +1011,10 @@ namespace ChronusQ {
       std::cout << ERI[i + j*NB  + k*NB2 + l*NB3] << std::endl;
     };
 #endif
+
+    // Publish the ERIs to the node
+    if( shmERI_ ) shmERI_->publish();
+
   }; // AOIntegrals::computeERI
 
 
@@ -735,69 +1208,129 @@ namespace ChronusQ {
   /**
    *  \brief Allocate and evaluate the Schwartz bounds over the
    *  CGTO shell pairs.
+   *
+   *  The diagonal (s s | s s) quartets are evaluated first to obtain the
+   *  largest bound. Off-diagonal shell pairs whose rigorous primitive 
+   *  bound (shellPairCoulombBound) times the largest bound falls below 
+   *  threshSchwartz keep the primitive bound, the remaining pairs are 
+   *  evaluated exactly. As the stored values never underestimate the 
+   *  exact Schwartz bounds, the quartet screening remains rigorous. Shell 
+   *  pairs are distributed dynamically over threads with thread local 
+   *  libint2 engines.
    */ 
   void AOIntegrals::computeSchwartz() {
 
     if( schwartz != nullptr ) memManager_.free(schwartz);
 
     // Allocate the schwartz tensor
-    schwartz = memManager_.malloc<double>(basisSet_.nShell*basisSet_.nShell);
+    const size_t NS  = basisSet_.nShell;
+    const size_t NS2 = NS*NS;
+    schwartz = memManager_.malloc<double>(NS2);
+    std::fill_n(schwartz,NS2,0.);
+
+    // Copy the node-shared bounds if they have been published
+    auto shm = attachShared("schwartz",NS2*sizeof(double));
+    if( shm and not shm->isOwner() ) {
+      std::copy_n(shm->data<double>(),NS2,schwartz);
+      return;
+    }
+
+    // Determine the number of OpenMP threads
+    int nthreads = GetNumThreads();
+
+    // Create a vector of libint2::Engines for possible threading
+    std::vector<libint2::Engine> engines(nthreads);
 
     // Define the libint2 integral engine
-    libint2::Engine engine(libint2::Operator::coulomb,
+    engines[0] = libint2::Engine(libint2::Operator::coulomb,
       basisSet_.maxPrim,basisSet_.maxL,0);
 
-    engine.set_precision(0.); // Don't screen prims during evaluation
+    engines[0].set_precision(0.); // Don't screen prims during evaluation
 
-    const auto &buf_vec = engine.results();
+    // Copy over the engines to other threads if need be
+    for(size_t i = 1; i < nthreads; i++) engines[i] = engines[0];
 
-    auto topSch = std::chrono::high_resolution_clock::now();
-  
-    size_t n1,n2;
-    for(auto s1(0ul); s1 < basisSet_.nShell; s1++) {
-      n1 = basisSet_.shells[s1].size(); // Size shell 1
-    for(auto s2(0ul); s2 <= s1; s2++) {
-      n2 = basisSet_.shells[s2].size(); // Size shell 2
+    // Evaluate sqrt(max (s1 s2 | s1 s2)) for a shell pair
+    auto evalBound = [&](size_t s1, size_t s2, int thread_id, 
+      std::vector<double> &diags) {
 
+      const size_t n1 = basisSet_.shells[s1].size(); // Size shell 1
+      const size_t n2 = basisSet_.shells[s2].size(); // Size shell 2
 
+      const auto &buf_vec = engines[thread_id].results();
 
       // Evaluate the shell quartet (s1 s2 | s1 s2)
-      engine.compute(
+      engines[thread_id].compute(
         basisSet_.shells[s1],
         basisSet_.shells[s2],
         basisSet_.shells[s1],
         basisSet_.shells[s2]
       );
 
-      if(buf_vec[0] == nullptr) continue;
-
-      // Allocate space to hold the diagonals
-      double* diags = memManager_.malloc<double>(n1*n2);
+      if(buf_vec[0] == nullptr) return;
 
+      // Gather the diagonals
+      diags.resize(n1*n2);
       for(auto i(0), ij(0); i < n1; i++)
       for(auto j(0); j < n2; j++, ij++)
         diags[i + j*n1] = buf_vec[0][ij*n1*n2 + ij];
 
+      schwartz[s1 + s2*NS] = 
+        std::sqrt(MatNorm<double>('I',n1,n2,&diags[0],n1));
+
+    };
+
+    // Diagonal shell pairs
+    #pragma omp parallel
+    {
+      int thread_id = GetThreadID();
+      std::vector<double> diags;
+
+      #pragma omp for schedule(dynamic)
+      for(size_t s1 = 0; s1 < NS; s1++) evalBound(s1,s1,thread_id,diags);
+    }
+
+    double maxSchwartz = 0.;
+    for(auto s1 = 0; s1 < NS; s1++)
+      maxSchwartz = std::max(maxSchwartz,schwartz[s1*(NS+1)]);
+
+    // Off-diagonal shell pairs are only evaluated if their primitive
+    // bound may contribute to a quartet above the screening threshold
+    #pragma omp parallel
+    {
+      int thread_id = GetThreadID();
+      std::vector<double> diags;
 
-      schwartz[s1 + s2*basisSet_.nShell] = 
-        std::sqrt(MatNorm<double>('I',n1,n2,diags,n1));
+      #pragma omp for schedule(dynamic)
+      for(size_t s12 = 0; s12 < NS*(NS-1)/2; s12++) {
 
-      // Free up space
-      memManager_.free(diags);
+        // Unpack s12 -> s1 > s2
+        size_t s1 = (1 + std::sqrt(1. + 8.*s12)) / 2;
+        while( s1*(s1-1)/2 > s12 )  s1--;
+        while( s1*(s1+1)/2 <= s12 ) s1++;
+        size_t s2 = s12 - s1*(s1-1)/2;
 
-    } // loop s2
-    } // loop s1
+        double primBound = shellPairCoulombBound(basisSet_.shells[s1],
+          basisSet_.shells[s2]);
 
-    auto botSch = std::chrono::high_resolution_clock::now();
+        if( primBound * maxSchwartz < threshSchwartz ) {
+          schwartz[s1 + s2*NS] = primBound;
+          continue;
+        }
+
+        evalBound(s1,s2,thread_id,diags);
 
-    std::chrono::duration<double> durSch = botSch - topSch;
+      }
+    }
 
     HerMat('L',basisSet_.nShell,schwartz,basisSet_.nShell);
 
-#if 0
-    prettyPrintSmart(std::cout,"Schwartz",schwartz,basisSet_.nShell,
-      basisSet_.nShell,basisSet_.nShell);
-#endif
+    // Publish the bounds to the node
+    if( shm ) {
+      std::copy_n(schwartz,NS2,shm->data<double>());
+      shm->publish();
+      shmPublished_.emplace_back(shm);
+    }
 
   }; // AOIntegrals::computeSchwartz
 
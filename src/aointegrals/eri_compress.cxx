@@ -0,0 +1,472 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+
+#include <aointegrals.hpp>
+#include <aointegrals/quartets.hpp>
+#include <util/threads.hpp>
+#include <cerr.hpp>
+
+#include <cstring>
+
+namespace ChronusQ {
+
+  /*
+   *  Layout of the compressed ERIs
+   *
+   *  The ERI tensor is stored as NB^2 columns (kl) = k + l*NB, each column
+   *  being the NB x NB matrix (mn|kl). As (mn|kl) = (nm|kl), only the 
+   *  tiles of the significant shell pairs (s1 >= s2) are stored, in the
+   *  order of AOIntegrals::significantShellPairs. As (mn|kl) = (mn|lk),
+   *  the (lk) column shares the storage of the (kl) column, and the 
+   *  columns of insignificant shell pairs share a single zero column. 
+   *  Each tile is stored as
+   *
+   *    [code] [scale] [data]
+   *
+   *  where code is one of ERITileCode, scale (double) is only present for
+   *  the integer codes and data is the n1 x n2 tile in the precision given
+   *  by code. Integer tiles are reconstructed as q * scale, such that the
+   *  absolute error of the tile is bounded by scale / 2. Tiles for which
+   *  the scale outweighs the savings of the integer representation are
+   *  stored as TILE_DOUBLE.
+   *
+   *  The code of a tile is chosen from the Schwartz bound of its shell
+   *  quartet rather than from the evaluated integrals, such that the 
+   *  layout is known before the ERIs are evaluated.
+   */
+
+  enum ERITileCode : unsigned char {
+    TILE_ZERO,
+    TILE_INT8,
+    TILE_INT16,
+    TILE_INT32,
+    TILE_FLOAT,
+    TILE_DOUBLE
+  };
+
+  template <typename V>
+  static inline void writeBytes(unsigned char *&p, V x) {
+    std::memcpy(p,&x,sizeof(V));
+    p += sizeof(V);
+  }
+
+  template <typename V>
+  static inline V readBytes(const unsigned char *&p) {
+    V x;
+    std::memcpy(&x,p,sizeof(V));
+    p += sizeof(V);
+    return x;
+  }
+
+  template <typename Q>
+  static inline void writeQuantized(unsigned char *&p, const double *col, 
+    size_t NB, const ShellPairTask &tile, double scale) {
+
+    const long long qMax = std::numeric_limits<Q>::max();
+
+    for(auto j = 0ul; j < tile.n2; j++)
+    for(auto i = 0ul; i < tile.n1; i++) {
+      long long q = std::llround(col[tile.bf1 + i + (tile.bf2 + j)*NB] / scale);
+      writeBytes(p,static_cast<Q>(std::max(-qMax,std::min(qMax,q))));
+    }
+
+  }
+
+  template <typename Q>
+  static inline void readTile(const unsigned char *&p, double *col, 
+    size_t NB, const ShellPairTask &tile, double scale) {
+
+    for(auto j = 0ul; j < tile.n2; j++)
+    for(auto i = 0ul; i < tile.n1; i++) {
+      double x = scale * readBytes<Q>(p);
+      col[tile.bf1 + i + (tile.bf2 + j)*NB] = x;
+      col[tile.bf2 + j + (tile.bf1 + i)*NB] = x;
+    }
+
+  }
+
+
+  /**
+   *  \brief Size (in bytes) of a stored tile of n elements
+   */ 
+  static inline size_t tileBytes(ERITileCode code, size_t n) {
+
+    switch(code) {
+      case TILE_ZERO:  return 1;
+      case TILE_INT8:  return 1 + sizeof(double) + n*sizeof(int8_t);
+      case TILE_INT16: return 1 + sizeof(double) + n*sizeof(int16_t);
+      case TILE_INT32: return 1 + sizeof(double) + n*sizeof(int32_t);
+      case TILE_FLOAT: return 1 + n*sizeof(float);
+      default:         return 1 + n*sizeof(double);
+    }
+
+  }; // tileBytes
+
+
+  /**
+   *  \brief Smallest representation of a tile which satisfies the error
+   *  bound
+   *
+   *  \param [in]  maxAbs Bound on the magnitude of the tile elements
+   *  \param [in]  n      Number of elements in the tile
+   *  \param [in]  type   Compression scheme
+   *  \param [in]  tol    Max absolute error of an element
+   *  \param [out] scale  Scale of the integer representations
+   *
+   *  \returns The tile code
+   */ 
+  static ERITileCode tileCode(double maxAbs, size_t n, ERI_COMPRESSION type,
+    double tol, double &scale) {
+
+    ERITileCode code = TILE_DOUBLE;
+    scale = 1.;
+
+    double s8  = maxAbs / std::numeric_limits<int8_t>::max();
+    double s16 = maxAbs / std::numeric_limits<int16_t>::max();
+    double s32 = maxAbs / std::numeric_limits<int32_t>::max();
+
+    if( maxAbs <= tol )           code = TILE_ZERO;
+    else if( type == ERI_FLOAT32 ) code = TILE_FLOAT;
+    else if( s8  / 2. <= tol ) { code = TILE_INT8;  scale = s8;  }
+    else if( s16 / 2. <= tol ) { code = TILE_INT16; scale = s16; }
+    else if( s32 / 2. <= tol ) { code = TILE_INT32; scale = s32; }
+
+    // Store small tiles for which the scale outweighs the savings as is
+    if( tileBytes(code,n) > tileBytes(TILE_DOUBLE,n) ) code = TILE_DOUBLE;
+
+    return code;
+
+  }; // tileCode
+
+
+  /**
+   *  \brief Compress a (kl) column of the ERI tensor
+   *
+   *  \param [in]  col    NB x NB column (mn|kl)
+   *  \param [in]  NB     Number of basis functions
+   *  \param [in]  tiles  Significant shell pairs
+   *  \param [in]  codes  Code of each tile
+   *  \param [in]  scales Scale of each (integer) tile
+   *  \param [out] buf    Compressed column
+   */ 
+  static void compressERIColumn(const double *col, size_t NB, 
+    const std::vector<ShellPairTask> &tiles, 
+    const std::vector<ERITileCode> &codes, const std::vector<double> &scales,
+    unsigned char *buf) {
+
+    for(auto iTile = 0ul; iTile < tiles.size(); iTile++) {
+
+      const ShellPairTask &tile = tiles[iTile];
+      const ERITileCode    code = codes[iTile];
+
+      *buf++ = code;
+
+      if( code == TILE_FLOAT ) {
+
+        for(auto j = 0ul; j < tile.n2; j++)
+        for(auto i = 0ul; i < tile.n1; i++)
+          writeBytes(buf,
+            static_cast<float>(col[tile.bf1 + i + (tile.bf2 + j)*NB]));
+
+      } else if( code == TILE_DOUBLE ) {
+
+        for(auto j = 0ul; j < tile.n2; j++)
+        for(auto i = 0ul; i < tile.n1; i++)
+          writeBytes(buf,col[tile.bf1 + i + (tile.bf2 + j)*NB]);
+
+      } else if( code != TILE_ZERO ) {
+
+        const double scale = scales[iTile];
+        writeBytes(buf,scale);
+
+        if( code == TILE_INT8 )  writeQuantized<int8_t>(buf,col,NB,tile,scale);
+        if( code == TILE_INT16 ) writeQuantized<int16_t>(buf,col,NB,tile,scale);
+        if( code == TILE_INT32 ) writeQuantized<int32_t>(buf,col,NB,tile,scale);
+
+      }
+
+    }
+
+  }; // compressERIColumn
+
+
+  /**
+   *  \brief Evaluate and store the ERIs in the compressed representation
+   *  (see AOIntegrals::eriCompress).
+   *
+   *  The full tensor is never formed: for each significant ket shell pair
+   *  (s3 s4), the NB^2 x n3 x n4 slab of columns is evaluated (using the
+   *  (12)/(34) permutational symmetry only) and compressed directly into
+   *  the CQMemManager block. The tile codes (and thus the size of the 
+   *  block) follow from the Schwartz bounds, such that the ERIs are 
+   *  evaluated once and no intermediate copy of the compressed ERIs is
+   *  held.
+   */ 
+  void AOIntegrals::computeERICompressed() {
+
+    int nthreads = GetNumThreads();
+
+    std::vector<libint2::Engine> engines(nthreads);
+
+    engines[0] = libint2::Engine(libint2::Operator::coulomb,
+      basisSet_.maxPrim,basisSet_.maxL,0);
+    engines[0].set_precision(0.);
+
+    for(size_t i = 1; i < nthreads; i++) engines[i] = engines[0];
+
+    const size_t NB  = basisSet_.nBasis;
+    const size_t NB2 = NB*NB;
+    const size_t NS  = basisSet_.nShell;
+
+    if( schwartz == nullptr ) computeSchwartz();
+
+    const std::vector<ShellPairTask> &shellPairs = significantShellPairs();
+    const size_t NPair = shellPairs.size();
+
+    // Tile codes of the columns of a ket shell pair
+    std::vector<ERITileCode> codes(NPair);
+    std::vector<double>      scales(NPair);
+
+    auto ketCodes = [&](const ShellPairTask &ket) -> size_t {
+
+      const double ketBound = schwartz[ket.s1 + ket.s2*NS];
+
+      size_t colBytes = 0;
+      for(auto iBra = 0ul; iBra < NPair; iBra++) {
+
+        const ShellPairTask &bra = shellPairs[iBra];
+        const size_t n = bra.n1 * bra.n2;
+
+        // Quartets below the screening threshold are not evaluated
+        double bound = schwartz[bra.s1 + bra.s2*NS] * ketBound;
+        if( bound < threshSchwartz ) bound = 0.;
+
+        codes[iBra] = tileCode(bound,n,eriCompress,eriCompressTol,
+          scales[iBra]);
+        colBytes += tileBytes(codes[iBra],n);
+
+      }
+
+      return colBytes;
+
+    };
+
+    // Column offsets: the zero column is stored first, followed by the
+    // (kl) columns of each significant ket shell pair
+    ERICompOffset = memManager_.malloc<size_t>(NB2+1);
+    std::fill_n(ERICompOffset,NB2,0);
+
+    size_t nBytes = NPair;
+    for(auto &ket : shellPairs) {
+
+      size_t colBytes = ketCodes(ket);
+
+      for(auto l = 0ul; l < ket.n2; l++)
+      for(auto k = 0ul; k < ket.n1; k++) {
+        if( ket.s1 == ket.s2 and k < l ) continue;
+        ERICompOffset[(ket.bf1 + k) + (ket.bf2 + l)*NB] = nBytes;
+        ERICompOffset[(ket.bf2 + l) + (ket.bf1 + k)*NB] = nBytes;
+        nBytes += colBytes;
+      }
+
+    }
+
+    ERICompOffset[NB2] = nBytes;
+
+    try { ERIComp = memManager_.malloc<unsigned char>(nBytes); }
+    catch(...) {
+      std::cout << std::fixed;
+      std::cout << "Insufficient memory for the compressed ERI tensor (" 
+                << (nBytes/1e9) << " GB)" << std::endl;
+      std::cout << std::endl << memManager_ << std::endl;
+      CErr();
+    }
+
+    std::fill_n(ERIComp,NPair,TILE_ZERO);
+
+    size_t maxN = 0;
+    for(auto &shell : basisSet_.shells) maxN = std::max(maxN,shell.size());
+
+    // Slab of (kl) columns for a ket shell pair
+    double *COL = memManager_.malloc<double>(NB2*maxN*maxN);
+
+    // Screening statistics (opt-in)
+    std::vector<ERIScreenStats> screenStats(collectERIStats ? nthreads : 0);
+
+    for(auto &ket : shellPairs) {
+
+      const size_t s3 = ket.s1, bf3_s = ket.bf1, n3 = ket.n1;
+      const size_t s4 = ket.s2, bf4_s = ket.bf2, n4 = ket.n2;
+      const size_t nKet = n3*n4;
+
+      const double ketBound = schwartz[s3 + s4*NS];
+
+      ketCodes(ket);
+
+      std::fill_n(COL,NB2*nKet,0.);
+
+      #pragma omp parallel
+      {
+        int thread_id = GetThreadID();
+        const auto& buf_vec = engines[thread_id].results();
+
+        ERIScreenStats *stats_loc = 
+          collectERIStats ? &screenStats[thread_id] : nullptr;
+        auto topThread = std::chrono::high_resolution_clock::now();
+
+        size_t i,j,k,l,ijkl,bf1,bf2;
+
+        for(size_t iBra = 0; iBra < NPair; iBra++) {
+
+          #ifdef _OPENMP
+          if( iBra % nthreads != thread_id ) continue;
+          #endif
+
+          const ShellPairTask &bra = shellPairs[iBra];
+
+          double bound = schwartz[bra.s1 + bra.s2*NS] * ketBound;
+          if( stats_loc ) stats_loc->addBound(bound);
+
+          if( bound < threshSchwartz ) {
+            if( stats_loc ) stats_loc->nSchwartz++;
+            continue;
+          }
+
+          // Tiles below the compression tolerance are not stored
+          if( codes[iBra] == TILE_ZERO ) continue;
+
+          engines[thread_id].compute2<
+            libint2::Operator::coulomb, libint2::BraKet::xx_xx, 0>(
+            basisSet_.shells[bra.s1],
+            basisSet_.shells[bra.s2],
+            basisSet_.shells[s3],
+            basisSet_.shells[s4]
+          );
+
+          const double *buff = buf_vec[0];
+          if(buff == nullptr) {
+            if( stats_loc ) stats_loc->nLibint++;
+            continue;
+          }
+
+          if( stats_loc ) stats_loc->addSurvivor(bra,ket);
+
+          for(i = 0ul, bf1 = bra.bf1, ijkl = 0ul; i < bra.n1; ++i, bf1++) 
+          for(j = 0ul, bf2 = bra.bf2            ; j < bra.n2; ++j, bf2++) 
+          for(k = 0ul                           ; k < n3; ++k) 
+          for(l = 0ul                           ; l < n4; ++l, ++ijkl) {
+
+            COL[bf1 + bf2*NB + (k + l*n3)*NB2] = buff[ijkl];
+            COL[bf2 + bf1*NB + (k + l*n3)*NB2] = buff[ijkl];
+
+          }
+
+        }; // bra pairs
+
+        #pragma omp barrier
+
+        // Compress the (kl) columns, the (lk) columns share their storage
+        #pragma omp for
+        for(size_t kl = 0; kl < nKet; kl++) {
+
+          if( s3 == s4 and (kl % n3) < (kl / n3) ) continue;
+
+          size_t bf3 = bf3_s + (kl % n3);
+          size_t bf4 = bf4_s + (kl / n3);
+
+          compressERIColumn(COL + kl*NB2,NB,shellPairs,codes,scales,
+            ERIComp + ERICompOffset[bf3 + bf4*NB]);
+
+        }
+
+        if( stats_loc ) {
+          std::chrono::duration<double> durThread = 
+            std::chrono::high_resolution_clock::now() - topThread;
+          stats_loc->time += durThread.count();
+        }
+
+      }; // omp region
+
+    }; // ket pairs
+
+    memManager_.free(COL);
+
+    if( collectERIStats ) reportERIScreenStats(screenStats);
+
+    std::cout << "  * Compressed ERIs: " << std::setprecision(4)
+              << ERICompOffset[NB2] / 1e9 << " GB ("
+              << (NB2 * NB2 * sizeof(double)) / 1e9 << " GB full)\n" 
+              << std::endl;
+
+  }; // AOIntegrals::computeERICompressed
+
+
+  /**
+   *  \brief Decompress a contiguous range of (kl) columns of the
+   *  compressed ERIs.
+   *
+   *  \param [in]  kl   First (kl) column
+   *  \param [in]  nCol Number of columns
+   *  \param [out] out  NB^2 x nCol storage for (mn|kl)
+   */ 
+  void AOIntegrals::decompressERI(size_t kl, size_t nCol, double *out) {
+
+    const size_t NB = basisSet_.nBasis;
+    const std::vector<ShellPairTask> &tiles = significantShellPairs();
+
+    std::fill_n(out,nSQ_*nCol,0.);
+
+    for(auto iCol = 0ul; iCol < nCol; iCol++) {
+
+      double *col = out + iCol*nSQ_;
+      const unsigned char *p = ERIComp + ERICompOffset[kl + iCol];
+
+      for(auto &tile : tiles) {
+
+        ERITileCode code = static_cast<ERITileCode>(*p++);
+
+        if( code == TILE_ZERO ) continue;
+
+        else if( code == TILE_FLOAT ) 
+          readTile<float>(p,col,NB,tile,1.);
+        else if( code == TILE_DOUBLE ) 
+          readTile<double>(p,col,NB,tile,1.);
+
+        else {
+
+          double scale = readBytes<double>(p);
+
+          if( code == TILE_INT8 )  readTile<int8_t>(p,col,NB,tile,scale);
+          if( code == TILE_INT16 ) readTile<int16_t>(p,col,NB,tile,scale);
+          if( code == TILE_INT32 ) readTile<int32_t>(p,col,NB,tile,scale);
+
+        }
+
+      }
+
+    }
+
+  }; // AOIntegrals::decompressERI
+
+}; // namespace ChronusQ
@@ -0,0 +1,336 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <aointegrals.hpp>
+#include <aointegrals/quartets.hpp>
+#include <util/threads.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Sum the per-thread partial gradients into a single
+   *  3 x NAtoms gradient
+   */ 
+  static std::vector<double> reduceGradient(
+    std::vector<std::vector<double>> &gradThread) {
+
+    std::vector<double> grad(gradThread[0].size(),0.);
+    for(auto &G : gradThread)
+    for(auto i = 0ul; i < grad.size(); i++) grad[i] += G[i];
+
+    return grad;
+
+  }; // reduceGradient
+
+
+  /**
+   *  \brief Evaluate the 1-e contribution to the nuclear gradient of a
+   *  (real) single determinant energy.
+   *
+   *  \f[
+   *    \frac{\partial E_1}{\partial R_A} = 
+   *      \sum_{\mu\nu} P_{\mu\nu} \frac{\partial (T + V)_{\mu\nu}}{\partial R_A}
+   *      - \sum_{\mu\nu} W_{\mu\nu} \frac{\partial S_{\mu\nu}}{\partial R_A}
+   *  \f]
+   *
+   *  The nuclear potential is always evaluated from the point nuclei
+   *  without the far-field expansion (see nucFarField).
+   *
+   *  \param [in] DS  Total (scalar) density matrix (NB x NB)
+   *  \param [in] W   Energy weighted density matrix (NB x NB)
+   *  \returns        Gradient, stored (x,y,z) for each atom
+   */ 
+  std::vector<double> AOIntegrals::oneEGradient(double *DS, double *W) {
+
+    const size_t NB     = basisSet_.nBasis;
+    const size_t nAtoms = molecule_.nAtoms;
+
+    int nthreads = GetNumThreads();
+
+    // Point nuclei
+    std::vector<std::pair<double,std::array<double,3>>> q;
+    for(auto &atom : molecule_.atoms)
+      q.push_back( { static_cast<double>(atom.atomicNumber), atom.coord } );
+
+    // First derivative engines for S, T and V
+    std::vector<libint2::Engine> sEngines(nthreads), tEngines(nthreads),
+      vEngines(nthreads);
+
+    sEngines[0] = libint2::Engine(libint2::Operator::overlap,
+      basisSet_.maxPrim,basisSet_.maxL,1);
+    tEngines[0] = libint2::Engine(libint2::Operator::kinetic,
+      basisSet_.maxPrim,basisSet_.maxL,1);
+    vEngines[0] = libint2::Engine(libint2::Operator::nuclear,
+      basisSet_.maxPrim,basisSet_.maxL,1);
+
+    sEngines[0].set_precision(0.);
+    tEngines[0].set_precision(0.);
+    vEngines[0].set_precision(0.);
+    vEngines[0].set_params(q);
+
+    for(size_t i = 1; i < nthreads; i++) {
+      sEngines[i] = sEngines[0];
+      tEngines[i] = tEngines[0];
+      vEngines[i] = vEngines[0];
+    }
+
+    const std::vector<ShellPairTask> &shellPairs = significantShellPairs();
+
+    std::vector<std::vector<double>> gradThread(nthreads,
+      std::vector<double>(3*nAtoms,0.));
+
+    #pragma omp parallel
+    {
+      int thread_id = GetThreadID();
+      std::vector<double> &G = gradThread[thread_id];
+
+      const auto& sBuf = sEngines[thread_id].results();
+      const auto& tBuf = tEngines[thread_id].results();
+      const auto& vBuf = vEngines[thread_id].results();
+
+      for(size_t iPair = 0; iPair < shellPairs.size(); iPair++) {
+
+        // Round Robbin work distribution
+        #ifdef _OPENMP
+        if( iPair % nthreads != thread_id ) continue;
+        #endif
+
+        const ShellPairTask &pair = shellPairs[iPair];
+        const size_t s1 = pair.s1, bf1_s = pair.bf1, n1 = pair.n1;
+        const size_t s2 = pair.s2, bf2_s = pair.bf2, n2 = pair.n2;
+
+        const size_t A = basisSet_.mapSh2Cen[s1];
+        const size_t B = basisSet_.mapSh2Cen[s2];
+
+        // Off diagonal shell blocks represent both (s1,s2) and (s2,s1)
+        const double fac = (s1 == s2) ? 1. : 2.;
+
+        // Contract a (row major) shell block with a matrix
+        auto contract = [&](const double *buff, const double *X) -> double {
+          double val = 0.;
+          for(size_t i = 0, ij = 0; i < n1; i++)
+          for(size_t j = 0        ; j < n2; j++, ij++)
+            val += buff[ij] * X[(bf1_s + i) + (bf2_s + j)*NB];
+          return fac * val;
+        };
+
+        sEngines[thread_id].compute(basisSet_.shells[s1],basisSet_.shells[s2]);
+        tEngines[thread_id].compute(basisSet_.shells[s1],basisSet_.shells[s2]);
+        vEngines[thread_id].compute(basisSet_.shells[s1],basisSet_.shells[s2]);
+
+        for(size_t iXYZ = 0; iXYZ < 3; iXYZ++) {
+
+          // - W . dS
+          if( sBuf[0] != nullptr ) {
+            G[3*A + iXYZ] -= contract(sBuf[iXYZ],    W);
+            G[3*B + iXYZ] -= contract(sBuf[3 + iXYZ],W);
+          }
+
+          // P . dT
+          if( tBuf[0] != nullptr ) {
+            G[3*A + iXYZ] += contract(tBuf[iXYZ],    DS);
+            G[3*B + iXYZ] += contract(tBuf[3 + iXYZ],DS);
+          }
+
+          // P . dV (basis function centers + operator centers)
+          if( vBuf[0] != nullptr ) {
+            G[3*A + iXYZ] += contract(vBuf[iXYZ],    DS);
+            G[3*B + iXYZ] += contract(vBuf[3 + iXYZ],DS);
+            for(size_t iC = 0; iC < nAtoms; iC++)
+              G[3*iC + iXYZ] += contract(vBuf[6 + 3*iC + iXYZ],DS);
+          }
+
+        }
+
+      } // loop over shell pairs
+
+    } // OpenMP context
+
+    return reduceGradient(gradThread);
+
+  }; // AOIntegrals::oneEGradient
+
+
+  /**
+   *  \brief Evaluate the 2-e contribution to the nuclear gradient of a 
+   *  (real) single determinant energy by contracting the first 
+   *  derivative ERIs with the densities (direct, Schwartz screened).
+   *
+   *  \f[
+   *    \frac{\partial E_2}{\partial R_A} = \frac{1}{2} \sum_{\mu\nu\lambda\sigma}
+   *      \left[ P_{\mu\nu} P_{\lambda\sigma} - x_{HF} \sum_{s} 
+   *        P^s_{\mu\lambda} P^s_{\nu\sigma} \right]
+   *      \frac{\partial (\mu\nu | \lambda\sigma)}{\partial R_A}
+   *  \f]
+   *
+   *  Only the 8-fold unique shell quartets are evaluated.
+   *
+   *  \param [in] DS     Total (scalar) density matrix (NB x NB)
+   *  \param [in] DSpin  Spin (alpha, beta) density matrices (NB x NB)
+   *  \param [in] xHFX   Scaling of the exact exchange
+   *  \returns           Gradient, stored (x,y,z) for each atom
+   */ 
+  std::vector<double> AOIntegrals::twoEGradient(double *DS, 
+    std::vector<double*> &DSpin, double xHFX) {
+
+    const size_t NB     = basisSet_.nBasis;
+    const size_t NS     = basisSet_.nShell;
+    const size_t nAtoms = molecule_.nAtoms;
+
+    const bool doK = std::abs(xHFX) > 1e-12;
+
+    int nthreads = GetNumThreads();
+
+    if( schwartz == nullptr ) computeSchwartz();
+
+    // Shell block max norms of the densities for screening
+    std::vector<double> shBlkNorm(NS*NS,0.);
+    for(size_t s2 = 0; s2 < NS; s2++)
+    for(size_t s1 = 0; s1 < NS; s1++) {
+
+      double blkMax = 0.;
+      for(size_t nu = basisSet_.mapSh2Bf[s2]; 
+          nu < basisSet_.mapSh2Bf[s2] + basisSet_.shells[s2].size(); nu++)
+      for(size_t mu = basisSet_.mapSh2Bf[s1]; 
+          mu < basisSet_.mapSh2Bf[s1] + basisSet_.shells[s1].size(); mu++) {
+        blkMax = std::max(blkMax,std::abs(DS[mu + nu*NB]));
+        for(auto &X : DSpin) 
+          blkMax = std::max(blkMax,std::abs(X[mu + nu*NB]));
+      }
+
+      shBlkNorm[s1 + s2*NS] = blkMax;
+
+    }
+
+    std::vector<libint2::Engine> engines(nthreads);
+
+    engines[0] = libint2::Engine(libint2::Operator::coulomb,
+      basisSet_.maxPrim,basisSet_.maxL,1);
+    engines[0].set_precision(0.);
+
+    for(size_t i = 1; i < nthreads; i++) engines[i] = engines[0];
+
+    const std::vector<ShellPairTask> &shellPairs = significantShellPairs();
+    const size_t NPair = shellPairs.size();
+
+    std::vector<std::vector<double>> gradThread(nthreads,
+      std::vector<double>(3*nAtoms,0.));
+
+    #pragma omp parallel
+    {
+      int thread_id = GetThreadID();
+      std::vector<double> &G = gradThread[thread_id];
+
+      const auto& buf_vec = engines[thread_id].results();
+
+      std::array<double,12> dE;
+      size_t i,j,k,l,ijkl,bf1,bf2,bf3,bf4;
+
+      // Loop over class sorted bra shell pairs
+      for(size_t iBra = 0; iBra < NPair; iBra++) {
+
+        // Round Robbin work distribution
+        #ifdef _OPENMP
+        if( iBra % nthreads != thread_id ) continue;
+        #endif
+
+        const ShellPairTask &bra = shellPairs[iBra];
+
+        const size_t s1 = bra.s1, bf1_s = bra.bf1, n1 = bra.n1;
+        const size_t s2 = bra.s2, bf2_s = bra.bf2, n2 = bra.n2;
+
+        const double braBound = schwartz[s1 + s2*NS];
+
+      // 8-fold unique quartets (ket.pairIndex <= bra.pairIndex)
+      for(auto &ket : shellPairs) {
+
+        if( ket.pairIndex > bra.pairIndex ) continue;
+
+        const size_t s3 = ket.s1, bf3_s = ket.bf1, n3 = ket.n1;
+        const size_t s4 = ket.s2, bf4_s = ket.bf2, n4 = ket.n2;
+
+        const std::array<size_t,4> cen = {
+          basisSet_.mapSh2Cen[s1], basisSet_.mapSh2Cen[s2],
+          basisSet_.mapSh2Cen[s3], basisSet_.mapSh2Cen[s4] };
+
+        // One center quartets do not contribute (translational invariance)
+        if( cen[0] == cen[1] and cen[0] == cen[2] and cen[0] == cen[3] )
+          continue;
+
+        // Density weighted Schwartz screening
+        double maxD = shBlkNorm[s1 + s2*NS] * shBlkNorm[s3 + s4*NS];
+        if( doK ) 
+          maxD = std::max({ maxD, 
+            shBlkNorm[s1 + s3*NS] * shBlkNorm[s2 + s4*NS],
+            shBlkNorm[s1 + s4*NS] * shBlkNorm[s2 + s3*NS] });
+
+        if( braBound * schwartz[s3 + s4*NS] * maxD < threshSchwartz )
+          continue;
+
+        engines[thread_id].compute2<
+          libint2::Operator::coulomb, libint2::BraKet::xx_xx, 1>(
+          basisSet_.shells[s1],
+          basisSet_.shells[s2],
+          basisSet_.shells[s3],
+          basisSet_.shells[s4]
+        );
+
+        // Libint2 internal screening
+        if(buf_vec[0] == nullptr) continue;
+
+        // Degeneracy of the unique quartet
+        const double deg = ((s1 == s2) ? 1. : 2.) * ((s3 == s4) ? 1. : 2.) *
+          ((bra.pairIndex == ket.pairIndex) ? 1. : 2.);
+
+        dE.fill(0.);
+
+        for(i = 0ul, bf1 = bf1_s, ijkl = 0ul ; i < n1; ++i, bf1++) 
+        for(j = 0ul, bf2 = bf2_s             ; j < n2; ++j, bf2++) 
+        for(k = 0ul, bf3 = bf3_s             ; k < n3; ++k, bf3++) 
+        for(l = 0ul, bf4 = bf4_s             ; l < n4; ++l, bf4++, ++ijkl) {
+
+          // Effective 2-PDM element
+          double P = 0.5 * DS[bf1 + bf2*NB] * DS[bf3 + bf4*NB];
+          if( doK )
+            for(auto &X : DSpin)
+              P -= 0.25 * xHFX * ( X[bf1 + bf3*NB] * X[bf2 + bf4*NB] +
+                                   X[bf1 + bf4*NB] * X[bf2 + bf3*NB] );
+
+          for(size_t d = 0; d < 12; d++) dE[d] += P * buf_vec[d][ijkl];
+
+        }
+
+        for(size_t d = 0; d < 12; d++) 
+          G[3*cen[d/3] + (d % 3)] += deg * dE[d];
+
+      } // ket pairs
+      } // bra pairs
+
+    } // OpenMP context
+
+    return reduceGradient(gradThread);
+
+  }; // AOIntegrals::twoEGradient
+
+}; // namespace ChronusQ
@@ -39,6 +39,15 @@ namespace ChronusQ {
         << "Libint2 + In-House" << std::endl;
 
 
+    out << "  " << std::setw(28) << "Shell Pair Threshold:" 
+        << aoints.threshOneE << std::endl;
+    if( aoints.nucFarField > 0. )
+      out << "    * Multipole Far-Field Nuclear Potential (Ratio = "
+          << aoints.nucFarField << ")\n";
+    if( aoints.sharedMem )
+      out << "    * Sharing Integrals Between Processes on the Node\n";
+
+
     out << std::endl;
     out << "  " << std::setw(28) << "Core Hamiltonian:";
     if(aoints.coreType == NON_RELATIVISTIC) 
@@ -52,12 +61,15 @@ namespace ChronusQ {
 
 
     out << std::endl;
-    out << "  Property Integrals:\n";
-    out << "    * Will Compute Length Gauge Electric Multipoles up to Octupole"
+    if( aoints.savFile.exists() )
+      out << "  Property Integrals (saved to the checkpoint file):\n";
+    else
+      out << "  Property Integrals (evaluated on demand):\n";
+    out << "    * Length Gauge Electric Multipoles up to Octupole"
         << std::endl;
-    out << "    * Will Compute Velocity Gauge Electric Multipoles up to Octupole"
+    out << "    * Velocity Gauge Electric Multipoles up to Octupole"
         << std::endl;
-    out << "    * Will Compute Magnetic Multipoles up to Quadrupole"
+    out << "    * Magnetic Multipoles up to Quadrupole"
         << std::endl;
     out << std::endl;
 
@@ -68,9 +80,20 @@ namespace ChronusQ {
     else                      out << "DIRECT";
     out << std::endl;
 
-    if( aoints.cAlg == DIRECT )
+    if( aoints.cAlg == INCORE and aoints.eriCompress != ERI_FULL ) {
+      out << "    * Compressed ERI Storage (";
+      if( aoints.eriCompress == ERI_FLOAT32 ) out << "Single Precision)\n";
+      else                                    out << "Quantized)\n";
+      out << "    * Compression Tolerance = " 
+          << aoints.eriCompressTol << "\n";
+    }
+
+    if( aoints.cAlg == DIRECT ) 
       out << "    * Schwartz Screening Threshold = " 
           << aoints.threshSchwartz << "\n";
+
+    if( aoints.collectERIStats and aoints.cAlg != DENFIT )
+      out << "    * Collecting ERI Screening Statistics\n";
     
 
     out << std::endl << BannerEnd << std::endl;
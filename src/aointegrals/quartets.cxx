@@ -0,0 +1,519 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <aointegrals.hpp>
+#include <aointegrals/quartets.hpp>
+#include <cxxapi/output.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Estimate the magnitude of the 1-e integrals over a shell
+   *  pair from the extent of its primitive overlap distributions.
+   *
+   *  For each primitive pair, the Gaussian product prefactor
+   *
+   *    |c_a c_b| (pi / p)^{3/2} exp(-a b / p |A - B|^2) 
+   *
+   *  is scaled by (1 + p |A - B|^2)^{(L1 + L2) / 2} to account for the 
+   *  polynomial part of the shells. The maximum over primitive pairs is
+   *  returned.
+   *
+   *  \param [in] sh1 Bra shell
+   *  \param [in] sh2 Ket shell
+   *  \returns    Bound on the shell pair overlap distribution
+   */ 
+  double shellPairBound(const libint2::Shell &sh1, 
+    const libint2::Shell &sh2) {
+
+    double AB2 = 0.;
+    for(auto k = 0; k < 3; k++) {
+      double d = sh1.O[k] - sh2.O[k];
+      AB2 += d*d;
+    }
+
+    double LPow = 0.5 * (sh1.contr[0].l + sh2.contr[0].l);
+    double bound = 0.;
+
+    for(auto i = 0; i < sh1.alpha.size(); i++)
+    for(auto j = 0; j < sh2.alpha.size(); j++) {
+
+      double p  = sh1.alpha[i] + sh2.alpha[j];
+      double mu = sh1.alpha[i] * sh2.alpha[j] / p;
+
+      double primBound = 
+        std::abs(sh1.contr[0].coeff[i] * sh2.contr[0].coeff[j]) *
+        std::pow(M_PI / p, 1.5) * std::exp(-mu * AB2) * 
+        std::pow(1. + p * AB2, LPow);
+
+      bound = std::max(bound,primBound);
+
+    }
+
+    return bound;
+
+  }; // shellPairBound
+
+
+  /**
+   *  \brief Upper bound of the Schwartz bound sqrt(max (ab|ab)) of a shell
+   *  pair from its primitive pairs.
+   *
+   *  Each (Cartesian or pure) function of a shell is bounded pointwise by
+   *  a sum of s-type Gaussians, using |x^i y^j z^k| <= r^l and
+   *
+   *    r^l exp(-a r^2) <= (l / (e a))^{l/2} exp(-a r^2 / 2),
+   *
+   *  scaled by the largest absolute row sum of the solid harmonic 
+   *  transformation for pure shells. As the Coulomb kernel is positive,
+   *  (f|f) <= (g|g) for |f| <= g, and the Coulomb norm satisfies the 
+   *  triangle inequality, such that
+   *
+   *    sqrt((ab|ab)) <= sum_{ij} K_i K_j exp(-mu_ij |A - B|^2 / 2)
+   *      (2 pi^{5/2} / (q^2 (2q)^{1/2}))^{1/2},  q = (a_i + b_j) / 2
+   *
+   *  is a rigorous bound for every function pair of the shell pair.
+   *
+   *  \param [in] sh1 Bra shell
+   *  \param [in] sh2 Ket shell
+   *  \returns    Upper bound of the shell pair Schwartz bound
+   */ 
+  double shellPairCoulombBound(const libint2::Shell &sh1, 
+    const libint2::Shell &sh2) {
+
+    double AB2 = 0.;
+    for(auto k = 0; k < 3; k++) {
+      double d = sh1.O[k] - sh2.O[k];
+      AB2 += d*d;
+    }
+
+    // Pointwise prefactors of the primitives
+    auto primFactors = [](const libint2::Shell &sh) {
+
+      const int l = sh.contr[0].l;
+
+      // Largest absolute row sum of the Cartesian -> pure transformation
+      double pureFactor = 1.;
+      if( sh.contr[0].pure and l > 0 ) {
+        const auto &tf = 
+          libint2::solidharmonics::SolidHarmonicsCoefficients<double>::
+          instance(l);
+
+        pureFactor = 0.;
+        for(auto m = 0; m < 2*l+1; m++) {
+          double rowSum = 0.;
+          for(auto c = 0; c < tf.nnz(m); c++) 
+            rowSum += std::abs(tf.row_values(m)[c]);
+          pureFactor = std::max(pureFactor,rowSum);
+        }
+      }
+
+      std::vector<double> K(sh.alpha.size());
+      for(auto i = 0; i < K.size(); i++)
+        K[i] = pureFactor * std::abs(sh.contr[0].coeff[i]) *
+          ((l == 0) ? 1. : std::pow(l / (M_E * sh.alpha[i]), 0.5 * l));
+
+      return K;
+
+    };
+
+    std::vector<double> K1 = primFactors(sh1), K2 = primFactors(sh2);
+
+    double bound = 0.;
+
+    for(auto i = 0; i < sh1.alpha.size(); i++)
+    for(auto j = 0; j < sh2.alpha.size(); j++) {
+
+      double q  = 0.5 * (sh1.alpha[i] + sh2.alpha[j]);
+      double mu = 0.25 * sh1.alpha[i] * sh2.alpha[j] / q;
+
+      bound += K1[i] * K2[j] * std::exp(-mu * AB2) *
+        std::sqrt(2. * std::pow(M_PI,2.5) / (q * q * std::sqrt(2. * q)));
+
+    }
+
+    return bound;
+
+  }; // shellPairCoulombBound
+
+
+  /**
+   *  \brief Determine an expansion center and radial extent for the
+   *  charge distribution of a shell pair.
+   *
+   *  The center is taken to be the Gaussian product center of the most
+   *  diffuse primitive pair. The extent is the largest distance from
+   *  the center at which any primitive pair with a prefactor above the
+   *  threshold decays below the threshold.
+   *
+   *  \param [in]  sh1    Bra shell
+   *  \param [in]  sh2    Ket shell
+   *  \param [in]  thresh Screening threshold
+   *  \param [out] P      Expansion center
+   *  \returns     Radial extent of the distribution about P
+   */ 
+  double shellPairExtent(const libint2::Shell &sh1, 
+    const libint2::Shell &sh2, double thresh, std::array<double,3> &P) {
+
+    auto prodCenter = [&](size_t i, size_t j) -> std::array<double,3> {
+      double a = sh1.alpha[i], b = sh2.alpha[j];
+      return {{ (a * sh1.O[0] + b * sh2.O[0]) / (a + b),
+                (a * sh1.O[1] + b * sh2.O[1]) / (a + b),
+                (a * sh1.O[2] + b * sh2.O[2]) / (a + b) }};
+    };
+
+    // Most diffuse primitive pair
+    size_t iMin = std::min_element(sh1.alpha.begin(),sh1.alpha.end()) - 
+      sh1.alpha.begin();
+    size_t jMin = std::min_element(sh2.alpha.begin(),sh2.alpha.end()) - 
+      sh2.alpha.begin();
+
+    P = prodCenter(iMin,jMin);
+
+    double AB2 = 0.;
+    for(auto k = 0; k < 3; k++) {
+      double d = sh1.O[k] - sh2.O[k];
+      AB2 += d*d;
+    }
+
+    double lnThresh = std::log(thresh);
+    double extent = 0.;
+
+    for(auto i = 0; i < sh1.alpha.size(); i++)
+    for(auto j = 0; j < sh2.alpha.size(); j++) {
+
+      double p  = sh1.alpha[i] + sh2.alpha[j];
+      double mu = sh1.alpha[i] * sh2.alpha[j] / p;
+
+      double lnPre = std::log(std::abs(sh1.contr[0].coeff[i] * 
+        sh2.contr[0].coeff[j]) * std::pow(M_PI / p, 1.5)) - mu * AB2;
+
+      if( lnPre < lnThresh ) continue;
+
+      auto Pij = prodCenter(i,j);
+      double dP = std::sqrt( (Pij[0] - P[0]) * (Pij[0] - P[0]) +
+                             (Pij[1] - P[1]) * (Pij[1] - P[1]) +
+                             (Pij[2] - P[2]) * (Pij[2] - P[2]) );
+
+      extent = std::max(extent, dP + std::sqrt((lnPre - lnThresh) / p));
+
+    }
+
+    return extent;
+
+  }; // shellPairExtent
+
+
+  /**
+   *  \brief Generate the list of unique (s1 >= s2) shell pairs of a 
+   *  shell set which are significant by shellPairBound.
+   *
+   *  Pairs are returned in canonical order.
+   *
+   *  \param [in] shells     Shell set for which to generate the pairs
+   *  \param [in] threshPair Screening threshold (no screening if <= 0)
+   *  \returns    List of significant shell pairs
+   */ 
+  std::vector<ShellPairTask> screenedShellPairs(
+    const std::vector<libint2::Shell> &shells, double threshPair) {
+
+    std::vector<ShellPairTask> pairs;
+    pairs.reserve(shells.size() * (shells.size() + 1) / 2);
+
+    for(size_t s1(0), bf1(0), s12(0); s1 < shells.size(); 
+        bf1 += shells[s1].size(), s1++)
+    for(size_t s2(0), bf2(0); s2 <= s1; 
+        bf2 += shells[s2].size(), s2++, s12++) {
+
+      const libint2::Shell &sh1 = shells[s1];
+      const libint2::Shell &sh2 = shells[s2];
+
+      if( threshPair > 0. and shellPairBound(sh1,sh2) < threshPair ) 
+        continue;
+
+      size_t nPrimPair = sh1.alpha.size() * sh2.alpha.size();
+      int bucket = 0;
+      while( (1ul << (bucket + 1)) <= nPrimPair ) bucket++;
+
+      pairs.push_back({ s1, s2, bf1, bf2, sh1.size(), sh2.size(), s12, 
+        sh1.contr[0].l, sh2.contr[0].l, bucket });
+
+    }
+
+    return pairs;
+
+  }; // screenedShellPairs
+
+
+  /**
+   *  \brief Generate the list of unique (s1 >= s2) shell pairs sorted
+   *  by integral class.
+   *
+   *  Pairs are sorted by the angular momenta of the two shells and
+   *  then by the (log2) primitive depth of the pair, such that looping 
+   *  over bra and ket pairs in this order evaluates shell quartets of 
+   *  the same class contiguously. Within a class, the canonical pair
+   *  ordering is retained.
+   *
+   *  The 8-fold unique quartets (s1 s2 | s3 s4) are those with 
+   *  ket.pairIndex <= bra.pairIndex.
+   *
+   *  \param [in] basis      BasisSet for which to generate the pairs
+   *  \param [in] threshPair Overlap screening threshold for the pairs
+   *                         (see screenedShellPairs)
+   *  \returns    Class sorted list of shell pairs
+   */ 
+  std::vector<ShellPairTask> classSortedShellPairs(const BasisSet &basis,
+    double threshPair) {
+
+    std::vector<ShellPairTask> pairs = 
+      screenedShellPairs(basis.shells,threshPair);
+
+    std::stable_sort(pairs.begin(),pairs.end(),
+      [](const ShellPairTask &a, const ShellPairTask &b) {
+        return std::make_tuple(a.L1,a.L2,a.primBucket) < 
+               std::make_tuple(b.L1,b.L2,b.primBucket);
+      }
+    );
+
+    return pairs;
+
+  }; // classSortedShellPairs
+
+
+  /**
+   *  \brief Print the per-class integral statistics, sorted by the
+   *  time spent in each class.
+   *
+   *  \param [in] out   Output device
+   *  \param [in] title Title for the report
+   */ 
+  void QuartetClassStats::print(std::ostream &out, 
+    const std::string &title) const {
+
+    const char LLabel[] = "spdfghiklmnoqrtuvwxyz";
+
+    std::vector<std::pair<class_t,std::pair<size_t,double>>> 
+      sorted(stats.begin(),stats.end());
+
+    std::sort(sorted.begin(),sorted.end(),
+      [](const std::pair<class_t,std::pair<size_t,double>> &a,
+         const std::pair<class_t,std::pair<size_t,double>> &b) {
+        return a.second.second > b.second.second;
+      }
+    );
+
+    double totTime  = 0.;
+    size_t totCount = 0;
+    for(auto &st : sorted) {
+      totCount += st.second.first;
+      totTime  += st.second.second;
+    }
+
+    out << std::endl << "  " << title << ":" << std::endl 
+        << bannerMid << std::endl;
+
+    out << "    " << std::left  << std::setw(10) << "Class"
+                  << std::right << std::setw(14) << "Count"
+                  << std::setw(16) << "Time (s)"
+                  << std::setw(10) << "% Time" 
+                  << std::setw(16) << "Time / Quartet" << std::endl;
+
+    for(auto &st : sorted) {
+
+      std::string cls = std::string("(") + 
+        LLabel[st.first[0]] + LLabel[st.first[1]] + "|" + 
+        LLabel[st.first[2]] + LLabel[st.first[3]] + ")";
+
+      out << "    " << std::left  << std::setw(10) << cls
+          << std::right << std::setw(14) << st.second.first
+          << std::setw(16) << std::scientific << std::setprecision(4) 
+          << st.second.second
+          << std::setw(10) << std::fixed << std::setprecision(2) 
+          << 100. * st.second.second / std::max(totTime,1e-16)
+          << std::setw(16) << std::scientific << std::setprecision(4)
+          << st.second.second / std::max(st.second.first,size_t(1))
+          << std::endl;
+
+    }
+
+    out << "    " << std::left << std::setw(10) << "Total"
+        << std::right << std::setw(14) << totCount 
+        << std::setw(16) << std::scientific << std::setprecision(4) 
+        << totTime << std::endl;
+
+    out << bannerEnd << std::endl << std::fixed;
+
+  }; // QuartetClassStats::print
+
+
+
+  /**
+   *  \brief Return the class sorted list of shell pairs of the CGTO
+   *  basis which survive the overlap extent screening (threshOneE).
+   *
+   *  The list is generated on first use and shared by the 1-e and
+   *  2-e integral engines.
+   */ 
+  const std::vector<ShellPairTask>& AOIntegrals::significantShellPairs() {
+
+    if( sigShellPairs_.empty() )
+      sigShellPairs_ = classSortedShellPairs(basisSet_,threshOneE);
+
+    return sigShellPairs_;
+
+  }; // AOIntegrals::significantShellPairs
+
+
+
+  /**
+   *  \brief Report the ERI screening statistics collected in a direct
+   *  contraction or in the evaluation of the in-core ERIs.
+   *
+   *  Merges the thread local statistics and writes them to the
+   *  checkpoint file (INTS/ERI_STATS/CALL_N) if it exists, else a
+   *  summary is printed. Also estimates the number of surviving quartets
+   *  at alternative Schwartz thresholds from the bound histogram (at the
+   *  resolution of the histogram). The survivors per angular momentum
+   *  class are not available for the batched direct contraction.
+   *
+   *  \param [in] stats Thread local ERI screening statistics
+   */ 
+  void AOIntegrals::reportERIScreenStats(std::vector<ERIScreenStats> &stats) {
+
+    if( stats.empty() ) return;
+
+    nERIStatsCall++;
+
+    const size_t nThreads = stats.size();
+    const size_t NBIN     = ERIScreenStats::NBIN;
+    const int    MIN_EXP  = ERIScreenStats::MIN_EXP;
+
+    // Per-thread work
+    std::vector<double> thrQuartets, thrTime;
+    for(auto &st : stats) {
+      thrQuartets.emplace_back(st.nEval);
+      thrTime.emplace_back(st.time);
+    }
+
+    // Merge the thread local statistics
+    ERIScreenStats total;
+    for(auto &st : stats) total += st;
+
+    double nTotal = total.nSchwartz + total.nLibint + total.nEval;
+
+    // Histogram and bin edges
+    std::vector<double> hist, edges;
+    for(auto i = 0; i < NBIN; i++) {
+      hist.emplace_back(total.boundHist[i]);
+      edges.emplace_back(i + MIN_EXP);
+    }
+
+    // Estimated survivors (bound >= thresh) at alternative thresholds
+    std::vector<double> threshScan;
+    for(int t = -16; t <= -6; t++) {
+
+      double nSurv = 0.;
+      for(auto i = 0; i < NBIN; i++)
+        if( static_cast<int>(i) + MIN_EXP >= t ) nSurv += hist[i];
+
+      threshScan.emplace_back(std::pow(10.,t));
+      threshScan.emplace_back(nSurv);
+
+    }
+    size_t nScan = threshScan.size() / 2;
+
+    // Survivors per class
+    std::vector<double> classSurv;
+    for(auto &cl : total.classSurvivors) {
+      for(auto &L : cl.first) classSurv.emplace_back(L);
+      classSurv.emplace_back(cl.second);
+    }
+    size_t nClass = total.classSurvivors.size();
+
+    if( savFile.exists() ) {
+
+      std::string prefix = 
+        "INTS/ERI_STATS/CALL_" + std::to_string(nERIStatsCall) + "/";
+
+      double nSchwartz = total.nSchwartz;
+      double nLibint   = total.nLibint;
+      double nEval     = total.nEval;
+
+      savFile.safeWriteData(prefix + "THRESH_SCHWARTZ",&threshSchwartz,{1});
+      savFile.safeWriteData(prefix + "NSKIP_SCHWARTZ",&nSchwartz,{1});
+      savFile.safeWriteData(prefix + "NSKIP_LIBINT",&nLibint,{1});
+      savFile.safeWriteData(prefix + "NEVAL",&nEval,{1});
+
+      savFile.safeWriteData(prefix + "BOUND_HIST",&hist[0],{NBIN});
+      savFile.safeWriteData(prefix + "BOUND_HIST_LOG10_EDGES",&edges[0],
+        {NBIN});
+
+      savFile.safeWriteData(prefix + "THREAD_QUARTETS",&thrQuartets[0],
+        {nThreads});
+      savFile.safeWriteData(prefix + "THREAD_TIME",&thrTime[0],{nThreads});
+
+      savFile.safeWriteData(prefix + "THRESH_SCAN",&threshScan[0],
+        {nScan,2});
+
+      if( nClass )
+        savFile.safeWriteData(prefix + "CLASS_SURVIVORS",&classSurv[0],
+          {nClass,5});
+
+    } else {
+
+      std::cout << std::endl << "  ERI Screening Statistics (Contraction " 
+                << nERIStatsCall << "):" << std::endl << bannerMid 
+                << std::endl;
+
+      std::cout << std::scientific << std::setprecision(4) << std::left;
+
+      std::cout << "    " << std::setw(32) << "Total Quartets" 
+                << size_t(nTotal) << std::endl;
+      std::cout << "    " << std::setw(32) << "Skipped (Schwartz)" 
+                << total.nSchwartz << std::endl;
+      std::cout << "    " << std::setw(32) << "Skipped (Libint2)" 
+                << total.nLibint << std::endl;
+      std::cout << "    " << std::setw(32) << "Evaluated" 
+                << total.nEval << std::endl;
+
+      std::cout << std::endl << "    Estimated Survivors by Threshold:" 
+                << std::endl;
+      for(auto i = 0; i < nScan; i++)
+        std::cout << "      " << std::setw(14) << threshScan[2*i] 
+                  << size_t(threshScan[2*i+1]) << std::endl;
+
+      std::cout << std::endl << "    Per-Thread Work (Quartets / Time):" 
+                << std::endl;
+      for(auto i = 0; i < nThreads; i++)
+        std::cout << "      " << std::setw(6) << i << std::setw(14) 
+                  << size_t(thrQuartets[i]) << thrTime[i] << " s" 
+                  << std::endl;
+
+      std::cout << bannerEnd << std::endl << std::fixed;
+
+    }
+
+  }; // AOIntegrals::reportERIScreenStats
+
+}; // namespace ChronusQ
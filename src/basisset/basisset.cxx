@@ -41,6 +41,7 @@ namespace ChronusQ {
     {  "4-31G"          , "4-31g.gbs"                     },
     {  "6-31G"          , "6-31g.gbs"                     },
     {  "6-31G(D)"       , "6-31g*.gbs"                    },
+    {  "6-31G(D)-GC"    , "6-31g*_gc.gbs"                 },
     {  "6-31++G(D)"     , "6-31++g*.gbs"                  },
     {  "6-311G"         , "6-311g.gbs"                    },
     {  "6-311+G(D)"     , "6-311+g*.gbs"                  },
@@ -119,14 +120,15 @@ namespace ChronusQ {
 
     // Possibly find appropriate basis file for keyword
     if( basisKeyword.find(uppercase) != basisKeyword.end() )
-      basisName = basisKeyword[basisName];
+      basisName = basisKeyword[uppercase];
 
-    // Generate the reference basis set of that keyword
-    ReferenceBasisSet ref(basisName, _forceCart, doPrint);
+    // Obtain the reference basis set of that keyword (only digested
+    // the first time it is requested)
+    auto ref = ReferenceBasisSet::fetch(basisName, _forceCart, doPrint);
 
     // Update appropriate shell set and coefficients for the Molecule
     // object
-    std::tie(shells,unNormCont) = std::move(ref.generateShellSet(mol));
+    std::tie(shells,unNormCont) = std::move(ref->generateShellSet(mol));
 
     // Obtain a copy of the basis centers
     std::for_each(mol.atoms.begin(),mol.atoms.end(),
@@ -135,6 +137,10 @@ namespace ChronusQ {
 
     // Update the BasisSt member data
     update();
+
+    // Internal ordering is the input ordering until reordered
+    mapBf2Orig.resize(nBasis);
+    std::iota(mapBf2Orig.begin(),mapBf2Orig.end(),0);
     
   }; // BasisSet::BasisSet 
 
@@ -179,6 +185,7 @@ namespace ChronusQ {
     mapSh2Cen.clear();
     mapSh2Bf.clear();
     mapCen2BfSt.clear();
+    mapCen2BfEnd.clear();
 
     // Create basis maps
     // Maps Sh # -> BF #
@@ -211,8 +218,26 @@ namespace ChronusQ {
       size_t firstShell = std::distance(mapSh2Cen.begin(),it);
       mapCen2BfSt.emplace_back(mapSh2Bf[firstShell]);
 
+      // Shells on a center are contiguous
+      size_t lastShell = std::distance(mapSh2Cen.rbegin(),
+        std::find_if(mapSh2Cen.rbegin(),mapSh2Cen.rend(),
+          [&](size_t x){ return x == iAtm; }));
+      lastShell = nShell - 1 - lastShell;
+      mapCen2BfEnd.emplace_back(mapSh2Bf[lastShell] + shells[lastShell].size());
+
     }
 
+
+    // Maps Sh # -> Contraction family #
+    mapSh2Fam.clear();
+    for(auto iSh = 0; iSh < nShell; iSh++) {
+      bool newFam = iSh == 0 or mapSh2Cen[iSh] != mapSh2Cen[iSh-1] or
+        shells[iSh].alpha != shells[iSh-1].alpha;
+      mapSh2Fam.emplace_back( newFam ? (iSh ? mapSh2Fam.back() + 1 : 0) : 
+                                       mapSh2Fam.back() );
+    }
+    nFamily = nShell ? mapSh2Fam.back() + 1 : 0;
+
   }; // BasisSet::update
 
 
@@ -241,6 +266,10 @@ namespace ChronusQ {
     out << "  " << std::setw(25) << "Max Primitive" << basis.maxPrim 
         << std::endl;
     out << "  " << std::setw(25) << "Max L" << basis.maxL << std::endl;
+    out << "  " << std::setw(25) << "NContraction Families" 
+        << basis.nFamily << std::endl;
+    out << "  " << std::setw(25) << "Shell Ordering" 
+        << (basis.reordered ? "Spatial (Hilbert)" : "Input") << std::endl;
 
     out << std::endl << std::endl;
 
@@ -253,11 +282,20 @@ namespace ChronusQ {
     out << std::setw(30) << std::right << "Normalized Contraction";
   //out << std::setw(30) << std::right << "Unnormalized Contraction";
     out << std::endl << std::endl;
+
+    // Always print the shells in the original (input) ordering
+    std::vector<size_t> shOut(basis.nShell);
+    std::iota(shOut.begin(),shOut.end(),0);
+    std::sort(shOut.begin(),shOut.end(),[&](size_t i, size_t j) {
+      return basis.mapBf2Orig[basis.mapSh2Bf[i]] < 
+             basis.mapBf2Orig[basis.mapSh2Bf[j]];
+    });
     
-    for(auto iShell = 0; iShell < basis.nShell; iShell++){
+    for(auto iOut = 0; iOut < basis.nShell; iOut++){
+      size_t iShell = shOut[iOut];
       out << "  " << "  " << std::left << std::setprecision(4) 
           << std::scientific;
-      out << std::setw(5) << iShell ;
+      out << std::setw(5) << iOut ;
       out << std::setw(5) << basis.shells[iShell].contr[0].l << std::right;
       out << std::setw(15) << basis.shells[iShell].alpha[0];
       out << std::setw(30) << basis.shells[iShell].contr[0].coeff[0];
@@ -281,6 +319,144 @@ namespace ChronusQ {
   }; // BasisSet::operator<<
 
 
+  /**
+   *  \brief Compute the index of a point along a 3D Hilbert curve
+   *
+   *  Uses the transpose representation of J. Skilling, AIP Conf. Proc.
+   *  707, 381 (2004).
+   *
+   *  \param [in] X    Integer coordinates (each < 2^bits)
+   *  \param [in] bits Number of bits per coordinate
+   *  \returns         Index along the Hilbert curve
+   */ 
+  static uint64_t hilbertIndex(std::array<uint32_t,3> X, int bits) {
+
+    uint32_t M = 1u << (bits - 1), P, Q, t;
+
+    // Inverse undo
+    for(Q = M; Q > 1; Q >>= 1) {
+      P = Q - 1;
+      for(auto i = 0; i < 3; i++)
+        if( X[i] & Q ) X[0] ^= P; // invert
+        else {                    // exchange
+          t = (X[0] ^ X[i]) & P;
+          X[0] ^= t; X[i] ^= t;
+        }
+    }
+
+    // Gray encode
+    for(auto i = 1; i < 3; i++) X[i] ^= X[i-1];
+    t = 0;
+    for(Q = M; Q > 1; Q >>= 1) if( X[2] & Q ) t ^= Q - 1;
+    for(auto i = 0; i < 3; i++) X[i] ^= t;
+
+    // Interleave the transposed bits
+    uint64_t h = 0;
+    for(auto b = bits - 1; b >= 0; b--)
+    for(auto i = 0; i < 3; i++)
+      h = (h << 1) | ((X[i] >> b) & 1);
+
+    return h;
+
+  }; // hilbertIndex
+
+
+  /**
+   *  \brief Reorder the shells for spatial locality.
+   *
+   *  Atomic centers are ordered along a 3D Hilbert curve through the
+   *  bounding box of the centers, and the shells on each center are 
+   *  ordered by angular momentum. Shells on a particular center remain
+   *  contiguous, such that mapCen2BfSt / mapCen2BfEnd remain valid.
+   *
+   *  The permutation relative to the original (input) ordering is 
+   *  stored in mapBf2Orig (see toOriginalOrder / toInternalOrder).
+   */ 
+  void BasisSet::reorderShells() {
+
+    const int nBits = 16;
+
+    // Bounding box of the centers
+    cart_t lo = centers[0], hi = centers[0];
+    for(auto &cen : centers)
+    for(auto x = 0; x < 3; x++) {
+      lo[x] = std::min(lo[x],cen[x]);
+      hi[x] = std::max(hi[x],cen[x]);
+    }
+
+    double ext = 0.;
+    for(auto x = 0; x < 3; x++) ext = std::max(ext,hi[x] - lo[x]);
+    double fact = (ext > 1e-10) ? ((1u << nBits) - 1) / ext : 0.;
+
+    // Hilbert index for each center
+    std::vector<uint64_t> cenKey;
+    for(auto &cen : centers) {
+      std::array<uint32_t,3> X;
+      for(auto x = 0; x < 3; x++)
+        X[x] = static_cast<uint32_t>(std::round((cen[x] - lo[x]) * fact));
+      cenKey.emplace_back(hilbertIndex(X,nBits));
+    }
+
+    // Sort shells by (Hilbert index, center, L)
+    std::vector<size_t> shOrder(nShell);
+    std::iota(shOrder.begin(),shOrder.end(),0);
+    std::stable_sort(shOrder.begin(),shOrder.end(),
+      [&](size_t i, size_t j) {
+        size_t ci = mapSh2Cen[i], cj = mapSh2Cen[j];
+        return std::make_tuple(cenKey[ci],ci,shells[i].contr[0].l) <
+               std::make_tuple(cenKey[cj],cj,shells[j].contr[0].l);
+      }
+    );
+
+    // Starting BF of each shell in the original ordering
+    std::vector<size_t> origSh2Bf;
+    for(auto iSh = 0; iSh < nShell; iSh++)
+      origSh2Bf.emplace_back(mapBf2Orig[mapSh2Bf[iSh]]);
+
+    // Permute the shells
+    std::vector<libint2::Shell> newShells;
+    std::vector<std::vector<double>> newCont;
+    for(auto &iSh : shOrder) {
+      newShells.emplace_back(shells[iSh]);
+      newCont.emplace_back(unNormCont[iSh]);
+    }
+
+    shells     = std::move(newShells);
+    unNormCont = std::move(newCont);
+
+    update();
+
+    // Update the permutation
+    for(auto iSh = 0; iSh < nShell; iSh++)
+    for(auto k = 0; k < shells[iSh].size(); k++)
+      mapBf2Orig[mapSh2Bf[iSh] + k] = origSh2Bf[shOrder[iSh]] + k;
+
+    reordered = true;
+
+  }; // BasisSet::reorderShells
+
+
+  /**
+   *  Moves the basis centers (and the shells on them) onto the nuclear
+   *  positions of a Molecule with the same atoms (e.g. a displaced
+   *  geometry). The shell ordering and all basis maps are preserved.
+   *
+   *  \param [in] mol  Molecule at the new geometry
+   */
+  void BasisSet::updateCenters(const Molecule &mol) {
+
+    if( mol.atoms.size() != centers.size() )
+      CErr("Number of atoms does not match the number of basis centers");
+
+    for(auto iCen = 0; iCen < centers.size(); iCen++)
+      centers[iCen] = mol.atoms[iCen].coord;
+
+    for(auto iSh = 0; iSh < nShell; iSh++)
+      shells[iSh].O = centers[mapSh2Cen[iSh]];
+
+  }; // BasisSet::updateCenters
+
+
   /**
    *  \brief Return the uncontracted shell set of the current
    *  contracted shell set
@@ -57,13 +57,14 @@ namespace ChronusQ {
       } // loop over shells
     } // loop over points
 
+    // Each shell is its own center (and contraction family)
     std::vector<size_t> mapSh2Cen(nShSize); 
     std::iota(mapSh2Cen.begin(),mapSh2Cen.end(),0);
 
     std::vector<bool> evalShell(nShSize,true);
     // Call to Level 2 Basis Set Evaluation
     evalShellSet(typ,shells,evalShell,rSq,r,npts,nShSize,mapSh2Cen,
-      NBasisEff,fEval,SCR_Car,shSizeCar,forceCart); 
+      mapSh2Cen,NBasisEff,fEval,SCR_Car,shSizeCar,forceCart); 
     memManager.free(r,rSq,SCR_Car);
 
   }; // evalShellSet Level 1
@@ -83,6 +84,9 @@ namespace ChronusQ {
    *  \param [in] nCenter    Number of total distint shell center (is NAtoms).
    *  \param [in] NBasisEff  Number of basis function to be evaluated given all the shells in input.
    *  \param [in] mapSh2Cen  Shell Mapping to atom centers.
+   *  \param [in] mapSh2Fam  Shell Mapping to (general) contraction families
+   *                         (see BasisSet::mapSh2Fam). Shells of a family 
+   *                         share the primitive exponentials.
    *  \param [in/out] fEval  eval Storage for the shell set evaluation, f(ixyz,iSh,ipt). 
    *                         Variable dimensions(npts*NBasisEff*1 or 4) allocated outside.
    *                         This storage will have all values of the functions in the shell, 
@@ -95,7 +99,8 @@ namespace ChronusQ {
    */ 
   void evalShellSet(SHELL_EVAL_TYPE typ, std::vector<libint2::Shell> &shells, 
     std::vector<bool> &evalShell, double* rSq, double *r, size_t npts, size_t nCenter, 
-    std::vector<size_t> &mapSh2Cen, size_t NBasisEff, double *fEval, double *SCR, size_t IOffSCR, bool forceCart) {
+    std::vector<size_t> &mapSh2Cen, std::vector<size_t> &mapSh2Fam, size_t NBasisEff, double *fEval, 
+    double *SCR, size_t IOffSCR, bool forceCart) {
 
     assert(shells.size() == evalShell.size());
 
@@ -103,8 +108,17 @@ namespace ChronusQ {
     size_t IOff =  npts*NBasisEff;
     std::array<double,3> rVal;
 
+    assert(mapSh2Fam.size() == nShSize);
+
+    size_t maxPrim = 0;
+    for (auto iSh = 0ul; iSh < nShSize; iSh++)
+      maxPrim = std::max(maxPrim,shells[iSh].alpha.size());
+
+    std::vector<double> expArg(maxPrim);
+
     for (auto ipts = 0ul; ipts < npts; ipts++){
       size_t Ic = 0;
+      size_t curFam = std::numeric_limits<size_t>::max(); // Family of the cached exponentials
     for (auto iSh = 0ul; iSh < nShSize; iSh++){
       if(evalShell[iSh]) {
         double * fStart    = fEval + Ic + ipts*NBasisEff;
@@ -113,8 +127,14 @@ namespace ChronusQ {
         rVal [1]= r[1 + mapSh2Cen[iSh]*3 + ipts*3*nCenter];
         rVal [2]= r[2 + mapSh2Cen[iSh]*3 + ipts*3*nCenter];
 
-        evalShellSet(typ,shells[iSh],rSq[mapSh2Cen[iSh] + ipts*nCenter],
-          rVal,SCR,IOffSCR); 
+        if( mapSh2Fam[iSh] != curFam ) {
+          double rSqVal = rSq[mapSh2Cen[iSh] + ipts*nCenter];
+          for(auto k = 0; k < shells[iSh].alpha.size(); k++)
+            expArg[k] = std::exp(-shells[iSh].alpha[k]*rSqVal);
+          curFam = mapSh2Fam[iSh];
+        }
+
+        evalShellSet(typ,shells[iSh],&expArg[0],rVal,SCR,IOffSCR); 
 
         CarToSpDEval(typ, shells[iSh].contr[0].l, SCR, fStart, IOff, IOffSCR, forceCart);
 
@@ -147,6 +167,28 @@ namespace ChronusQ {
    */ 
   void evalShellSet(SHELL_EVAL_TYPE typ, const libint2::Shell &shell,double rSq, const std::array<double,3> &xyz, 
     double *SCR, size_t IOffSCR) {
+
+    std::vector<double> expArg(shell.alpha.size());
+    for(auto k = 0; k < shell.alpha.size(); k++)
+      expArg[k] = std::exp(-shell.alpha[k]*rSq);
+
+    evalShellSet(typ,shell,&expArg[0],xyz,SCR,IOffSCR);
+
+  }; // evalShellSet Level3
+
+
+  /**
+   *   \brief Level 3 Basis Set Evaluation Function over precomputed
+   *   primitive exponentials.
+   *
+   *   Same as above, with the primitive exponentials exp(-alpha_k r**2)
+   *   supplied by the caller such that they may be shared between the
+   *   contractions of a generally contracted shell.
+   *
+   *   \param [in] expArg exp(-alpha_k r**2) for each primitive of shell
+   */ 
+  void evalShellSet(SHELL_EVAL_TYPE typ, const libint2::Shell &shell, const double *expArg, 
+    const std::array<double,3> &xyz, double *SCR, size_t IOffSCR) {
     auto L         = shell.contr[0].l;
     auto shSize    = ((L+1)*(L+2))/2; 
     auto shSize_car   = ((L+1)*(L+2))/2; 
@@ -157,7 +199,6 @@ namespace ChronusQ {
     auto contDepth = shell.alpha.size(); 
     double alpha(0.0);
     double expFactor(0.0);
-    double expArg(0);
     double tmpcoef,tmpalpha;
     int lx,ly,lz, ixyz;
     double tmpxyz;
@@ -170,12 +211,11 @@ namespace ChronusQ {
     for(auto k = 0; k < contDepth; k++){
       tmpcoef = shell.contr[0].coeff[k];
       tmpalpha = shell.alpha[k];
-      expArg = std::exp(-tmpalpha*rSq);
-      expFactor += tmpcoef * expArg;
+      expFactor += tmpcoef * expArg[k];
       if (typ == GRADIENT) { 
         // quantities for derivatives
         tmpcoef *= tmpalpha;
-        alpha += tmpcoef * expArg;
+        alpha += tmpcoef * expArg[k];
       }
     } 
 
@@ -0,0 +1,370 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <basisset/cube.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <util/threads.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Construct a CubeGrid which encloses a Molecule.
+   *
+   *  \param [in] mol      Molecule to enclose
+   *  \param [in] spacing  Grid spacing (Bohr)
+   *  \param [in] padding  Distance between the outermost nuclei and the 
+   *                       edges of the grid (Bohr)
+   */ 
+  CubeGrid MoleculeCubeGrid(const Molecule &mol, double spacing, 
+    double padding) {
+
+    CubeGrid grid;
+
+    cart_t minXYZ = mol.atoms[0].coord, maxXYZ = mol.atoms[0].coord;
+    for(auto &atom : mol.atoms)
+    for(auto k = 0; k < 3; k++) {
+      minXYZ[k] = std::min(minXYZ[k],atom.coord[k]);
+      maxXYZ[k] = std::max(maxXYZ[k],atom.coord[k]);
+    }
+
+    for(auto k = 0; k < 3; k++) {
+      grid.origin[k] = minXYZ[k] - padding;
+      grid.nPts[k]   = 
+        std::ceil((maxXYZ[k] - minXYZ[k] + 2*padding) / spacing) + 1;
+
+      grid.axes[k] = {0., 0., 0.};
+      grid.axes[k][k] = spacing;
+    }
+
+    return grid;
+
+  }; // MoleculeCubeGrid
+
+
+  CubeWriter::CubeWriter(CQMemManager &mem, const Molecule &mol, 
+    BasisSet &basis, const CubeGrid &grid) : memManager_(mem),
+    molecule_(mol), basisSet_(basis), grid_(grid) { }
+
+
+  /**
+   *  \brief Write the cube file header. A non-empty moIdx 
+   *  (0-based) flags an orbital cube.
+   */ 
+  void CubeWriter::writeHeader(std::ostream &out, const std::string &comment,
+    const std::vector<size_t> &moIdx) {
+
+    out << comment << "\n";
+    out << "Generated by ChronusQ\n";
+
+    out << std::fixed << std::setprecision(6);
+
+    int nAtoms = molecule_.nAtoms;
+    out << std::setw(5) << (moIdx.empty() ? nAtoms : -nAtoms);
+    for(auto k = 0; k < 3; k++) out << std::setw(12) << grid_.origin[k];
+    out << "\n";
+
+    for(auto iAx = 0; iAx < 3; iAx++) {
+      out << std::setw(5) << grid_.nPts[iAx];
+      for(auto k = 0; k < 3; k++) out << std::setw(12) << grid_.axes[iAx][k];
+      out << "\n";
+    }
+
+    for(auto &atom : molecule_.atoms) {
+      out << std::setw(5) << atom.atomicNumber 
+          << std::setw(12) << double(atom.atomicNumber);
+      for(auto k = 0; k < 3; k++) out << std::setw(12) << atom.coord[k];
+      out << "\n";
+    }
+
+    if( not moIdx.empty() ) {
+      out << std::setw(5) << moIdx.size();
+      for(auto &i : moIdx) out << std::setw(5) << i + 1;
+      out << "\n";
+    }
+
+  }; // CubeWriter::writeHeader
+
+
+  /**
+   *  \brief Evaluate a set of fields over the grid and stream them to
+   *  disk.
+   *
+   *  func(thread_id, NBE, NPts, BasisEval, evalBf, FIELD) populates
+   *  FIELD (nField x NPts) given the NBE x NPts values of the basis 
+   *  functions listed in evalBf.
+   */ 
+  template <typename F>
+  void CubeWriter::writeFields(const std::string &fName, 
+    const std::string &comment, const std::vector<size_t> &moIdx, 
+    size_t nField, const F &func) {
+
+    std::ofstream out(fName);
+    if( not out.good() ) CErr("Unable to open " + fName);
+
+    writeHeader(out,comment,moIdx);
+
+    size_t NY    = grid_.nPts[1];
+    size_t NZ    = grid_.nPts[2];
+    size_t NLine = grid_.nPts[0] * NY;
+    size_t NB    = basisSet_.nBasis;
+    size_t nCen  = basisSet_.centers.size();
+
+    size_t nBlocks  = (NLine + nLinesBlock - 1) / nLinesBlock;
+    size_t nthreads = GetNumThreads();
+    size_t maxPts   = nLinesBlock * NZ;
+
+    // Shell extents, Eq. 20 in J. Chem. Theory Comput. 2011, 7, 3097
+    auto cutFunc = [&](double alpha) -> double {
+      return std::sqrt((-std::log(epsScreen) + 0.5 * std::log(alpha))/alpha);
+    };
+
+    mapSh2Cut_.clear();
+    for(auto &shell : basisSet_.shells) {
+      double cut = 0.;
+      for(auto &alpha : shell.alpha) cut = std::max(cut,cutFunc(alpha));
+      mapSh2Cut_.emplace_back(cut);
+    }
+
+    size_t shSizeCar = ((basisSet_.maxL+1)*(basisSet_.maxL+2))/2;
+
+    double *BasisEval = memManager_.malloc<double>(nthreads*NB*maxPts);
+    double *FIELD     = memManager_.malloc<double>(nthreads*nField*maxPts);
+    double *rSq       = memManager_.malloc<double>(nthreads*nCen*maxPts);
+    double *rXYZ      = memManager_.malloc<double>(nthreads*3*nCen*maxPts);
+    double *SCR_Car   = memManager_.malloc<double>(nthreads*shSizeCar);
+
+    size_t nChunk = 4 * nthreads;
+    for(size_t chunkSt = 0; chunkSt < nBlocks; chunkSt += nChunk) {
+
+      size_t chunkEnd = std::min(nBlocks,chunkSt + nChunk);
+      std::vector<std::string> text(chunkEnd - chunkSt);
+
+      #pragma omp parallel for schedule(dynamic)
+      for(size_t iBlk = chunkSt; iBlk < chunkEnd; iBlk++) {
+
+        size_t thread_id = GetThreadID();
+
+        double *BasisEval_loc = BasisEval + thread_id * NB*maxPts;
+        double *FIELD_loc     = FIELD     + thread_id * nField*maxPts;
+        double *rSq_loc       = rSq       + thread_id * nCen*maxPts;
+        double *rXYZ_loc      = rXYZ      + thread_id * 3*nCen*maxPts;
+        double *SCR_Car_loc   = SCR_Car   + thread_id * shSizeCar;
+
+        size_t lineSt  = iBlk * nLinesBlock;
+        size_t lineEnd = std::min(NLine, lineSt + nLinesBlock);
+        size_t NPts    = (lineEnd - lineSt) * NZ;
+
+        // Point -> center distances and the bounding box of the block
+        cart_t boxMin, boxMax;
+        boxMin.fill(std::numeric_limits<double>::max());
+        boxMax.fill(std::numeric_limits<double>::lowest());
+
+        for(size_t iLine = lineSt, iPt = 0; iLine < lineEnd; iLine++)
+        for(size_t iz = 0; iz < NZ; iz++, iPt++) {
+
+          size_t ix = iLine / NY;
+          size_t iy = iLine % NY;
+
+          cart_t pt;
+          for(auto k = 0; k < 3; k++) {
+            pt[k] = grid_.origin[k] + ix * grid_.axes[0][k] + 
+              iy * grid_.axes[1][k] + iz * grid_.axes[2][k];
+
+            boxMin[k] = std::min(boxMin[k],pt[k]);
+            boxMax[k] = std::max(boxMax[k],pt[k]);
+          }
+
+          for(size_t iCen = 0; iCen < nCen; iCen++) {
+            double *r = rXYZ_loc + 3*iCen + 3*iPt*nCen;
+            for(auto k = 0; k < 3; k++)
+              r[k] = pt[k] - basisSet_.centers[iCen][k];
+
+            rSq_loc[iCen + iPt*nCen] = r[0]*r[0] + r[1]*r[1] + r[2]*r[2];
+          }
+
+        }
+
+        // Screen the shells on the distance from their center to the
+        // bounding box of the block
+        std::vector<double> boxDist(nCen);
+        for(size_t iCen = 0; iCen < nCen; iCen++) {
+          double dSq = 0.;
+          for(auto k = 0; k < 3; k++) {
+            double c = basisSet_.centers[iCen][k];
+            double d = std::max(0., std::max(boxMin[k] - c, c - boxMax[k]));
+            dSq += d*d;
+          }
+          boxDist[iCen] = std::sqrt(dSq);
+        }
+
+        std::vector<bool>   evalShell(basisSet_.nShell);
+        std::vector<size_t> evalBf;
+        for(size_t iSh = 0; iSh < basisSet_.nShell; iSh++) {
+          evalShell[iSh] = 
+            boxDist[basisSet_.mapSh2Cen[iSh]] < mapSh2Cut_[iSh];
+
+          if( evalShell[iSh] )
+            for(size_t i = 0; i < basisSet_.shells[iSh].size(); i++)
+              evalBf.emplace_back(basisSet_.mapSh2Bf[iSh] + i);
+        }
+
+        size_t NBE = evalBf.size();
+
+        if( NBE == 0 ) std::fill_n(FIELD_loc,nField*NPts,0.);
+        else {
+
+          evalShellSet(NOGRAD,basisSet_.shells,evalShell,rSq_loc,rXYZ_loc,
+            NPts,nCen,basisSet_.mapSh2Cen,basisSet_.mapSh2Fam,NBE,
+            BasisEval_loc,SCR_Car_loc,shSizeCar,basisSet_.forceCart);
+
+          func(thread_id,NBE,NPts,BasisEval_loc,evalBf,FIELD_loc);
+
+        }
+
+        // Format the block: 6 values / line, new line for each (x,y)
+        std::ostringstream ss;
+        ss << std::scientific << std::setprecision(5);
+
+        size_t nPerLine = NZ * nField;
+        for(size_t iLine = 0; iLine < (lineEnd - lineSt); iLine++) {
+          for(size_t i = 0; i < nPerLine; i++) {
+            ss << std::setw(13) << FIELD_loc[iLine*nPerLine + i];
+            if( i % 6 == 5 or i == nPerLine - 1 ) ss << "\n";
+          }
+        }
+
+        text[iBlk - chunkSt] = ss.str();
+
+      } // loop over blocks
+
+      for(auto &X : text) out << X;
+
+    } // loop over chunks
+
+    memManager_.free(BasisEval,FIELD,rSq,rXYZ,SCR_Car);
+
+  }; // CubeWriter::writeFields
+
+
+  /**
+   *  \brief Write rho(r) = sum_{mn} phi_m(r) D_mn phi_n(r) for a real,
+   *  symmetric density matrix (e.g. the scalar or spin density).
+   *
+   *  \param [in] fName    Cube file name
+   *  \param [in] comment  Title line of the cube file
+   *  \param [in] D        Density matrix (NB x NB)
+   *  \param [in] LDD      Leading dimension of D
+   */ 
+  void CubeWriter::writeDensity(const std::string &fName, 
+    const std::string &comment, const double *D, size_t LDD) {
+
+    size_t NB       = basisSet_.nBasis;
+    size_t nthreads = GetNumThreads();
+    size_t maxPts   = nLinesBlock * grid_.nPts[2];
+
+    double *DSub = memManager_.malloc<double>(nthreads*NB*NB);
+    double *SCR  = memManager_.malloc<double>(nthreads*NB*maxPts);
+
+    size_t LAThreads = GetLAThreads();
+    SetLAThreads(1);
+
+    writeFields(fName,comment,{},1,
+      [&](size_t thread_id, size_t NBE, size_t NPts, double *BasisEval,
+        std::vector<size_t> &evalBf, double *FIELD) {
+
+        double *DSub_loc = DSub + thread_id * NB*NB;
+        double *SCR_loc  = SCR  + thread_id * NB*maxPts;
+
+        for(size_t j = 0; j < NBE; j++)
+        for(size_t i = 0; i < NBE; i++)
+          DSub_loc[i + j*NBE] = D[evalBf[i] + evalBf[j]*LDD];
+
+        // SCR(m,p) = D(m,n) phi(n,p)
+        Gemm('N','N',NBE,NPts,NBE,1.,DSub_loc,NBE,BasisEval,NBE,0.,
+          SCR_loc,NBE);
+
+        // rho(p) = phi(m,p) SCR(m,p)
+        for(size_t iPt = 0; iPt < NPts; iPt++) {
+          double rho = 0.;
+          for(size_t m = 0; m < NBE; m++)
+            rho += BasisEval[m + iPt*NBE] * SCR_loc[m + iPt*NBE];
+          FIELD[iPt] = rho;
+        }
+
+      });
+
+    SetLAThreads(LAThreads);
+
+    memManager_.free(DSub,SCR);
+
+  }; // CubeWriter::writeDensity
+
+
+  /**
+   *  \brief Write a set of (real) molecular orbitals.
+   *
+   *  \param [in] fName    Cube file name
+   *  \param [in] comment  Title line of the cube file
+   *  \param [in] C        MO coefficients (NB x NMO)
+   *  \param [in] LDC      Leading dimension of C
+   *  \param [in] moIdx    Orbitals to evaluate (0-based)
+   */ 
+  void CubeWriter::writeOrbitals(const std::string &fName,
+    const std::string &comment, const double *C, size_t LDC, 
+    const std::vector<size_t> &moIdx) {
+
+    if( moIdx.empty() ) return;
+
+    size_t NB       = basisSet_.nBasis;
+    size_t nMO      = moIdx.size();
+    size_t nthreads = GetNumThreads();
+
+    double *CSub = memManager_.malloc<double>(nthreads*NB*nMO);
+
+    size_t LAThreads = GetLAThreads();
+    SetLAThreads(1);
+
+    writeFields(fName,comment,moIdx,nMO,
+      [&](size_t thread_id, size_t NBE, size_t NPts, double *BasisEval,
+        std::vector<size_t> &evalBf, double *FIELD) {
+
+        double *CSub_loc = CSub + thread_id * NB*nMO;
+
+        for(size_t j = 0; j < nMO; j++)
+        for(size_t i = 0; i < NBE; i++)
+          CSub_loc[i + j*NBE] = C[evalBf[i] + moIdx[j]*LDC];
+
+        // psi(i,p) = C(m,i) phi(m,p)
+        Gemm('T','N',nMO,NPts,NBE,1.,CSub_loc,NBE,BasisEval,NBE,0.,
+          FIELD,nMO);
+
+      });
+
+    SetLAThreads(LAThreads);
+
+    memManager_.free(CSub);
+
+  }; // CubeWriter::writeOrbitals
+
+}; // namespace ChronusQ
@@ -23,6 +23,10 @@
  */
 #include <basisset/reference.hpp>
 #include <atom.hpp>
+#include <cerr.hpp>
+
+#include <mutex>
+#include <sys/stat.h>
 
 namespace ChronusQ {
 
@@ -63,23 +67,28 @@ namespace ChronusQ {
    *
    *  Populates internal member data for ReferenceBasisSet for the
    *  basis set file object. Terminates program if it cannot find the 
-   *  file. 
+   *  file. Only the file metadata (modification time and size, which
+   *  validate the binary cache) is read here, the contents are read
+   *  in parseBasisFile.
    */
   void ReferenceBasisSet::findBasisFile(bool doPrint){
   
-    // Look for basis sets in BASIS_PATH
-    std::string fullBasisPath = "/" + basisPath_;
-    fullBasisPath.insert(0,BASIS_PATH);
-  
-    // Create a file object for the basis set file
-    basisFile_ = std::ifstream(fullBasisPath);
+    // Look for basis sets in BASIS_PATH (absolute paths are taken as is)
+    basisFullPath_ = basisPath_;
+    if( basisPath_.empty() or basisPath_[0] != '/' ) 
+      basisFullPath_.insert(0,std::string(BASIS_PATH) + "/");
   
     // Check if file exists
-    if(basisFile_.fail()){
+    struct stat fileStat;
+    if( stat(basisFullPath_.c_str(),&fileStat) != 0 or 
+        not S_ISREG(fileStat.st_mode) ){
       std::cout << "Cannot find basis set " + basisPath_ << std::endl;
       exit(EXIT_FAILURE);
     } else if (doPrint)
-      std::cout << "  *** Reading Basis Set from " + fullBasisPath << " ***" << std::endl;
+      std::cout << "  *** Reading Basis Set from " + basisFullPath_ << " ***" << std::endl;
+
+    basisMTime_ = fileStat.st_mtime;
+    basisSize_  = fileStat.st_size;
   
   }; // ReferenceBasisSet::findBasisFile
   
@@ -93,6 +102,12 @@ namespace ChronusQ {
    *  the basisPath
    */
   void ReferenceBasisSet::parseBasisFile() {
+
+    // Create a file object for the basis set file
+    basisFile_ = std::ifstream(basisFullPath_);
+    if( basisFile_.fail() )
+      CErr("Cannot open basis set file " + basisFullPath_);
+
     std::string readString;
     std::string nameOfAtom;
     std::string shSymb;
@@ -162,12 +177,16 @@ namespace ChronusQ {
           std::vector<double> exp;
           std::vector<double> contPrimary;
           std::vector<double> contSecondary;
+          std::vector<std::vector<double>> contGeneral; 
   
           // Determine the contraction depth of the shell set
           contDepth = std::stoi(tokens[1]);
   
           // Angular momentum symbol
           std::string shSymb = tokens[0];
+
+          // Number of columns (exponent + coefficients) of the record
+          size_t nCol = 0;
   
           // Loop over primitives
           for(auto i = 0; i < contDepth; i++) {
@@ -179,6 +198,16 @@ namespace ChronusQ {
               std::istream_iterator<std::string>{iss2},
               std::istream_iterator<std::string>{}
             );
+
+            // All primitive lines of a record must have the same number 
+            // of columns as the first
+            if( i == 0 ) {
+              nCol = tokens2.size();
+              if( nCol < (shSymb.compare("SP") ? 2 : 3) )
+                CErr("Missing contraction coefficients in " + basisPath_);
+              if( shSymb.compare("SP") ) contGeneral.resize(nCol - 2);
+            } else if( tokens2.size() != nCol )
+              CErr("Ragged contraction record in " + basisPath_);
   
             // Temporarily  store shell set data
             exp.push_back(std::stod(tokens2[0]));
@@ -188,6 +217,11 @@ namespace ChronusQ {
             // set.
             if(!shSymb.compare("SP"))
               contSecondary.push_back(std::stod(tokens2[2]));
+
+            // Additional coefficient columns of a general contraction
+            else
+              for(auto k = 2; k < nCol; k++)
+                contGeneral[k-2].push_back(std::stod(tokens2[k]));
           }
   
           // Create the libint2::Shell object
@@ -224,6 +258,19 @@ namespace ChronusQ {
               libint2::Shell{ exp, {{L,doSph,contPrimary}}, {{0,0,0}} }
             );
             tmpCons.push_back(contPrimary);
+
+            // The integral engines require segmented shells: the remaining
+            // contractions of a general contraction are appended as 
+            // consecutive shells over the same primitives (see 
+            // BasisSet::mapSh2Fam). The integrals are evaluated over these
+            // segmented shells, i.e. the primitive integrals are not shared
+            // between the contractions
+            for(auto &cont : contGeneral) {
+              tmpShell.push_back(
+                libint2::Shell{ exp, {{L,doSph,cont}}, {{0,0,0}} }
+              );
+              tmpCons.push_back(cont);
+            }
           } // end append temp record
   
   
@@ -245,7 +292,7 @@ namespace ChronusQ {
    *  \return         Shell set and coefficients for the given molecule
    */
   std::pair<std::vector<libint2::Shell>,std::vector<std::vector<double>>> 
-    ReferenceBasisSet::generateShellSet(const Molecule& mol) {
+    ReferenceBasisSet::generateShellSet(const Molecule& mol) const {
   
     std::vector<libint2::Shell> shells;
     std::vector<std::vector<double>> cont;
@@ -255,7 +302,7 @@ namespace ChronusQ {
       if( refShells.find(atom.atomicNumber) == refShells.end() )
         CErr("Cannot find Z=" + std::to_string(atom.atomicNumber) + " in Basis Definition");
 
-      auto &newSh  = refShells[atom.atomicNumber];
+      auto &newSh  = refShells.at(atom.atomicNumber);
   
       auto shFront = shells.insert(shells.end(),newSh.shells.begin(),
         newSh.shells.end());
@@ -274,5 +321,246 @@ namespace ChronusQ {
   }; // ReferenceShellSer::generateShellSet
 
 
+
+
+  // Binary basis cache
+  // -----------------------------------------------------------------------
+  //
+  // Layout (native endianness):
+  //   size_t  magic, version
+  //   size_t  hash of the full basis file path
+  //   int64_t modification time of the basis file
+  //   uint64_t size of the basis file
+  //   bool    forceCart
+  //   size_t  nAtoms
+  //   For each atom:
+  //     int     atomic number
+  //     size_t  nShell
+  //     For each shell:
+  //       int     L
+  //       bool    pure
+  //       size_t  nPrim
+  //       double  exponents[nPrim]
+  //       double  unnormalized coefficients[nPrim]
+
+  static const size_t BASIS_CACHE_MAGIC   = 0x4351424153495321; // "CQBASIS!"
+  static const size_t BASIS_CACHE_VERSION = 2;
+
+  std::string ReferenceBasisSet::cacheDir = "";
+
+  template <typename T>
+  static inline void cacheWrite(std::ofstream &f, const T &x) {
+    f.write(reinterpret_cast<const char*>(&x), sizeof(T));
+  }
+
+  template <typename T>
+  static inline bool cacheRead(std::ifstream &f, T &x) {
+    f.read(reinterpret_cast<char*>(&x), sizeof(T));
+    return f.good();
+  }
+
+
+  /**
+   *  \brief Determine the name of the binary cache file for this
+   *  basis set.
+   *
+   *  \returns Path to the cache file, empty if the cache is disabled
+   */
+  std::string ReferenceBasisSet::cacheFileName() const {
+
+    if( cacheDir.empty() ) return "";
+
+    std::string fName(basisPath_);
+    std::replace(fName.begin(),fName.end(),'/','_');
+
+    return cacheDir + "/" + fName + (forceCart_ ? ".cart" : ".sph") + 
+      ".cqbin";
+
+  }; // ReferenceBasisSet::cacheFileName
+
+
+  /**
+   *  \brief Attempts to populate refShells from the binary basis cache.
+   *
+   *  The cache is only accepted if its header matches the current
+   *  basis file (path, modification time and size) and forceCart 
+   *  setting. A hit does not touch the text basis file.
+   *
+   *  \returns Whether or not refShells was populated from the cache
+   */
+  bool ReferenceBasisSet::readBinaryCache() {
+
+    std::string fName = cacheFileName();
+    if( fName.empty() ) return false;
+
+    std::ifstream cache(fName, std::ios::binary);
+    if( cache.fail() ) return false;
+
+    size_t   magic, version, hash, nAtoms;
+    int64_t  mtime;
+    uint64_t fSize;
+    bool     cart;
+
+    size_t pathHash = std::hash<std::string>()(basisFullPath_);
+
+    if( not cacheRead(cache,magic)   or magic   != BASIS_CACHE_MAGIC   ) return false;
+    if( not cacheRead(cache,version) or version != BASIS_CACHE_VERSION ) return false;
+    if( not cacheRead(cache,hash)    or hash    != pathHash            ) return false;
+    if( not cacheRead(cache,mtime)   or mtime   != basisMTime_         ) return false;
+    if( not cacheRead(cache,fSize)   or fSize   != basisSize_          ) return false;
+    if( not cacheRead(cache,cart)    or cart    != forceCart_          ) return false;
+    if( not cacheRead(cache,nAtoms) ) return false;
+
+    std::unordered_map<int,ReferenceShell> tmpShells;
+
+    for(auto iAtm = 0; iAtm < nAtoms; iAtm++) {
+
+      int    atomicNumber;
+      size_t nShell;
+      if( not cacheRead(cache,atomicNumber) ) return false;
+      if( not cacheRead(cache,nShell) )       return false;
+
+      ReferenceShell &ref = tmpShells[atomicNumber];
+
+      for(auto iSh = 0; iSh < nShell; iSh++) {
+
+        int    L;
+        bool   pure;
+        size_t nPrim;
+        if( not cacheRead(cache,L) )     return false;
+        if( not cacheRead(cache,pure) )  return false;
+        if( not cacheRead(cache,nPrim) ) return false;
+
+        std::vector<double> exp(nPrim), cont(nPrim);
+        cache.read(reinterpret_cast<char*>(exp.data()), nPrim*sizeof(double));
+        cache.read(reinterpret_cast<char*>(cont.data()),nPrim*sizeof(double));
+        if( not cache.good() ) return false;
+
+        // libint2::Shell normalizes the coefficients exactly as is done
+        // when parsing the basis file
+        ref.shells.push_back(
+          libint2::Shell{ exp, {{L,pure,cont}}, {{0,0,0}} }
+        );
+        ref.unNormCont.emplace_back(std::move(cont));
+
+      }
+
+    }
+
+    refShells = std::move(tmpShells);
+    return true;
+
+  }; // ReferenceBasisSet::readBinaryCache
+
+
+  /**
+   *  \brief Dumps refShells to the binary basis cache (if enabled).
+   *
+   *  The cache directory is created if it does not exist. Failure to 
+   *  write the cache is not fatal.
+   */
+  void ReferenceBasisSet::writeBinaryCache() const {
+
+    std::string fName = cacheFileName();
+    if( fName.empty() ) return;
+
+    mkdir(cacheDir.c_str(),0755);
+
+    // Write to a temporary file and rename to avoid partially written 
+    // caches
+    std::string tmpName = fName + ".tmp" + std::to_string(getpid());
+    std::ofstream cache(tmpName, std::ios::binary | std::ios::trunc);
+    if( cache.fail() ) return;
+
+    cacheWrite(cache,BASIS_CACHE_MAGIC);
+    cacheWrite(cache,BASIS_CACHE_VERSION);
+    cacheWrite(cache,std::hash<std::string>()(basisFullPath_));
+    cacheWrite(cache,basisMTime_);
+    cacheWrite(cache,basisSize_);
+    cacheWrite(cache,forceCart_);
+    cacheWrite(cache,refShells.size());
+
+    for(auto &atm : refShells) {
+
+      cacheWrite(cache,atm.first);
+      cacheWrite(cache,atm.second.shells.size());
+
+      for(auto iSh = 0; iSh < atm.second.shells.size(); iSh++) {
+
+        const libint2::Shell      &sh   = atm.second.shells[iSh];
+        const std::vector<double> &cont = atm.second.unNormCont[iSh];
+
+        cacheWrite(cache,sh.contr[0].l);
+        cacheWrite(cache,sh.contr[0].pure);
+        cacheWrite(cache,sh.alpha.size());
+        cache.write(reinterpret_cast<const char*>(sh.alpha.data()),
+          sh.alpha.size()*sizeof(double));
+        cache.write(reinterpret_cast<const char*>(cont.data()),
+          cont.size()*sizeof(double));
+
+      }
+
+    }
+
+    cache.close();
+
+    if( cache.good() ) std::rename(tmpName.c_str(),fName.c_str());
+    else               std::remove(tmpName.c_str());
+
+  }; // ReferenceBasisSet::writeBinaryCache
+
+
+
+
+  // Registry of parsed basis sets
+  // -----------------------------------------------------------------------
+
+  static std::unordered_map<std::string,std::shared_ptr<ReferenceBasisSet>>
+    basisRegistry;
+  static std::mutex basisRegistryMutex;
+
+  /**
+   *  \brief Obtain a (shared) ReferenceBasisSet object from the in-process
+   *  registry.
+   *
+   *  The basis file is only digested (or loaded from the binary cache)
+   *  the first time a particular (path,forceCart) pair is requested.
+   *
+   *  \param [in] path      Path to basis file (relative to BASIS_PATH)
+   *  \param [in] forceCart Whether or not to force cartesian GTOs
+   *  \param [in] doPrint   Whether or not to print the basis file path
+   *                        upon first digestion
+   *
+   *  \returns Shared ReferenceBasisSet object
+   */
+  std::shared_ptr<ReferenceBasisSet> ReferenceBasisSet::fetch(
+    const std::string &path, bool forceCart, bool doPrint) {
+
+    std::string key = path + (forceCart ? ":CART" : ":SPH");
+
+    std::lock_guard<std::mutex> lock(basisRegistryMutex);
+
+    auto it = basisRegistry.find(key);
+    if( it != basisRegistry.end() ) return it->second;
+
+    auto ref = std::make_shared<ReferenceBasisSet>(path,forceCart,doPrint);
+    basisRegistry[key] = ref;
+
+    return ref;
+
+  }; // ReferenceBasisSet::fetch
+
+
+  /**
+   *  \brief Clear the in-process registry of parsed basis sets
+   */
+  void ReferenceBasisSet::clearRegistry() {
+
+    std::lock_guard<std::mutex> lock(basisRegistryMutex);
+    basisRegistry.clear();
+
+  }; // ReferenceBasisSet::clearRegistry
+
+
 }; // namespace ChronusQ
 
@@ -72,12 +72,16 @@ namespace ChronusQ {
       Eigen::Matrix<dcomplex,Eigen::Dynamic,Eigen::Dynamic,Eigen::ColMajor>
     > BMap(B,LDB,COLS_B), CMap(C,LDC,N);
 
+    // C = BETA * C (C is not referenced if BETA == 0)
+    if( BETA == dcomplex(0.) ) CMap.block(0,0,M,N).setZero();
+    else if( BETA != dcomplex(1.) ) CMap.block(0,0,M,N) *= BETA;
+
     if(TRANSB == 'N')
-      CMap.block(0,0,M,N).noalias() = 
+      CMap.block(0,0,M,N).noalias() += ALPHA *
         AMap.block(0,0,M,K).cast<dcomplex>() *
         BMap.block(0,0,K,N);
     else
-      CMap.block(0,0,M,N).noalias() = 
+      CMap.block(0,0,M,N).noalias() += ALPHA *
         AMap.block(0,0,M,K).cast<dcomplex>() *
         BMap.block(0,0,N,K).adjoint();
 #endif
@@ -204,4 +204,48 @@ namespace ChronusQ {
   template void HerMat(char, size_t, double*, size_t);
   template void HerMat(char, size_t, dcomplex*, size_t);
 
+
+  // Generic MatLinComb template
+  template <typename _F>
+  void MatLinComb(size_t M, size_t N, _F BETA, _F *C, size_t LDC,
+    const std::vector<LinCombTerm<_F>> &terms,
+    const std::vector<RealLinCombTerm> &realTerms) {
+
+    // Real operands are placed into C with a stride of 2 (complex) or
+    // 1 (real)
+    const size_t stride = sizeof(_F) / sizeof(double);
+
+    for(auto &X : realTerms) 
+      assert( (std::is_same<_F,dcomplex>::value or not X.IMAG) );
+
+    #pragma omp parallel for
+    for(size_t j = 0; j < N; j++) {
+
+      _F *Cj = C + j*LDC;
+
+      if( BETA == _F(0.) )      std::fill_n(Cj,M,_F(0.));
+      else if( BETA != _F(1.) ) for(size_t i = 0; i < M; i++) Cj[i] *= BETA;
+
+      for(auto &X : terms) {
+        const _F *Aj = X.A + j*X.LDA;
+        for(size_t i = 0; i < M; i++) Cj[i] += X.ALPHA * Aj[i];
+      }
+
+      for(auto &X : realTerms) {
+        const double *Aj = X.A + j*X.LDA;
+        double *CRj = reinterpret_cast<double*>(Cj) + (X.IMAG ? 1 : 0);
+        for(size_t i = 0; i < M; i++) CRj[i*stride] += X.ALPHA * Aj[i];
+      }
+
+    }
+
+  }; // Generic MatLinComb template
+
+  template void MatLinComb(size_t, size_t, double, double*, size_t,
+    const std::vector<LinCombTerm<double>>&, 
+    const std::vector<RealLinCombTerm>&);
+  template void MatLinComb(size_t, size_t, dcomplex, dcomplex*, size_t,
+    const std::vector<LinCombTerm<dcomplex>>&, 
+    const std::vector<RealLinCombTerm>&);
+
 }; // namespace ChronusQ
@@ -0,0 +1,420 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <cqlinalg/krylov.hpp>
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Apply a KrylovOperator to the columns act of V (N x nRHS)
+   *  and store the result in the same columns of AV.
+   */ 
+  static void KrylovApply(const KrylovOperator &op, size_t N, 
+    const std::vector<size_t> &act, double *V, double *AV, double *SCR1, 
+    double *SCR2) {
+
+    const size_t nAct = act.size();
+    if( nAct == 0 ) return;
+
+    for(auto k = 0ul; k < nAct; k++)
+      std::copy_n(V + act[k]*N, N, SCR1 + k*N);
+
+    op(nAct,&act[0],SCR1,SCR2);
+
+    for(auto k = 0ul; k < nAct; k++)
+      std::copy_n(SCR2 + k*N, N, AV + act[k]*N);
+
+  }; // KrylovApply
+
+
+  /**
+   *  \brief Preconditioned conjugate gradient (SPD operators).
+   */ 
+  static bool KrylovCG(size_t N, size_t nRHS, double *B, double *X, 
+    const KrylovOperator &linOp, const KrylovOperator &precond,
+    double convTol, size_t maxIter, size_t &nIter, CQMemManager &mem) {
+
+    double *R    = mem.malloc<double>(N*nRHS);
+    double *Z    = mem.malloc<double>(N*nRHS);
+    double *P    = mem.malloc<double>(N*nRHS);
+    double *AP   = mem.malloc<double>(N*nRHS);
+    double *SCR1 = mem.malloc<double>(N*nRHS);
+    double *SCR2 = mem.malloc<double>(N*nRHS);
+
+    std::vector<double> rz(nRHS,0.), bNorm(nRHS,0.);
+    std::vector<bool>   conv(nRHS,false);
+    std::vector<size_t> act;
+
+    std::fill_n(X,N*nRHS,0.);
+    std::copy_n(B,N*nRHS,R);
+
+    for(auto i = 0ul; i < nRHS; i++) {
+      bNorm[i] = TwoNorm<double>(N,B + i*N,1);
+      if( bNorm[i] < 1e-14 ) conv[i] = true;
+      else                   act.emplace_back(i);
+    }
+
+    // Z = M * R, P = Z
+    KrylovApply(precond,N,act,R,Z,SCR1,SCR2);
+    for(auto i : act) {
+      std::copy_n(Z + i*N,N,P + i*N);
+      rz[i] = InnerProd<double>(N,R + i*N,1,Z + i*N,1);
+    }
+
+    for(nIter = 0; nIter < maxIter and not act.empty(); nIter++) {
+
+      KrylovApply(linOp,N,act,P,AP,SCR1,SCR2);
+
+      std::vector<size_t> nextAct;
+      for(auto i : act) {
+
+        double *Xi = X + i*N, *Ri = R + i*N, *Pi = P + i*N, *APi = AP + i*N;
+
+        double alpha = rz[i] / InnerProd<double>(N,Pi,1,APi,1);
+
+        for(auto k = 0ul; k < N; k++) {
+          Xi[k] += alpha * Pi[k];
+          Ri[k] -= alpha * APi[k];
+        }
+
+        if( TwoNorm<double>(N,Ri,1) / bNorm[i] < convTol ) conv[i] = true;
+        else nextAct.emplace_back(i);
+
+      }
+
+      act = nextAct;
+
+      // New search directions
+      KrylovApply(precond,N,act,R,Z,SCR1,SCR2);
+      for(auto i : act) {
+
+        double rzNew = InnerProd<double>(N,R + i*N,1,Z + i*N,1);
+        double beta  = rzNew / rz[i];
+        rz[i] = rzNew;
+
+        for(auto k = 0ul; k < N; k++)
+          P[k + i*N] = Z[k + i*N] + beta * P[k + i*N];
+
+      }
+
+    }
+
+    mem.free(R,Z,P,AP,SCR1,SCR2);
+
+    return act.empty();
+
+  }; // KrylovCG
+
+
+  /**
+   *  \brief Preconditioned MINRES (symmetric, possibly indefinite, 
+   *  operators with an SPD preconditioner). 
+   *
+   *  Follows the formulation of Paige and Saunders, SIAM J. Numer. Anal.
+   *  12, 617 (1975).
+   */ 
+  static bool KrylovMINRES(size_t N, size_t nRHS, double *B, double *X, 
+    const KrylovOperator &linOp, const KrylovOperator &precond,
+    double convTol, size_t maxIter, size_t &nIter, CQMemManager &mem) {
+
+    double *R1   = mem.malloc<double>(N*nRHS);
+    double *R2   = mem.malloc<double>(N*nRHS);
+    double *Y    = mem.malloc<double>(N*nRHS);
+    double *V    = mem.malloc<double>(N*nRHS);
+    double *W    = mem.malloc<double>(N*nRHS);
+    double *W1   = mem.malloc<double>(N*nRHS);
+    double *W2   = mem.malloc<double>(N*nRHS);
+    double *SCR1 = mem.malloc<double>(N*nRHS);
+    double *SCR2 = mem.malloc<double>(N*nRHS);
+
+    std::vector<double> beta1(nRHS,0.), beta(nRHS,0.), oldb(nRHS,0.),
+      dbar(nRHS,0.), epsln(nRHS,0.), phibar(nRHS,0.), cs(nRHS,-1.), 
+      sn(nRHS,0.), alfa(nRHS,0.);
+    std::vector<size_t> act, all;
+
+    std::fill_n(X ,N*nRHS,0.);
+    std::fill_n(W ,N*nRHS,0.);
+    std::fill_n(W2,N*nRHS,0.);
+    std::copy_n(B,N*nRHS,R1);
+    std::copy_n(B,N*nRHS,R2);
+
+    for(auto i = 0ul; i < nRHS; i++) all.emplace_back(i);
+
+    // Y = M * B
+    KrylovApply(precond,N,all,R1,Y,SCR1,SCR2);
+
+    for(auto i : all) {
+      double b2 = InnerProd<double>(N,R1 + i*N,1,Y + i*N,1);
+      if( b2 < 0. ) 
+        CErr("MINRES requires a positive definite preconditioner");
+
+      beta1[i] = std::sqrt(b2);
+      beta[i]  = beta1[i];
+      phibar[i] = beta1[i];
+
+      if( beta1[i] > 1e-14 ) act.emplace_back(i);
+    }
+
+    for(nIter = 0; nIter < maxIter and not act.empty(); nIter++) {
+
+      for(auto i : act)
+      for(auto k = 0ul; k < N; k++) V[k + i*N] = Y[k + i*N] / beta[i];
+
+      // Y = A * V
+      KrylovApply(linOp,N,act,V,Y,SCR1,SCR2);
+
+      for(auto i : act) {
+
+        double *Yi = Y + i*N, *R1i = R1 + i*N, *R2i = R2 + i*N;
+
+        if( nIter > 0 )
+          for(auto k = 0ul; k < N; k++) Yi[k] -= (beta[i]/oldb[i]) * R1i[k];
+
+        alfa[i] = InnerProd<double>(N,V + i*N,1,Yi,1);
+
+        for(auto k = 0ul; k < N; k++) Yi[k] -= (alfa[i]/beta[i]) * R2i[k];
+
+        std::copy_n(R2i,N,R1i);
+        std::copy_n(Yi ,N,R2i);
+
+      }
+
+      // Y = M * R2
+      KrylovApply(precond,N,act,R2,Y,SCR1,SCR2);
+
+      std::vector<size_t> nextAct;
+      for(auto i : act) {
+
+        oldb[i] = beta[i];
+
+        double b2 = InnerProd<double>(N,R2 + i*N,1,Y + i*N,1);
+        if( b2 < 0. ) 
+          CErr("MINRES requires a positive definite preconditioner");
+        beta[i] = std::sqrt(b2);
+
+        // Update the QR factorization of the Lanczos tridiagonal
+        double oldeps = epsln[i];
+        double delta  = cs[i]*dbar[i] + sn[i]*alfa[i];
+        double gbar   = sn[i]*dbar[i] - cs[i]*alfa[i];
+        epsln[i] = sn[i]*beta[i];
+        dbar[i]  = -cs[i]*beta[i];
+
+        double gamma = std::max(std::hypot(gbar,beta[i]),
+          std::numeric_limits<double>::epsilon());
+        cs[i] = gbar    / gamma;
+        sn[i] = beta[i] / gamma;
+
+        double phi = cs[i]*phibar[i];
+        phibar[i] *= sn[i];
+
+        // Update the solution
+        double *Wi = W + i*N, *W1i = W1 + i*N, *W2i = W2 + i*N, 
+               *Vi = V + i*N, *Xi  = X  + i*N;
+
+        std::copy_n(W2i,N,W1i);
+        std::copy_n(Wi ,N,W2i);
+        for(auto k = 0ul; k < N; k++) {
+          Wi[k] = (Vi[k] - oldeps*W1i[k] - delta*W2i[k]) / gamma;
+          Xi[k] += phi * Wi[k];
+        }
+
+        if( phibar[i] / beta1[i] >= convTol and beta[i] > 1e-14 )
+          nextAct.emplace_back(i);
+
+      }
+
+      act = nextAct;
+
+    }
+
+    mem.free(R1,R2,Y,V,W,W1,W2,SCR1,SCR2);
+
+    return act.empty();
+
+  }; // KrylovMINRES
+
+
+  /**
+   *  \brief Right preconditioned GMRES (general operators). 
+   *
+   *  The Krylov subspace is not restarted, i.e. it grows to at most
+   *  maxIter vectors per right hand side.
+   */ 
+  static bool KrylovGMRES(size_t N, size_t nRHS, double *B, double *X, 
+    const KrylovOperator &linOp, const KrylovOperator &precond,
+    double convTol, size_t maxIter, size_t &nIter, CQMemManager &mem) {
+
+    const size_t LDH = maxIter + 1;
+
+    double *VB   = mem.malloc<double>(N*LDH*nRHS);
+    double *H    = mem.malloc<double>(LDH*maxIter*nRHS);
+    double *Z    = mem.malloc<double>(N*nRHS);
+    double *AZ   = mem.malloc<double>(N*nRHS);
+    double *SCR1 = mem.malloc<double>(N*nRHS);
+    double *SCR2 = mem.malloc<double>(N*nRHS);
+
+    std::vector<std::vector<double>> g(nRHS,std::vector<double>(LDH,0.)),
+      cs(nRHS,std::vector<double>(maxIter,0.)),
+      sn(nRHS,std::vector<double>(maxIter,0.));
+    std::vector<double> bNorm(nRHS,0.);
+    std::vector<size_t> nK(nRHS,0), act, all;
+
+    auto basis = [&](size_t i, size_t j) { return VB + (i*LDH + j)*N; };
+    auto hess  = [&](size_t i, size_t j, size_t k) -> double& {
+      return H[i*LDH*maxIter + j + k*LDH];
+    };
+
+    std::fill_n(X,N*nRHS,0.);
+
+    for(auto i = 0ul; i < nRHS; i++) {
+
+      all.emplace_back(i);
+      bNorm[i] = TwoNorm<double>(N,B + i*N,1);
+      if( bNorm[i] < 1e-14 ) continue;
+
+      for(auto k = 0ul; k < N; k++) basis(i,0)[k] = B[k + i*N] / bNorm[i];
+      g[i][0] = bNorm[i];
+      act.emplace_back(i);
+
+    }
+
+    for(nIter = 0; nIter < maxIter and not act.empty(); nIter++) {
+
+      const size_t j = nIter;
+
+      // W = A * M * V(j)
+      for(auto i : act) std::copy_n(basis(i,j),N,AZ + i*N);
+      KrylovApply(precond,N,act,AZ,Z,SCR1,SCR2);
+      KrylovApply(linOp,N,act,Z,AZ,SCR1,SCR2);
+
+      std::vector<size_t> nextAct;
+      for(auto i : act) {
+
+        double *Wi = AZ + i*N;
+
+        // Modified Gram-Schmidt
+        for(auto l = 0ul; l <= j; l++) {
+          double h = InnerProd<double>(N,Wi,1,basis(i,l),1);
+          hess(i,l,j) = h;
+          for(auto k = 0ul; k < N; k++) Wi[k] -= h * basis(i,l)[k];
+        }
+
+        double hNext = TwoNorm<double>(N,Wi,1);
+        if( hNext > 1e-14 )
+          for(auto k = 0ul; k < N; k++) basis(i,j+1)[k] = Wi[k] / hNext;
+
+        // Apply the previous rotations to the new column
+        for(auto l = 0ul; l < j; l++) {
+          double t1 = hess(i,l,j), t2 = hess(i,l+1,j);
+          hess(i,l  ,j) =  cs[i][l]*t1 + sn[i][l]*t2;
+          hess(i,l+1,j) = -sn[i][l]*t1 + cs[i][l]*t2;
+        }
+
+        // New rotation to eliminate hNext
+        double denom = std::hypot(hess(i,j,j),hNext);
+        cs[i][j] = hess(i,j,j) / denom;
+        sn[i][j] = hNext       / denom;
+        hess(i,j,j) = denom;
+
+        g[i][j+1] = -sn[i][j] * g[i][j];
+        g[i][j]   =  cs[i][j] * g[i][j];
+
+        nK[i] = j + 1;
+
+        if( std::abs(g[i][j+1]) / bNorm[i] >= convTol and hNext > 1e-14 )
+          nextAct.emplace_back(i);
+
+      }
+
+      act = nextAct;
+
+    }
+
+    // Solve the triangular systems and form X = M * V * y
+    std::vector<size_t> solved;
+    for(auto i : all) {
+
+      if( nK[i] == 0 ) continue;
+      solved.emplace_back(i);
+
+      std::vector<double> y(g[i].begin(),g[i].begin() + nK[i]);
+      for(int l = nK[i] - 1; l >= 0; l--) {
+        for(auto m = l + 1; m < nK[i]; m++) y[l] -= hess(i,l,m) * y[m];
+        y[l] /= hess(i,l,l);
+      }
+
+      Gemm('N','N',N,1,nK[i],1.,basis(i,0),N,&y[0],nK[i],0.,Z + i*N,N);
+
+    }
+
+    KrylovApply(precond,N,solved,Z,X,SCR1,SCR2);
+
+    mem.free(VB,H,Z,AZ,SCR1,SCR2);
+
+    return act.empty();
+
+  }; // KrylovGMRES
+
+
+  /**
+   *  \brief Solves the linear systems A X(i) = B(i) for several right
+   *  hand sides with a preconditioned Krylov method.
+   *
+   *  The right hand sides are iterated simultaneously such that each
+   *  iteration passes the search vectors of all unconverged systems to 
+   *  a single invocation of the linear operator (and preconditioner).
+   *  Converged systems drop out of the iterations.
+   *
+   *  \param [in]  alg      Krylov algorithm
+   *  \param [in]  N        Dimension of the linear systems
+   *  \param [in]  nRHS     Number of right hand sides
+   *  \param [in]  B        Right hand sides (N x nRHS)
+   *  \param [out] X        Solutions (N x nRHS)
+   *  \param [in]  linOp    Linear operator A
+   *  \param [in]  precond  Preconditioner (approximation to A^-1)
+   *  \param [in]  convTol  Convergence tolerance on the relative residual
+   *  \param [in]  maxIter  Maximum number of iterations
+   *  \param [out] nIter    Number of iterations performed
+   *  \param [in]  mem      Memory manager for scratch storage
+   *
+   *  \returns Whether or not all of the systems converged
+   */ 
+  bool KrylovSolve(KRYLOV_ALGORITHM alg, size_t N, size_t nRHS, double *B, 
+    double *X, const KrylovOperator &linOp, const KrylovOperator &precond,
+    double convTol, size_t maxIter, size_t &nIter, CQMemManager &mem) {
+
+    if( alg == KRYLOV_CG )
+      return KrylovCG(N,nRHS,B,X,linOp,precond,convTol,maxIter,nIter,mem);
+    else if( alg == KRYLOV_MINRES )
+      return KrylovMINRES(N,nRHS,B,X,linOp,precond,convTol,maxIter,nIter,
+        mem);
+    else
+      return KrylovGMRES(N,nRHS,B,X,linOp,precond,convTol,maxIter,nIter,
+        mem);
+
+  }; // KrylovSolve
+
+}; // namespace ChronusQ
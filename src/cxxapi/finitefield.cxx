@@ -0,0 +1,200 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <cxxapi/finitefield.hpp>
+#include <cxxapi/output.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Converge copies of a SingleSlater object (of dynamic type 
+   *  _SSTyp<T>) under a set of perturbations in lockstep.
+   *
+   *  \param [in]  ref      Reference SingleSlater object (with a guess)
+   *  \param [in]  perts    Perturbation of each copy
+   *  \param [out] energies Total energy of each copy
+   *  \param [out] dipoles  Electric dipole of each copy
+   *
+   *  \returns Whether or not ref is of type _SSTyp<T>
+   */ 
+  template <template <typename> class _SSTyp, typename T>
+  bool LockstepCopies(SingleSlaterBase &ref, 
+    std::vector<EMPerturbation> &perts, std::vector<double> &energies,
+    std::vector<cart_t> &dipoles) {
+
+    _SSTyp<T> *typedRef = dynamic_cast<_SSTyp<T>*>(&ref);
+    if( not typedRef ) return false;
+
+    std::vector<std::shared_ptr<_SSTyp<T>>> copies;
+    std::vector<SingleSlater<T>*> ss;
+
+    for(auto i = 0ul; i < perts.size(); i++) {
+
+      copies.emplace_back(std::make_shared<_SSTyp<T>>(*typedRef));
+      ss.emplace_back(copies.back().get());
+
+      // Copies do not checkpoint or print
+      copies.back()->savFile    = SafeFile();
+      copies.back()->printLevel = 0;
+
+    }
+
+    LockstepSCF(ss,perts);
+
+    for(auto &s : ss) {
+      energies.emplace_back(s->totalEnergy);
+      dipoles.emplace_back(s->elecDipole);
+    }
+
+    return true;
+
+  }; // LockstepCopies
+
+
+  /**
+   *  \brief Evaluate the static dipole polarizability and the diagonal
+   *  (beta_ijj) first hyperpolarizability by finite differences of the
+   *  dipole moment.
+   *
+   *  The SCFs at +-F (and +-2F) along each axis are converged in 
+   *  lockstep (see LockstepSCF) such that the ERIs are evaluated once 
+   *  per iteration for all fields. As the field enters the energy as 
+   *  E(F) = E(0) + F.mu, alpha_ij = -d mu_i / d F_j and 
+   *  beta_ijj = -d^2 mu_i / d F_j^2. The reference energy and dipole, 
+   *  alpha and beta (stored [i][j]) are saved to the checkpoint file
+   *  (FF/*) if one is attached.
+   *
+   *  \param [in] out  Output stream
+   *  \param [in] ctl  Finite field controls
+   *  \param [in] ss   Reference SingleSlater object (with a guess)
+   *  \param [in] pert Static perturbation common to all SCFs
+   */ 
+  void FiniteFieldProperties(std::ostream &out, FiniteFieldControls &ctl, 
+    SingleSlaterBase &ss, EMPerturbation &pert) {
+
+    const double F = ctl.field;
+    const bool fivePoint = ctl.nPoint == 13;
+    const std::vector<double> steps = fivePoint ? 
+      std::vector<double>({F,-F,2*F,-2*F}) : std::vector<double>({F,-F});
+
+    // Reference followed by the displacements along X, Y and Z
+    std::vector<EMPerturbation> perts(1,pert);
+    for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+    for(auto &h : steps) {
+      cart_t amp = {0.,0.,0.}; amp[iXYZ] = h;
+      perts.emplace_back(pert);
+      perts.back().addField(Electric,amp);
+    }
+
+    out << BannerTop << std::endl;
+    out << "Finite Field Properties:" << std::endl << std::endl;
+    out << std::setw(38) << std::left << "  Field Strength (au):" 
+        << std::scientific << std::setprecision(4) << F << std::endl;
+    out << std::setw(38) << std::left << "  Stencil:" 
+        << (fivePoint ? "5-Point" : "3-Point") << std::endl << std::endl;
+
+    std::vector<double> energies;
+    std::vector<cart_t> dipoles;
+
+    bool found = 
+      LockstepCopies<HartreeFock,double>  (ss,perts,energies,dipoles) or
+      LockstepCopies<KohnSham,double>     (ss,perts,energies,dipoles) or
+      LockstepCopies<HartreeFock,dcomplex>(ss,perts,energies,dipoles) or
+      LockstepCopies<KohnSham,dcomplex>   (ss,perts,energies,dipoles);
+
+    if( not found )
+      CErr("Finite field properties not implemented for this reference",out);
+
+    // Finite difference derivatives of the dipole along field j
+    const size_t nStep = steps.size();
+    auto dip = [&](size_t j, size_t k, size_t i) -> double {
+      return dipoles[1 + j*nStep + k][i];
+    };
+
+    double alpha[3][3], beta[3][3];
+    for(auto j = 0; j < 3; j++)
+    for(auto i = 0; i < 3; i++) {
+
+      double mu0 = dipoles[0][i];
+
+      if( fivePoint ) {
+        alpha[i][j] = -( 8.*(dip(j,0,i) - dip(j,1,i)) - 
+          (dip(j,2,i) - dip(j,3,i)) ) / (12.*F);
+        beta[i][j] = -( 16.*(dip(j,0,i) + dip(j,1,i)) - 
+          (dip(j,2,i) + dip(j,3,i)) - 30.*mu0 ) / (12.*F*F);
+      } else {
+        alpha[i][j] = -(dip(j,0,i) - dip(j,1,i)) / (2.*F);
+        beta[i][j]  = -(dip(j,0,i) + dip(j,1,i) - 2.*mu0) / (F*F);
+      }
+
+    }
+
+    out << "  Reference Energy (Eh) = " << std::fixed 
+        << std::setprecision(10) << energies[0] << std::endl;
+
+    const std::array<std::string,3> lab = {"X","Y","Z"};
+
+    out << std::endl << "  Static Dipole Polarizability (au):" 
+        << std::endl << BannerMid << std::endl;
+    out << std::setw(8) << " ";
+    for(auto j = 0; j < 3; j++) out << std::setw(20) << std::right << lab[j];
+    out << std::endl;
+    for(auto i = 0; i < 3; i++) {
+      out << "    " << std::setw(4) << std::left << lab[i];
+      for(auto j = 0; j < 3; j++)
+        out << std::setw(20) << std::right << std::fixed 
+            << std::setprecision(6) << alpha[i][j];
+      out << std::endl;
+    }
+
+    out << std::endl << "    Isotropic Polarizability (au) = " 
+        << (alpha[0][0] + alpha[1][1] + alpha[2][2]) / 3. << std::endl;
+
+    out << std::endl << "  First Hyperpolarizability beta_ijj (au):" 
+        << std::endl << BannerMid << std::endl;
+    out << std::setw(8) << " ";
+    for(auto j = 0; j < 3; j++) 
+      out << std::setw(20) << std::right << "j = " + lab[j];
+    out << std::endl;
+    for(auto i = 0; i < 3; i++) {
+      out << "    " << std::setw(4) << std::left << lab[i];
+      for(auto j = 0; j < 3; j++)
+        out << std::setw(20) << std::right << std::fixed 
+            << std::setprecision(6) << beta[i][j];
+      out << std::endl;
+    }
+
+    out << std::endl << BannerEnd << std::endl;
+
+    // Save the properties
+    if( ss.savFile.exists() ) {
+      ss.savFile.safeWriteData("FF/ENERGY",&energies[0],{1});
+      ss.savFile.safeWriteData("FF/DIPOLE",&dipoles[0][0],{3});
+      ss.savFile.safeWriteData("FF/ALPHA",&alpha[0][0],{3,3});
+      ss.savFile.safeWriteData("FF/BETA",&beta[0][0],{3,3});
+    }
+
+  }; // FiniteFieldProperties
+
+}; // namespace ChronusQ
@@ -0,0 +1,250 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <cxxapi/geomopt.hpp>
+#include <cxxapi/output.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Move the nuclei of a calculation and recompute the geometry
+   *  dependent integrals (core Hamiltonian and, if INCORE, the ERIs).
+   *
+   *  The density of the SingleSlater object is retained such that a
+   *  subsequent SCF starts from the previous solution.
+   *
+   *  \param [in] x      New nuclear coordinates (Bohr), (x,y,z) per atom
+   *  \param [in] mol    Molecule to update
+   *  \param [in] basis  BasisSet centered on mol
+   *  \param [in] aoints AOIntegrals over basis
+   *  \param [in] ss     SingleSlater object over aoints
+   */ 
+  void SetGeometry(const std::vector<double> &x, Molecule &mol, 
+    BasisSet &basis, AOIntegrals &aoints, SingleSlaterBase &ss) {
+
+    if( x.size() != 3*mol.nAtoms )
+      CErr("Number of coordinates does not match the Molecule",std::cout);
+
+    std::vector<Atom> atoms = mol.atoms;
+    for(auto iAtm = 0; iAtm < mol.nAtoms; iAtm++)
+    for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+      atoms[iAtm].coord[iXYZ] = x[3*iAtm + iXYZ];
+
+    mol.setAtoms(atoms);
+    basis.updateCenters(mol);
+
+    aoints.clearGeometry();
+    ss.clearGeometry();
+
+    aoints.computeCoreHam();
+    if(aoints.cAlg == INCORE) aoints.computeERI();
+
+  }; // SetGeometry
+
+
+  /**
+   *  \brief Print a nuclear gradient.
+   *
+   *  \param [in] out   Output stream
+   *  \param [in] mol   Molecule for which the gradient was evaluated
+   *  \param [in] grad  Gradient, stored (x,y,z) for each atom
+   */ 
+  void printGradient(std::ostream &out, Molecule &mol, 
+    const std::vector<double> &grad) {
+
+    out << std::endl << "  Nuclear Gradient (Eh / Bohr):" << std::endl;
+    out << BannerMid << std::endl;
+    out << "    " << std::setw(10) << std::left << "Atom";
+    out << std::right << std::setw(20) << "dE/dX";
+    out << std::right << std::setw(20) << "dE/dY";
+    out << std::right << std::setw(20) << "dE/dZ";
+    out << std::endl << std::endl;
+
+    out << std::scientific << std::setprecision(10);
+    for(auto iAtm = 0; iAtm < mol.nAtoms; iAtm++) {
+      out << "    " << std::setw(10) << std::left << iAtm << std::right;
+      for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+        out << std::setw(20) << grad[3*iAtm + iXYZ];
+      out << std::endl;
+    }
+    out << std::endl;
+
+  }; // printGradient
+
+
+  /**
+   *  \brief Optimize the nuclear geometry with a quasi-Newton (BFGS)
+   *  procedure in Cartesian coordinates.
+   *
+   *  The SCF at each new geometry is started from the converged density
+   *  of the previous geometry. The step is restricted to 
+   *  GeomOptControls::maxStep, and is halved (and the inverse Hessian
+   *  reset) if the energy rises.
+   *
+   *  The optimized geometry, its gradient and energy are saved to the
+   *  checkpoint file (GEOMOPT/*) if one is attached.
+   *
+   *  \warning Assumes the integrals and an initial guess have been 
+   *  formed for the starting geometry.
+   */ 
+  void OptimizeGeometry(std::ostream &out, GeomOptControls &ctl, 
+    Molecule &mol, BasisSet &basis, AOIntegrals &aoints, SingleSlaterBase &ss,
+    EMPerturbation &pert) {
+
+    if( pert.fields.size() > 0 )
+      CErr("Geometry optimization with an EM perturbation NYI",out);
+
+    const size_t N = 3*mol.nAtoms;
+
+    auto setGeometry = [&](const std::vector<double> &x) {
+      SetGeometry(x,mol,basis,aoints,ss);
+    };
+
+    // SCF energy and gradient at the current geometry 
+    auto energyGradient = [&](std::vector<double> &g) -> double {
+
+      ss.SCF(pert);
+      g = ss.computeGradient();
+      return ss.totalEnergy;
+
+    };
+
+    // Inverse Hessian guess
+    std::vector<double> HInv(N*N,0.);
+    auto resetHessian = [&]() {
+      std::fill(HInv.begin(),HInv.end(),0.);
+      for(auto i = 0; i < N; i++) HInv[i*(N+1)] = 1. / ctl.hessGuess;
+    };
+    resetHessian();
+
+    std::vector<double> x(N), g, xPrev, gPrev, step(N);
+    for(auto iAtm = 0; iAtm < mol.nAtoms; iAtm++)
+    for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+      x[3*iAtm + iXYZ] = mol.atoms[iAtm].coord[iXYZ];
+
+    double E = energyGradient(g), EPrev;
+    bool isConverged = false;
+
+    for(size_t iter = 0; ; iter++) {
+
+      double gMax = 0., gRMS = 0.;
+      for(auto &gi : g) { 
+        gMax = std::max(gMax,std::abs(gi)); gRMS += gi * gi; 
+      }
+      gRMS = std::sqrt(gRMS / N);
+
+      out << std::endl << BannerTop << std::endl;
+      out << "  Geometry Step " << iter << ":" << std::endl << std::endl;
+      out << std::scientific << std::setprecision(10);
+      out << "    " << std::setw(24) << std::left << "Energy (Eh):" 
+          << E << std::endl;
+      out << "    " << std::setw(24) << std::left << "Max |Gradient|:" 
+          << gMax << std::endl;
+      out << "    " << std::setw(24) << std::left << "RMS Gradient:" 
+          << gRMS << std::endl;
+      printGradient(out,mol,g);
+      out << BannerEnd << std::endl;
+
+      if( gMax < ctl.gradTol and gRMS < ctl.rmsGradTol ) {
+        isConverged = true; break;
+      }
+
+      if( iter == ctl.maxIter ) break;
+
+      // BFGS update of the inverse Hessian
+      if( iter > 0 ) {
+
+        std::vector<double> s(N), y(N), Hy(N,0.);
+        double sy = 0., yHy = 0.;
+        for(auto i = 0; i < N; i++) {
+          s[i] = x[i] - xPrev[i]; y[i] = g[i] - gPrev[i]; sy += s[i] * y[i];
+        }
+
+        // Skip the update if the curvature condition is violated
+        if( sy > 1e-10 ) {
+
+          for(auto j = 0; j < N; j++)
+          for(auto i = 0; i < N; i++) Hy[i] += HInv[i + j*N] * y[j];
+          for(auto i = 0; i < N; i++) yHy += y[i] * Hy[i];
+
+          for(auto j = 0; j < N; j++)
+          for(auto i = 0; i < N; i++)
+            HInv[i + j*N] += (sy + yHy) * s[i] * s[j] / (sy * sy) - 
+              (Hy[i] * s[j] + s[i] * Hy[j]) / sy;
+
+        }
+
+      }
+
+      // Quasi-Newton step restricted to the max step length
+      double stepNorm = 0.;
+      for(auto i = 0; i < N; i++) {
+        step[i] = 0.;
+        for(auto j = 0; j < N; j++) step[i] -= HInv[i + j*N] * g[j];
+        stepNorm += step[i] * step[i];
+      }
+      stepNorm = std::sqrt(stepNorm);
+
+      if( stepNorm > ctl.maxStep )
+        for(auto &si : step) si *= ctl.maxStep / stepNorm;
+
+      xPrev = x; gPrev = g; EPrev = E;
+
+      for(auto i = 0; i < N; i++) x[i] += step[i];
+      setGeometry(x);
+      E = energyGradient(g);
+
+      // Backtrack along the step if the energy rose
+      for(auto iHalf = 0; iHalf < 4 and E > EPrev; iHalf++) {
+
+        out << std::endl << "  *** Energy increased, halving the step ***" 
+            << std::endl;
+
+        resetHessian();
+        for(auto i = 0; i < N; i++) x[i] = 0.5 * (x[i] + xPrev[i]);
+        setGeometry(x);
+        E = energyGradient(g);
+
+      }
+
+    }
+
+    if( not isConverged )
+      CErr(std::string("Geometry optimization failed to converge within ") +
+        std::to_string(ctl.maxIter) + std::string(" steps"));
+
+    out << std::endl << "Geometry Optimization Completed: E = " 
+        << std::fixed << std::setprecision(10) << E << " Eh" << std::endl;
+    out << mol << std::endl;
+
+    // Save the optimized geometry and its gradient
+    if( ss.savFile.exists() ) {
+      ss.savFile.safeWriteData("GEOMOPT/GEOMETRY",&x[0],{mol.nAtoms,3});
+      ss.savFile.safeWriteData("GEOMOPT/GRADIENT",&g[0],{mol.nAtoms,3});
+      ss.savFile.safeWriteData("GEOMOPT/ENERGY",&E,{1});
+    }
+
+  }; // OptimizeGeometry
+
+}; // namespace ChronusQ
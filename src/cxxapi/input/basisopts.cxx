@@ -22,6 +22,7 @@
  *  
  */
 #include <cxxapi/options.hpp>
+#include <basisset/reference.hpp>
 #include <cerr.hpp>
 
 namespace ChronusQ {
@@ -42,6 +43,13 @@ namespace ChronusQ {
     bool forceCart(false);
     OPTOPT( forceCart = input.getData<bool>("BASIS.FORCECART"); );
 
+    // Determine if we're using a binary basis cache (the cache directory
+    // is not carried over from a previous job)
+    ReferenceBasisSet::cacheDir = "";
+    OPTOPT(
+      ReferenceBasisSet::cacheDir = input.getData<std::string>("BASIS.CACHE");
+    );
+
     // Find the Basis File
     std::string basisName;
     try {
@@ -53,6 +61,11 @@ namespace ChronusQ {
     // Construct the BasisSet object
     BasisSet basis(basisName,mol,forceCart);
 
+    // Determine if we're reordering the shells for spatial locality
+    bool reorder(false);
+    OPTOPT( reorder = input.getData<bool>("BASIS.REORDER"); );
+    if( reorder ) basis.reorderShells();
+
     // Ouput BasisSet information
     out << basis << std::endl;
 
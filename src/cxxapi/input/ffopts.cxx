@@ -0,0 +1,56 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <cxxapi/options.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Parse the options relating to finite field properties
+   *  (FF section, optional).
+   */ 
+  FiniteFieldControls CQFiniteFieldOptions(std::ostream &out, 
+    CQInputFile &input) {
+
+    FiniteFieldControls ctl;
+
+    if( not input.containsSection("FF") ) return ctl;
+
+    // Field strength
+    OPTOPT( ctl.field = input.getData<double>("FF.FIELD"); )
+
+    // Number of SCFs in the stencil
+    OPTOPT( ctl.nPoint = input.getData<size_t>("FF.NPOINT"); )
+
+    if( ctl.field <= 0. )
+      CErr("FF.FIELD must be positive",out);
+
+    if( ctl.nPoint != 7 and ctl.nPoint != 13 )
+      CErr("FF.NPOINT must be 7 or 13",out);
+
+    return ctl;
+
+  }; // CQFiniteFieldOptions
+
+}; // namespace ChronusQ
@@ -0,0 +1,57 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <cxxapi/options.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Parse the options relating to geometry optimization
+   *  (GEOMOPT section, optional).
+   */ 
+  GeomOptControls CQGeomOptOptions(std::ostream &out, CQInputFile &input) {
+
+    GeomOptControls ctl;
+
+    if( not input.containsSection("GEOMOPT") ) return ctl;
+
+    // Maximum geometry steps
+    OPTOPT( ctl.maxIter = input.getData<size_t>("GEOMOPT.MAXITER"); )
+
+    // Convergence criteria
+    OPTOPT( ctl.gradTol = input.getData<double>("GEOMOPT.GRADTOL"); )
+    OPTOPT( ctl.rmsGradTol = input.getData<double>("GEOMOPT.RMSGRADTOL"); )
+
+    // Step control
+    OPTOPT( ctl.maxStep = input.getData<double>("GEOMOPT.MAXSTEP"); )
+    OPTOPT( ctl.hessGuess = input.getData<double>("GEOMOPT.HESSGUESS"); )
+
+    if( ctl.maxStep <= 0. or ctl.hessGuess <= 0. )
+      CErr("GEOMOPT.MAXSTEP and GEOMOPT.HESSGUESS must be positive",out);
+
+    return ctl;
+
+  }; // CQGeomOptOptions
+
+}; // namespace ChronusQ
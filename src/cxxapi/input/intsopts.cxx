@@ -54,6 +54,35 @@ namespace ChronusQ {
     // Parse Schwartz threshold
     OPTOPT( aoi.threshSchwartz = input.getData<double>("INTS.SCHWARTZ"); )
 
+    // Parse shell pair (overlap extent) screening threshold
+    OPTOPT( aoi.threshOneE = input.getData<double>("INTS.PAIRSCREEN"); )
+
+    // Parse far-field ratio for the nuclear potential
+    OPTOPT( aoi.nucFarField = input.getData<double>("INTS.FARFIELD"); )
+
+    // Parse node-shared integral storage
+    OPTOPT( aoi.sharedMem = input.getData<bool>("INTS.SHAREDMEM"); )
+
+    // Parse compressed storage of the in-core ERIs
+    std::string ERICOMP = "NONE";
+    OPTOPT( ERICOMP = input.getData<std::string>("INTS.ERICOMPRESS"); )
+    trim(ERICOMP);
+
+    if( not ERICOMP.compare("NONE") )
+      aoi.eriCompress = ERI_FULL;
+    else if( not ERICOMP.compare("FLOAT") )
+      aoi.eriCompress = ERI_FLOAT32;
+    else if( not ERICOMP.compare("QUANTIZE") )
+      aoi.eriCompress = ERI_QUANTIZED;
+    else
+      CErr(ERICOMP + " not a valid INTS.ERICOMPRESS",out);
+
+    OPTOPT( aoi.eriCompressTol = 
+              input.getData<double>("INTS.ERICOMPRESSTOL"); )
+
+    // Parse ERI screening statistics collection
+    OPTOPT( aoi.collectERIStats = input.getData<bool>("INTS.STATS"); )
+
     out << aoi << std::endl;
 
   }; // CQIntsOptions
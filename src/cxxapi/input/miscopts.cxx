@@ -83,11 +83,57 @@ namespace ChronusQ {
       SetNumThreads(input.getData<size_t>("MISC.NSMP"));
     )
 
+    // Thread placement
+    std::string bindStr;
+    OPTOPT( bindStr = input.getData<std::string>("MISC.THREADBIND"); )
+    trim(bindStr);
+
+    if( not bindStr.empty() ) {
+      if( not bindStr.compare("NONE") )        SetThreadBinding(BIND_NONE);
+      else if( not bindStr.compare("CLOSE") )  SetThreadBinding(BIND_CLOSE);
+      else if( not bindStr.compare("SPREAD") ) SetThreadBinding(BIND_SPREAD);
+      else CErr(bindStr + " not a valid MISC.THREADBIND",out);
+    }
+
+    // Thread teams for nested parallelism (integer or SOCKET)
+    std::string teamStr;
+    OPTOPT( teamStr = input.getData<std::string>("MISC.THREADTEAMS"); )
+    trim(teamStr);
+
+    if( not teamStr.empty() ) {
+
+      size_t nTeams = 0;
+      if( not teamStr.compare("SOCKET") ) nTeams = GetNumSockets();
+      else if( teamStr.find_first_not_of("0123456789") == std::string::npos )
+        nTeams = std::stoul(teamStr);
+
+      if( nTeams == 0 ) CErr(teamStr + " not a valid MISC.THREADTEAMS",out);
+
+#ifndef _CQ_MKL
+      if( nTeams > 1 ) 
+        CErr("MISC.THREADTEAMS > 1 requires thread-local BLAS threading (MKL)",
+          out);
+#endif
+
+      SetThreadTeams(nTeams);
+
+    }
+
     out << "\n\n";
 
     out << "  *** Allocating " << memPrint << " " << postfix << "B *** \n";
     out << "  *** ChronusQ will use " << GetNumThreads() 
-        << " OpenMP threads ***\n\n";
+        << " OpenMP threads ***\n";
+
+    if( GetThreadingModel().bind != BIND_NONE or GetNumTeams() > 1 ) {
+      out << "  *** Threads bound " 
+          << (GetThreadingModel().bind == BIND_CLOSE  ? "CLOSE"  :
+              GetThreadingModel().bind == BIND_SPREAD ? "SPREAD" : "NONE")
+          << " over " << GetNumSockets() << " socket(s) in " 
+          << GetNumTeams() << " team(s) ***\n";
+    }
+
+    out << "\n";
     out << "\n\n";
 
     return std::make_shared<CQMemManager>(mem,blkSize);
@@ -0,0 +1,89 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <cxxapi/options.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Parse the options relating to linear response
+   *  (RESPONSE section, optional).
+   */ 
+  ResponseControls CQResponseOptions(std::ostream &out, CQInputFile &input) {
+
+    ResponseControls ctl;
+
+    if( not input.containsSection("RESPONSE") ) return ctl;
+
+    // Frequencies (Eh)
+    std::string freqStr;
+    OPTOPT( freqStr = input.getData<std::string>("RESPONSE.FREQ"); )
+
+    if( not freqStr.empty() ) {
+
+      std::vector<std::string> tokens;
+      split(tokens,freqStr);
+
+      ctl.freq.clear();
+      for(auto &X : tokens) {
+        trim(X);
+        if( X.empty() ) continue;
+        ctl.freq.emplace_back(std::stod(X));
+      }
+
+      if( ctl.freq.empty() ) 
+        CErr("RESPONSE.FREQ must contain at least one frequency",out);
+
+    }
+
+    bool isStatic = std::all_of(ctl.freq.begin(),ctl.freq.end(),
+      [](double w){ return std::abs(w) < 1e-12; });
+
+    // Krylov solver (CG for static, MINRES otherwise by default)
+    ctl.alg = isStatic ? KRYLOV_CG : KRYLOV_MINRES;
+
+    std::string solverStr;
+    OPTOPT( solverStr = input.getData<std::string>("RESPONSE.SOLVER"); )
+
+    if( not solverStr.compare("CG") )          ctl.alg = KRYLOV_CG;
+    else if( not solverStr.compare("MINRES") ) ctl.alg = KRYLOV_MINRES;
+    else if( not solverStr.compare("GMRES") )  ctl.alg = KRYLOV_GMRES;
+    else if( not solverStr.empty() )
+      CErr(solverStr + " not a valid RESPONSE.SOLVER",out);
+
+    if( ctl.alg == KRYLOV_CG and not isStatic )
+      CErr("RESPONSE.SOLVER = CG is only valid for static response",out);
+
+    // Convergence controls
+    OPTOPT( ctl.convTol = input.getData<double>("RESPONSE.CONVTOL"); )
+    OPTOPT( ctl.maxIter = input.getData<size_t>("RESPONSE.MAXITER"); )
+
+    if( ctl.convTol <= 0. or ctl.maxIter == 0 )
+      CErr("RESPONSE.CONVTOL and RESPONSE.MAXITER must be positive",out);
+
+    return ctl;
+
+  }; // CQResponseOptions
+
+}; // namespace ChronusQ
@@ -50,6 +50,25 @@ namespace ChronusQ {
 
     std::shared_ptr<RealTimeBase> rt;
 
+    // Incremental VXC controls must be set on the reference prior to the
+    // construction of the propagator
+    IntegrationParam *intParam = nullptr;
+    if( auto ks = std::dynamic_pointer_cast<KohnSham<double>>(ss) )
+      intParam = &ks->intParam;
+    else if( auto ks = std::dynamic_pointer_cast<KohnSham<dcomplex>>(ss) )
+      intParam = &ks->intParam;
+
+    if( intParam ) {
+
+      OPTOPT( intParam->incXCTol = input.getData<double>("RT.XCINCTOL"); )
+      OPTOPT( intParam->nIncXCRebuild = input.getData<size_t>("RT.XCREBUILD"); )
+      OPTOPT( intParam->incXCMem = input.getData<size_t>("RT.XCINCMEM"); )
+
+      if( intParam->incXCTol > 0. and intParam->nIncXCRebuild == 0 )
+        CErr("RT.XCREBUILD must be > 0",out);
+
+    }
+
   
     // Determine  reference and construct RT object
       
@@ -113,6 +132,43 @@ namespace ChronusQ {
       rt->intScheme.iRstrt = input.getData<size_t>("RT.IRSTRT");
     )
 
+    // Orbital (occupied space) propagation
+    OPTOPT(
+      rt->intScheme.orbitalProp = input.getData<bool>("RT.ORBITAL");
+    )
+
+    // Matrix exponential algorithm
+    std::string expAlg = "DIAG";
+    OPTOPT( expAlg = input.getData<std::string>("RT.EXPALG"); )
+    trim(expAlg);
+
+    if( not expAlg.compare("DIAG") )
+      rt->intScheme.prpAlg = Diagonalization;
+    else if( not expAlg.compare("TAYLOR") )
+      rt->intScheme.prpAlg = TaylorExpansion;
+    else
+      CErr(expAlg + " not a valid RT.EXPALG",out);
+
+    if( rt->intScheme.prpAlg == TaylorExpansion and 
+        not rt->intScheme.orbitalProp )
+      CErr("RT.EXPALG = TAYLOR requires RT.ORBITAL = TRUE",out);
+
+    // Cube output at selected steps
+    OPTOPT(
+      std::string stepStr = input.getData<std::string>("RT.CUBESTEPS");
+      std::vector<std::string> tokens;
+      split(tokens,stepStr);
+
+      for(auto &X : tokens) {
+        trim(X);
+        if( not X.empty() ) rt->intScheme.cubeSteps.emplace_back(std::stoul(X));
+      }
+    )
+
+    OPTOPT(
+      rt->intScheme.cubeSpacing = input.getData<double>("RT.CUBESPACING");
+    )
+
     // Handle field specification
     try {
 
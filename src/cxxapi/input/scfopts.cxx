@@ -66,6 +66,8 @@ namespace ChronusQ {
         ss.scfControls.guess = SAD;
       else if( not guessString.compare("RANDOM") )
         ss.scfControls.guess = RANDOM;
+      else if( not guessString.compare("SAP") )
+        ss.scfControls.guess = SAP;
     )
 
 
@@ -105,6 +107,93 @@ namespace ChronusQ {
     );
 
 
+    // Level shift options
+    OPTOPT(
+      ss.scfControls.levelShift = input.getData<double>("SCF.LEVELSHIFT");
+    );
+
+    OPTOPT(
+      ss.scfControls.levelShiftTol = 
+        input.getData<double>("SCF.LEVELSHIFTTOL");
+    );
+
+
+    // Two-component collinearity detection
+    OPTOPT(
+      ss.scfControls.collinearTol = 
+        input.getData<double>("SCF.COLLINEARTOL");
+    );
+
+
+    // Pseudo-diagonalization options
+    OPTOPT(
+      ss.scfControls.pseudoDiagTol = 
+        input.getData<double>("SCF.PSEUDODIAGTOL");
+    );
+
+    OPTOPT(
+      ss.scfControls.nPseudoDiag = input.getData<size_t>("SCF.NPSEUDODIAG");
+    );
+
+
+    // Smearing options
+    std::string smearString;
+    OPTOPT( smearString = input.getData<std::string>("SCF.SMEARING"); )
+    trim(smearString);
+
+    if( not smearString.compare("FERMI") )
+      ss.scfControls.smearType = FERMI_SMEARING;
+    else if( not smearString.compare("GAUSSIAN") )
+      ss.scfControls.smearType = GAUSSIAN_SMEARING;
+    else if( not smearString.empty() and smearString.compare("NONE") )
+      CErr(smearString + " not a valid SCF.SMEARING option",out);
+
+    OPTOPT(
+      ss.scfControls.smearTemp = input.getData<double>("SCF.SMEARTEMP");
+    );
+
+    OPTOPT(
+      ss.scfControls.smearTol = input.getData<double>("SCF.SMEARTOL");
+    );
+
+    if( ss.scfControls.levelShift < 0. )
+      CErr("SCF.LEVELSHIFT must be non-negative",out);
+
+    if( ss.scfControls.pseudoDiagTol > 0. and ss.scfControls.nPseudoDiag == 0 )
+      CErr("SCF.NPSEUDODIAG must be positive",out);
+
+    if( ss.scfControls.smearType != NO_SMEARING and 
+        ss.scfControls.smearTemp <= 0. )
+      CErr("SCF.SMEARTEMP must be positive",out);
+
+
+    // Cube output
+    OPTOPT(
+      ss.scfControls.cubeOutput = input.getData<bool>("SCF.CUBE");
+    );
+
+    OPTOPT(
+      ss.scfControls.cubeSpacing = input.getData<double>("SCF.CUBESPACING");
+    );
+
+    OPTOPT(
+      std::string moStr = input.getData<std::string>("SCF.CUBEMOS");
+      std::vector<std::string> tokens;
+      split(tokens,moStr);
+
+      // Input MO indices are 1-based
+      for(auto &X : tokens) {
+        trim(X);
+        if( X.empty() ) continue;
+        size_t iMO = std::stoul(X);
+        if( iMO == 0 ) CErr("SCF.CUBEMOS are 1-based",out);
+        ss.scfControls.cubeMOs.emplace_back(iMO - 1);
+      }
+
+      ss.scfControls.cubeOutput = true;
+    );
+
+
     // SCF Field
     auto handleField = [&]() {
       std::string fieldStr;
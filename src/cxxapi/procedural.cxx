@@ -116,6 +116,73 @@ namespace ChronusQ {
 
       ss->formGuess();
       ss->SCF(SCFpert);
+
+      if( ss->scfControls.cubeOutput )
+        ss->writeCube(rstFileName.substr(0,rstFileName.rfind('.')) + "_scf",
+          MoleculeCubeGrid(mol,ss->scfControls.cubeSpacing),
+          ss->scfControls.cubeMOs);
+    }
+
+    if( not jobType.compare("GRAD") or not jobType.compare("OPT") ) {
+
+      aoints.computeCoreHam();
+
+      // If INCORE, compute and store the ERIs
+      if(aoints.cAlg == INCORE) aoints.computeERI();
+
+      ss->formGuess();
+
+      if( not jobType.compare("GRAD") ) {
+
+        ss->SCF(SCFpert);
+
+        auto grad = ss->computeGradient();
+        printGradient(std::cout,mol,grad);
+        rstFile.safeWriteData("GRAD/GRADIENT",&grad[0],{mol.nAtoms,3});
+
+      } else {
+
+        auto geomCtl = CQGeomOptOptions(std::cout,input);
+        OptimizeGeometry(std::cout,geomCtl,mol,basis,aoints,*ss,SCFpert);
+
+      }
+
+    }
+
+    if( not jobType.compare("RESP") ) {
+
+      // Parse the response options before the SCF to catch input errors
+      auto respCtl = CQResponseOptions(std::cout,input);
+
+      aoints.computeCoreHam();
+
+      // If INCORE, compute and store the ERIs
+      if(aoints.cAlg == INCORE) aoints.computeERI();
+
+      ss->formGuess();
+      ss->SCF(SCFpert);
+
+      auto alpha = ss->computePolarizability(respCtl);
+
+      // alpha_ij(w) stored [iFreq][j][i]
+      size_t nFreq = respCtl.freq.size();
+      rstFile.safeWriteData("RESP/FREQ",&respCtl.freq[0],{nFreq});
+      rstFile.safeWriteData("RESP/ALPHA",&alpha[0],{nFreq,3,3});
+
+    }
+
+    if( not jobType.compare("FF") ) {
+
+      aoints.computeCoreHam();
+
+      // If INCORE, compute and store the ERIs
+      if(aoints.cAlg == INCORE) aoints.computeERI();
+
+      ss->formGuess();
+
+      auto ffCtl = CQFiniteFieldOptions(std::cout,input);
+      FiniteFieldProperties(std::cout,ffCtl,*ss,SCFpert);
+
     }
 
     if( not jobType.compare("RT") ) {
@@ -0,0 +1,222 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <cxxapi/session.hpp>
+#include <cxxapi/options.hpp>
+#include <cxxapi/output.hpp>
+#include <cxxapi/boilerplate.hpp>
+#include <cxxapi/geomopt.hpp>
+
+#include <realtime.hpp>
+#include <util/files.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Construct a session from a ChronusQ input file.
+   *
+   *  Initializes the ChronusQ environment (once per process) and parses
+   *  the MISC, MOLECULE, BASIS, QM, SCF and INTS sections of the input 
+   *  file. QM.JOB is ignored, the calculations are driven through the 
+   *  run* methods.
+   *
+   *  \param [in] inFileName  Name of CQ input file
+   *  \param [in] outFileName Name of output file (STDOUT for std::cout)
+   *  \param [in] rstFileName Name of restart file (empty for none)
+   */ 
+  CQSession::CQSession(std::string inFileName, std::string outFileName,
+    std::string rstFileName) {
+
+    ChronusQ::initialize();
+
+    // Redirect output to output file if not STDOUT
+    if( outFileName.compare("STDOUT") ) {
+      outFile_ = std::make_shared<std::ofstream>(outFileName);
+      coutBuf_ = std::cout.rdbuf();
+      std::cout.rdbuf(outFile_->rdbuf());
+    }
+
+    CQOutputHeader(std::cout);
+
+    input_      = std::make_shared<CQInputFile>(inFileName);
+    memManager_ = CQMiscOptions(std::cout,*input_);
+
+    // Create Molecule and BasisSet objects
+    mol_   = std::make_shared<Molecule>(
+      std::move(CQMoleculeOptions(std::cout,*input_)));
+    basis_ = std::make_shared<BasisSet>(
+      std::move(CQBasisSetOptions(std::cout,*input_,*mol_)));
+
+    aoints_ = std::make_shared<AOIntegrals>(*memManager_,*mol_,*basis_);
+    ss_     = CQSingleSlaterOptions(std::cout,*input_,*aoints_);
+
+    if( not rstFileName.empty() ) {
+      SafeFile rstFile(rstFileName);
+      rstFile.createFile();
+
+      ss_->savFile     = rstFile;
+      aoints_->savFile = rstFile;
+    }
+
+    CQSCFOptions(std::cout,*input_,*ss_,pert_);
+    CQIntsOptions(std::cout,*input_,*aoints_);
+
+  }; // CQSession::CQSession
+
+
+
+  /**
+   *  Destructs a session. Restores std::cout if it was redirected.
+   *
+   *  \warning Does not finalize the ChronusQ environment 
+   *  (ChronusQ::finalize) as it may be shared with other sessions.
+   */ 
+  CQSession::~CQSession() {
+
+    // Free the integrals and wave function before the memory pool
+    ss_     = nullptr;
+    aoints_ = nullptr;
+
+    CQOutputFooter(std::cout);
+
+    if( coutBuf_ ) std::cout.rdbuf(coutBuf_);
+
+  }; // CQSession::~CQSession
+
+
+
+  /**
+   *  \brief Compute the core Hamiltonian (and the ERIs if INCORE) for the
+   *  current geometry if they are not current.
+   */ 
+  void CQSession::computeIntegrals() {
+
+    if( intsValid_ ) return;
+
+    aoints_->computeCoreHam();
+
+    // If INCORE, compute and store the ERIs
+    if(aoints_->cAlg == INCORE) aoints_->computeERI();
+
+    intsValid_ = true;
+
+  }; // CQSession::computeIntegrals
+
+
+
+  /**
+   *  \brief Move the nuclei. The density of the previous run is kept as
+   *  the starting point of the next SCF.
+   *
+   *  \param [in] x Nuclear coordinates (Bohr), (x,y,z) per atom
+   */ 
+  void CQSession::setGeometry(const std::vector<double> &x) {
+
+    SetGeometry(x,*mol_,*basis_,*aoints_,*ss_);
+    intsValid_ = true;
+
+  }; // CQSession::setGeometry
+
+
+
+  /**
+   *  \brief Replace the EM perturbation with a static electric dipole 
+   *  field.
+   *
+   *  \param [in] field Electric field (a.u.)
+   */ 
+  void CQSession::setField(const cart_t &field) {
+
+    clearField();
+    pert_.addField(Electric,field);
+
+  }; // CQSession::setField
+
+
+  /**
+   *  \brief Remove all fields from the EM perturbation.
+   */ 
+  void CQSession::clearField() { pert_.fields.clear(); }
+
+
+  /**
+   *  \brief Discard the density of the previous run, the next SCF
+   *  starts from the guess specified in the input (SCF.GUESS).
+   */ 
+  void CQSession::resetGuess() { hasGuess_ = false; }
+
+
+
+  /**
+   *  \brief Perform an SCF at the current geometry and field.
+   *
+   *  The guess is only formed on the first run (or after resetGuess),
+   *  subsequent runs start from the previous density.
+   *
+   *  \returns The SCF total energy (Eh)
+   */ 
+  double CQSession::runSCF() {
+
+    computeIntegrals();
+
+    if( not hasGuess_ ) { ss_->formGuess(); hasGuess_ = true; }
+
+    ss_->SCF(pert_);
+
+    return ss_->totalEnergy;
+
+  }; // CQSession::runSCF
+
+
+
+  /**
+   *  \brief Perform an SCF and evaluate the nuclear gradient at the
+   *  current geometry.
+   *
+   *  \returns The gradient (Eh / Bohr), (x,y,z) per atom
+   */ 
+  std::vector<double> CQSession::runGradient() {
+
+    runSCF();
+    return ss_->computeGradient();
+
+  }; // CQSession::runGradient
+
+
+
+  /**
+   *  \brief Perform an SCF followed by the real-time propagation
+   *  specified in the RT section of the input file.
+   */ 
+  void CQSession::runRT() {
+
+    runSCF();
+
+    auto rt = CQRealTimeOptions(std::cout,*input_,ss_);
+    rt->savFile = ss_->savFile;
+    rt->doPropagation();
+
+  }; // CQSession::runRT
+
+}; // namespace ChronusQ
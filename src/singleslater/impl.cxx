@@ -44,4 +44,10 @@ namespace ChronusQ {
   // Instantiate copy ructors
   template KohnSham<dcomplex>::KohnSham( KohnSham<double> &&, int);
 
+  // Instantiate lockstep SCF
+  template void LockstepSCF(std::vector<SingleSlater<double>*> &,
+    std::vector<EMPerturbation> &);
+  template void LockstepSCF(std::vector<SingleSlater<dcomplex>*> &,
+    std::vector<EMPerturbation> &);
+
 }; // namespace ChronusQ
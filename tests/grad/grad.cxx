@@ -0,0 +1,79 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include "grad.hpp"
+
+BOOST_AUTO_TEST_SUITE( GRAD )
+
+// Water RHF/6-31G(d) analytic gradient vs finite differences
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_RHF_FD, SerialJob ) {
+
+  CQGradFDTest("grad/serial/water_6-31Gd_rhf",1e-3,1e-5);
+
+};
+
+// Water RBLYP/6-31G(d) (GGA) analytic gradient vs finite differences.
+// The looser tolerance accounts for the neglected grid weight derivatives
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_BLYP_FD, SerialJob ) {
+
+  CQGradFDTest("grad/serial/water_6-31Gd_blyp",1e-3,1e-4);
+
+};
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE( GEOMOPT )
+
+// Water RHF/6-31G(d) geometry optimization from the SCF test geometry
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_RHF_OPT, SerialJob ) {
+
+  RunChronusQ(TEST_ROOT "grad/serial/water_6-31Gd_rhf_opt.inp","STDOUT",
+    TEST_OUT "grad/serial/water_6-31Gd_rhf_opt.bin",
+    TEST_OUT "grad/serial/water_6-31Gd_rhf_opt.scr");
+
+  SafeFile refFile(SCF_TEST_REF "water_6-31Gd.bin.ref",true);
+  SafeFile resFile(TEST_OUT "grad/serial/water_6-31Gd_rhf_opt.bin",true);
+
+  // The optimized gradient satisfies the default convergence criteria
+  std::array<double,9> grad;
+  resFile.readData("GEOMOPT/GRADIENT",&grad[0]);
+  for(auto i = 0; i < 9; i++)
+    BOOST_CHECK_MESSAGE(std::abs(grad[i]) < 4.5e-4, 
+      "GRADIENT TEST FAILED I = " << i << " " << std::abs(grad[i]) );
+
+  // The optimized energy does not lie above the energy of the starting 
+  // geometry and agrees with the final SCF
+  double EStart, EOpt, ESCF;
+  refFile.readData("SCF/TOTAL_ENERGY",&EStart);
+  resFile.readData("GEOMOPT/ENERGY",&EOpt);
+  resFile.readData("SCF/TOTAL_ENERGY",&ESCF);
+
+  BOOST_CHECK_MESSAGE(EOpt - EStart < 9e-10, 
+    "ENERGY LOWERING TEST FAILED " << (EOpt - EStart) );
+  BOOST_CHECK_MESSAGE(std::abs(EOpt - ESCF) < 9e-10, 
+    "ENERGY TEST FAILED " << std::abs(EOpt - ESCF) );
+
+};
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#ifndef __INCLUDED_TESTS_GRAD_HPP__
+#define __INCLUDED_TESTS_GRAD_HPP__
+
+#include <ut.hpp>
+
+#include <cxxapi/procedural.hpp>
+#include <cxxapi/input.hpp>
+#include <cxxapi/options.hpp>
+#include <cxxapi/geomopt.hpp>
+#include <util/files.hpp>
+
+#include <memmanager.hpp>
+#include <molecule.hpp>
+#include <basisset.hpp>
+#include <aointegrals.hpp>
+#include <singleslater.hpp>
+
+// Directory containing reference files
+#define SCF_TEST_REF TEST_ROOT "/scf/reference/"
+
+using namespace ChronusQ;
+
+
+/**
+ *  \brief Check the analytic gradient of a GRAD job against central
+ *  finite differences of the SCF energy.
+ *
+ *  The GRAD job is run through the driver (which saves GRAD/GRADIENT),
+ *  and the job is then rebuilt from the same input to evaluate the SCF
+ *  energies at the displaced geometries.
+ *
+ *  \param [in] in   Input file (relative to TEST_ROOT, without .inp)
+ *  \param [in] h    Displacement (Bohr)
+ *  \param [in] tol  Max absolute deviation of a gradient element
+ */ 
+inline void CQGradFDTest(const std::string &in, double h, double tol) {
+
+  RunChronusQ(TEST_ROOT + in + ".inp","STDOUT",
+    TEST_OUT + in + ".bin",TEST_OUT + in + ".scr");
+
+  SafeFile resFile(TEST_OUT + in + ".bin",true);
+
+
+  CQInputFile input(TEST_ROOT + in + ".inp");
+
+  auto memManager = CQMiscOptions(std::cout,input);
+
+  Molecule mol(std::move(CQMoleculeOptions(std::cout,input)));
+  BasisSet basis(std::move(CQBasisSetOptions(std::cout,input,mol)));
+
+  AOIntegrals aoints(*memManager,mol,basis);
+  auto ss = CQSingleSlaterOptions(std::cout,input,aoints);
+
+  EMPerturbation pert;
+  CQSCFOptions(std::cout,input,*ss,pert);
+  CQIntsOptions(std::cout,input,aoints);
+
+  aoints.computeCoreHam();
+  if(aoints.cAlg == INCORE) aoints.computeERI();
+
+  ss->formGuess();
+  ss->SCF(pert);
+
+
+  const size_t N = 3*mol.nAtoms;
+
+  std::vector<double> grad(N);
+  resFile.readData("GRAD/GRADIENT",&grad[0]);
+
+  // Translational invariance
+  for(auto iXYZ = 0; iXYZ < 3; iXYZ++) {
+    double sum = 0.;
+    for(auto iAtm = 0; iAtm < mol.nAtoms; iAtm++) sum += grad[3*iAtm + iXYZ];
+    BOOST_CHECK_MESSAGE(std::abs(sum) < tol, 
+      "TRANSLATIONAL INVARIANCE TEST FAILED IXYZ = " << iXYZ << " " 
+      << std::abs(sum) );
+  }
+
+  // Central finite differences
+  std::vector<double> x0(N);
+  for(auto iAtm = 0; iAtm < mol.nAtoms; iAtm++)
+  for(auto iXYZ = 0; iXYZ < 3; iXYZ++)
+    x0[3*iAtm + iXYZ] = mol.atoms[iAtm].coord[iXYZ];
+
+  for(auto i = 0; i < N; i++) {
+
+    std::vector<double> x(x0);
+
+    x[i] = x0[i] + h;
+    SetGeometry(x,mol,basis,aoints,*ss);
+    ss->SCF(pert);
+    double EPlus = ss->totalEnergy;
+
+    x[i] = x0[i] - h;
+    SetGeometry(x,mol,basis,aoints,*ss);
+    ss->SCF(pert);
+    double EMinus = ss->totalEnergy;
+
+    double gFD = (EPlus - EMinus) / (2. * h);
+
+    BOOST_CHECK_MESSAGE(std::abs(gFD - grad[i]) < tol, 
+      "FD GRADIENT TEST FAILED I = " << i << " " << std::abs(gFD - grad[i]) );
+
+  }
+
+}; // CQGradFDTest
+
+#endif
@@ -36,6 +36,24 @@ BOOST_FIXTURE_TEST_CASE( Water_631Gd_Delta_Y, SerialJob ) {
 
 }
 
+// Water 6-31G(d) Delta Spike (along Y) propagating the occupied orbitals
+// (same trajectory as the density propagation)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_Delta_Y_Orbital, SerialJob ) {
+
+  CQRTTEST( rt/serial/rrt/water_6-31Gd_rhf_delta_y_orbital,
+    water_6-31Gd_rhf_delta_y.bin.ref );
+
+}
+
+// Water 6-31G(d) Delta Spike (along Y) propagating the occupied orbitals
+// by Taylor expansion (same trajectory as the density propagation)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_Delta_Y_Taylor, SerialJob ) {
+
+  CQRTTEST( rt/serial/rrt/water_6-31Gd_rhf_delta_y_taylor,
+    water_6-31Gd_rhf_delta_y.bin.ref );
+
+}
+
 #ifdef _CQ_DO_PARTESTS
 
 // SMP Water 6-31G(d) Delta Spike (along Y)
@@ -72,6 +90,14 @@ BOOST_FIXTURE_TEST_CASE( Water_631Gd_B3LYP_Delta_Y, SerialJob ) {
 
 }
 
+// Water 6-31G(d) B3LYP Delta Spike (along Y) with incremental VXC builds
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_B3LYP_Delta_Y_XCInc, SerialJob ) {
+
+  CQRTTOLTEST( rt/serial/rrt/water_6-31Gd_rb3lyp_delta_y_xcinc,
+    water_6-31Gd_rb3lyp_delta_y.bin.ref, 1e-6 );
+
+}
+
 #ifdef _CQ_DO_PARTESTS
 
 // SMP Water 6-31G(d) B3LYP Delta Spike (along Y)
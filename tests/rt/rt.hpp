@@ -49,7 +49,14 @@ using namespace ChronusQ;
 #else
 
 // HTG RT test
-#define CQRTTEST( in, ref ) \
+#define CQRTTEST( in, ref ) CQRTTOLTEST( in, ref, 1e-9 )
+
+
+#endif
+
+// RT test against a reference within a tolerance (for approximate
+// propagations of a reference trajectory)
+#define CQRTTOLTEST( in, ref, tol ) \
   RunChronusQ(TEST_ROOT #in ".inp","STDOUT", \
     TEST_OUT #in ".bin",TEST_OUT #in ".scr");\
   \
@@ -78,18 +85,17 @@ using namespace ChronusQ;
   refFile.readData("/RT/ENERGY",&yDummy[0]);\
   \
   for(auto i = 0; i < energyDim1[0]; i++) \
-    BOOST_CHECK(std::abs(xDummy[i] - yDummy[i]) < 1e-9);\
+    BOOST_CHECK(std::abs(xDummy[i] - yDummy[i]) < tol);\
   \
   xDummy3.resize(dipoleDim1[0]); yDummy3.resize(dipoleDim1[0]);\
   resFile.readData("/RT/LEN_ELEC_DIPOLE",&xDummy3[0][0]);\
   refFile.readData("/RT/LEN_ELEC_DIPOLE",&yDummy3[0][0]);\
   \
   for(auto i = 0; i < energyDim1[0]; i++) {\
-    BOOST_CHECK(std::abs(xDummy3[i][0] - yDummy3[i][0]) < 1e-9);\
-    BOOST_CHECK(std::abs(xDummy3[i][1] - yDummy3[i][1]) < 1e-9);\
-    BOOST_CHECK(std::abs(xDummy3[i][2] - yDummy3[i][2]) < 1e-9);\
+    BOOST_CHECK(std::abs(xDummy3[i][0] - yDummy3[i][0]) < tol);\
+    BOOST_CHECK(std::abs(xDummy3[i][1] - yDummy3[i][1]) < tol);\
+    BOOST_CHECK(std::abs(xDummy3[i][2] - yDummy3[i][2]) < tol);\
   }
 
-#endif
 
 #endif
@@ -24,6 +24,46 @@
 
 #include "scf.hpp"
 
+#include <basisset/reference.hpp>
+#include <libint2/cxxapi.h>
+
+#include <utime.h>
+#include <dirent.h>
+#include <set>
+
+// Check that the converged spin densities of a (real, 1C) SCF job are
+// idempotent in the orthonormal basis, i.e. that the orbital occupations
+// are integral
+static void CQSCFIdempotentTest(const std::string &bin, bool iCS) {
+
+  SafeFile resFile(bin,true);
+
+  size_t NB = resFile.getDims("SCF/1PDM_ORTHO_SCALAR")[0];
+  std::vector<double> DS(NB*NB), DZ(NB*NB,0.);
+  resFile.readData("SCF/1PDM_ORTHO_SCALAR",&DS[0]);
+  if( not iCS ) resFile.readData("SCF/1PDM_ORTHO_MZ",&DZ[0]);
+
+  for(double sgn : {1., -1.}) {
+
+    // P = (DS +- DZ) / 2
+    std::vector<double> P(NB*NB);
+    for(auto j = 0; j < NB*NB; j++) P[j] = 0.5 * (DS[j] + sgn * DZ[j]);
+
+    double maxDiff = 0.;
+    for(auto i = 0; i < NB; i++)
+    for(auto j = 0; j < NB; j++) {
+      double PP = 0.;
+      for(auto k = 0; k < NB; k++) PP += P[i + k*NB] * P[k + j*NB];
+      maxDiff = std::max(maxDiff,std::abs(PP - P[i + j*NB]));
+    }
+
+    BOOST_CHECK_MESSAGE(maxDiff < 1e-6, 
+      "IDEMPOTENCY TEST FAILED " << maxDiff);
+
+  }
+
+}; // CQSCFIdempotentTest
+
 BOOST_AUTO_TEST_SUITE( MISC_SCF )
 
 // Water 6-31G(d) {0., 0.01, 0.} Electric Field test
@@ -57,4 +97,279 @@ BOOST_FIXTURE_TEST_CASE( O2_STO3G, SerialJob ) {
 
 };
 
+// Water 6-31G(d) SAP guess test (converges to the SAD guess result)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_SAP, SerialJob ) {
+
+  CQSCFTEST( scf/serial/rhf/water_6-31Gd_sap, water_6-31Gd.bin.ref );
+ 
+};
+
+// O2 6-31G(d) SAP guess test (converges to the SAD guess result)
+BOOST_FIXTURE_TEST_CASE( O2_631Gd_SAP, SerialJob ) {
+
+  CQSCFTEST( scf/serial/uhf/oxygen_6-31Gd_sap, oxygen_6-31Gd.bin.ref );
+
+};
+
+// Water 6-31G(d) quantized in-core ERIs (reproduces the uncompressed
+// energy within the compression error)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_ERI_Quantize, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_quantize, 
+    water_6-31Gd.bin.ref, 1e-7 );
+
+};
+
+// O2 6-31G(d) GHF (the triplet ground state is collinear and reproduces
+// the UHF energy)
+BOOST_FIXTURE_TEST_CASE( O2_631Gd_GHF, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/uhf/oxygen_6-31Gd_ghf, 
+    oxygen_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// O2 6-31G(d) GHF with collinearity detection (skipping the transverse
+// exchange must not change the energy)
+BOOST_FIXTURE_TEST_CASE( O2_631Gd_GHF_Collinear, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/uhf/oxygen_6-31Gd_ghf_collinear, 
+    oxygen_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// Water 6-31G(d) pseudo-diagonalization (converges to the full
+// diagonalization result)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_PseudoDiag, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_pseudodiag, 
+    water_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// O2 6-31G(d) pseudo-diagonalization (converges to the full
+// diagonalization result)
+BOOST_FIXTURE_TEST_CASE( O2_631Gd_PseudoDiag, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/uhf/oxygen_6-31Gd_pseudodiag, 
+    oxygen_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// Water 6-31G(d) level shift (converges to the unshifted result)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_LevelShift, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_levelshift, 
+    water_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// O2 6-31G(d) level shift (converges to the unshifted result)
+BOOST_FIXTURE_TEST_CASE( O2_631Gd_LevelShift, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/uhf/oxygen_6-31Gd_levelshift, 
+    oxygen_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// Water 6-31G(d) Fermi smearing (converges to the integer occupation
+// result)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_Smear, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_smear, 
+    water_6-31Gd.bin.ref, 1e-8 );
+
+  CQSCFIdempotentTest(TEST_OUT "scf/serial/rhf/water_6-31Gd_smear.bin",
+    true);
+
+};
+
+// O2 6-31G(d) Gaussian smearing (converges to the integer occupation
+// result)
+BOOST_FIXTURE_TEST_CASE( O2_631Gd_Smear, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/uhf/oxygen_6-31Gd_smear, 
+    oxygen_6-31Gd.bin.ref, 1e-8 );
+
+  CQSCFIdempotentTest(TEST_OUT "scf/serial/uhf/oxygen_6-31Gd_smear.bin",
+    false);
+
+};
+
+// Water 6-31G(d) far-field nuclear potential (reproduces the exact
+// nuclear potential result)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_FarField, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_farfield, 
+    water_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// Water 6-31G(d) with the basis in general contraction form (spans the
+// same functions as the segmented basis)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_GenCont, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_gc, 
+    water_6-31Gd.bin.ref, 1e-8 );
+
+};
+
+// Water 6-31G(d) with the shells reordered along a Hilbert curve (the
+// checkpointed AO density is in the input ordering)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_Reorder, SerialJob ) {
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_reorder, 
+    water_6-31Gd.bin.ref, 1e-8 );
+
+  size_t NB = refFile.getDims("SCF/1PDM_SCALAR")[0];
+  BOOST_CHECK( resFile.getDims("SCF/1PDM_SCALAR")[0] == NB );
+
+  std::vector<double> xDen(NB*NB), yDen(NB*NB);
+  refFile.readData("SCF/1PDM_SCALAR",&xDen[0]);
+  resFile.readData("SCF/1PDM_SCALAR",&yDen[0]);
+
+  double maxDiff = 0.;
+  for(auto j = 0; j < NB*NB; j++)
+    maxDiff = std::max(maxDiff,std::abs(yDen[j] - xDen[j]));
+
+  BOOST_CHECK_MESSAGE(maxDiff < 1e-6, "DENSITY TEST FAILED " << maxDiff);
+
+};
+
+// Water 6-31G(d) with the binary basis cache (BASIS.CACHE): a job which
+// loads the basis from the cache gives the same energy as one which parses
+// the basis file
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_BasisCache, SerialJob ) {
+
+  std::array<std::string,3> bin = {
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_nocache.bin",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_cache_1.bin",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_cache_2.bin"
+  };
+
+  // Uncached, first (cache is written) and second (cache is read) jobs.
+  // The in-process registry is cleared so that each job constructs the
+  // reference basis anew
+  for(auto i = 0; i < 3; i++) {
+    ReferenceBasisSet::clearRegistry();
+    RunChronusQ(i == 0 ? TEST_ROOT "scf/serial/rhf/water_6-31Gd.inp" :
+      TEST_ROOT "scf/serial/rhf/water_6-31Gd_cache.inp","STDOUT",
+      bin[i],TEST_OUT "scf/serial/rhf/water_6-31Gd_cache.scr");
+  }
+
+  std::array<double,3> E;
+  for(auto i = 0; i < 3; i++)
+    SafeFile(bin[i],true).readData("SCF/TOTAL_ENERGY",&E[i]);
+
+  BOOST_CHECK_MESSAGE(E[1] == E[0], "ENERGY TEST FAILED " << E[1] - E[0]);
+  BOOST_CHECK_MESSAGE(E[2] == E[0], "ENERGY TEST FAILED " << E[2] - E[0]);
+
+};
+
+// The binary basis cache is invalidated when the basis file is modified
+BOOST_FIXTURE_TEST_CASE( Basis_Cache_Stale, SerialJob ) {
+
+  std::string basis = TEST_OUT "scf/basis_cache_test.gbs";
+  {
+    std::ifstream src(TEST_ROOT "../basis/6-31g*.gbs");
+    std::ofstream dst(basis);
+    dst << src.rdbuf();
+  }
+
+  auto setMTime = [&](time_t t) {
+    struct utimbuf times; times.actime = t; times.modtime = t;
+    BOOST_REQUIRE( utime(basis.c_str(),&times) == 0 );
+  };
+
+  auto sameShells = [](const ReferenceBasisSet &X, 
+    const ReferenceBasisSet &Y) {
+
+    if( X.refShells.size() != Y.refShells.size() ) return false;
+    for(auto &atm : X.refShells) {
+      auto it = Y.refShells.find(atm.first);
+      if( it == Y.refShells.end() ) return false;
+      if( atm.second.shells     != it->second.shells or
+          atm.second.unNormCont != it->second.unNormCont ) return false;
+    }
+    return true;
+
+  };
+
+  std::string cacheDir = ReferenceBasisSet::cacheDir;
+  ReferenceBasisSet::cacheDir = TEST_OUT "scf/BASISCACHE";
+
+  // Any cache from a previous run is stale (modification time differs)
+  setMTime(1000000000);
+  ReferenceBasisSet parsed(basis,false,false);
+  BOOST_CHECK( not parsed.loadedFromCache() );
+
+  ReferenceBasisSet cached(basis,false,false);
+  BOOST_CHECK( cached.loadedFromCache() );
+  BOOST_CHECK( sameShells(parsed,cached) );
+
+  // Touching the basis file invalidates (and rewrites) the cache
+  setMTime(1000000001);
+  ReferenceBasisSet stale(basis,false,false);
+  BOOST_CHECK( not stale.loadedFromCache() );
+  BOOST_CHECK( sameShells(parsed,stale) );
+
+  ReferenceBasisSet fresh(basis,false,false);
+  BOOST_CHECK( fresh.loadedFromCache() );
+
+  ReferenceBasisSet::cacheDir = cacheDir;
+
+};
+
+// Names of the ChronusQ node-shared integral segments currently in /dev/shm
+static std::set<std::string> CQSharedSegments() {
+
+  std::set<std::string> names;
+  if( DIR *dir = opendir("/dev/shm") ) {
+    while( struct dirent *ent = readdir(dir) ) {
+      std::string name(ent->d_name);
+      if( name.compare(0,9,"chronusq_") == 0 ) names.insert(name);
+    }
+    closedir(dir);
+  }
+  return names;
+
+}; // CQSharedSegments
+
+// Water 6-31G(d) with the in-core ERIs in node-shared memory (reproduces 
+// the private in-core result, the segments are removed after the job)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_SharedMem, SerialJob ) {
+
+  auto preSegments = CQSharedSegments();
+
+  CQSCFENERGYTEST( scf/serial/rhf/water_6-31Gd_sharedmem, 
+    water_6-31Gd.bin.ref, 1e-8 );
+
+  for(auto &name : CQSharedSegments())
+    BOOST_CHECK_MESSAGE( preSegments.count(name), 
+      "SEGMENT " << name << " NOT UNLINKED" );
+
+  double incoreEnergy;
+  RunChronusQ(TEST_ROOT "scf/serial/rhf/water_6-31Gd_incore.inp","STDOUT",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_incore.bin",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_incore.scr");
+  SafeFile(TEST_OUT "scf/serial/rhf/water_6-31Gd_incore.bin",true).
+    readData("SCF/TOTAL_ENERGY",&incoreEnergy);
+
+  BOOST_CHECK_MESSAGE(std::abs(yDummy - incoreEnergy) < 1e-10, 
+    "ENERGY TEST FAILED " << std::abs(yDummy - incoreEnergy) );
+
+};
+
+// A contraction record with a varying number of coefficient columns
+// is rejected
+BOOST_FIXTURE_TEST_CASE( Ragged_Contraction, SerialJob ) {
+
+  BOOST_CHECK_THROW( ReferenceBasisSet(TEST_ROOT "scf/basis/ragged.gbs"),
+    std::runtime_error );
+
+  // CErr finalizes libint2
+  libint2::initialize();
+
+};
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,269 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include "scf.hpp"
+
+#include <physcon.hpp>
+
+// Dipole moment of a standalone SCF reference
+static std::array<double,3> SCFRefDipole(const std::string &ref) {
+
+  SafeFile refFile(SCF_TEST_REF + ref,true);
+
+  std::array<double,3> mu;
+  refFile.readData("SCF/LEN_ELECTRIC_DIPOLE",&mu[0]);
+  return mu;
+
+}; // SCFRefDipole
+
+
+// Run the RESP and FF jobs of a test case. The static linear response
+// polarizability must agree with the finite field one, and alpha(w) at the
+// second frequency must be symmetric with a larger diagonal than alpha(0)
+// (normal dispersion below the first excitation). Returns alpha(0) [i][j].
+static std::array<double,9> CQRespFFCheck(const std::string &dir, 
+  const std::string &resp, const std::string &ff, double tol) {
+
+  RunChronusQ(TEST_ROOT + dir + resp + ".inp","STDOUT",
+    TEST_OUT + dir + resp + ".bin", TEST_OUT + dir + resp + ".scr");
+  RunChronusQ(TEST_ROOT + dir + ff + ".inp","STDOUT",
+    TEST_OUT + dir + ff + ".bin", TEST_OUT + dir + ff + ".scr");
+
+  SafeFile respFile(TEST_OUT + dir + resp + ".bin",true);
+  SafeFile ffFile(TEST_OUT + dir + ff + ".bin",true);
+
+  // RESP/ALPHA is stored [iFreq][j][i]
+  double freq[2], alphaW[2][3][3], alphaFF[3][3];
+  respFile.readData("RESP/FREQ",freq);
+  respFile.readData("RESP/ALPHA",&alphaW[0][0][0]);
+  ffFile.readData("FF/ALPHA",&alphaFF[0][0]);
+
+  BOOST_CHECK( std::abs(freq[0]) < 1e-12 and freq[1] > 0. );
+
+  std::array<double,9> alpha0;
+  for(auto i = 0; i < 3; i++)
+  for(auto j = 0; j < 3; j++) {
+
+    alpha0[3*i + j] = alphaW[0][j][i];
+
+    BOOST_CHECK_MESSAGE(std::abs(alphaW[0][j][i] - alphaFF[i][j]) < tol, 
+      "RESP/FF ALPHA TEST FAILED IJ = " << i << j << " " << 
+      std::abs(alphaW[0][j][i] - alphaFF[i][j]) );
+
+    BOOST_CHECK_MESSAGE(std::abs(alphaW[1][j][i] - alphaW[1][i][j]) < 1e-6, 
+      "RESP ALPHA(W) SYMMETRY TEST FAILED IJ = " << i << j << " " << 
+      std::abs(alphaW[1][j][i] - alphaW[1][i][j]) );
+
+  }
+
+  for(auto i = 0; i < 3; i++)
+    BOOST_CHECK_MESSAGE(alphaW[1][i][i] > alphaW[0][i][i], 
+      "RESP DISPERSION TEST FAILED I = " << i << " " << 
+      alphaW[1][i][i] - alphaW[0][i][i] );
+
+  return alpha0;
+
+}; // CQRespFFCheck
+
+
+BOOST_AUTO_TEST_SUITE( PROPERTIES )
+
+// Water 6-31G(d) finite field alpha and beta_ijj. The dipoles of the
+// standalone SCF references at F = 0.01 au along X and Y must satisfy
+//   mu_i(F e_j) - mu_i(0) = -alpha_ij F - 0.5 beta_ijj F^2 + O(F^3)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_FF, SerialJob ) {
+
+  RunChronusQ(TEST_ROOT "scf/serial/rhf/water_6-31Gd_ff.inp","STDOUT",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_ff.bin",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_ff.scr");
+
+  SafeFile resFile(TEST_OUT "scf/serial/rhf/water_6-31Gd_ff.bin",true);
+
+  double alpha[3][3], beta[3][3], E0;
+  resFile.readData("FF/ALPHA",&alpha[0][0]);
+  resFile.readData("FF/BETA",&beta[0][0]);
+  resFile.readData("FF/ENERGY",&E0);
+
+  // The field free reference
+  double ERef;
+  SafeFile refFile(SCF_TEST_REF "water_6-31Gd.bin.ref",true);
+  refFile.readData("SCF/TOTAL_ENERGY",&ERef);
+  BOOST_CHECK_MESSAGE(std::abs(E0 - ERef) < 9e-10, 
+    "FF ENERGY TEST FAILED " << std::abs(E0 - ERef) );
+
+  // alpha is symmetric
+  for(auto i = 0; i < 3; i++)
+  for(auto j = 0; j < i; j++)
+    BOOST_CHECK_MESSAGE(std::abs(alpha[i][j] - alpha[j][i]) < 1e-5, 
+      "ALPHA SYMMETRY TEST FAILED IJ = " << i << j << " " << 
+      std::abs(alpha[i][j] - alpha[j][i]) );
+
+  const double F = 0.01;
+  std::array<double,3> mu0 = SCFRefDipole("water_6-31Gd.bin.ref");
+
+  const std::array<std::pair<size_t,std::string>,2> fieldRefs = {
+    std::make_pair(0ul,std::string("water_6-31Gd_ed_0.01_0_0.bin.ref")),
+    std::make_pair(1ul,std::string("water_6-31Gd_ed_0_0.01_0.bin.ref"))
+  };
+
+  for(auto &X : fieldRefs) {
+
+    size_t j  = X.first;
+    std::array<double,3> mu = SCFRefDipole(X.second);
+
+    for(auto i = 0; i < 3; i++) {
+      double dmu = -alpha[i][j] * F - 0.5 * beta[i][j] * F * F;
+      BOOST_CHECK_MESSAGE(std::abs((mu[i] - mu0[i]) - dmu) < 3e-4, 
+        "FF DIPOLE TEST FAILED IJ = " << i << j << " " << 
+        std::abs((mu[i] - mu0[i]) - dmu) );
+    }
+
+  }
+
+};
+
+// Water RHF/6-31G(d) linear response. alpha(0) must also reproduce the
+// dipoles of the standalone SCF references at F = 0.01 au (with beta_ijj
+// from the FF job, see Water_631Gd_FF)
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_RESP, SerialJob ) {
+
+  std::array<double,9> alpha = CQRespFFCheck("scf/serial/rhf/",
+    "water_6-31Gd_resp","water_6-31Gd_ff",1e-4);
+
+  SafeFile ffFile(TEST_OUT "scf/serial/rhf/water_6-31Gd_ff.bin",true);
+
+  double beta[3][3];
+  ffFile.readData("FF/BETA",&beta[0][0]);
+
+  const double F = 0.01;
+  std::array<double,3> mu0 = SCFRefDipole("water_6-31Gd.bin.ref");
+
+  const std::array<std::pair<size_t,std::string>,2> fieldRefs = {
+    std::make_pair(0ul,std::string("water_6-31Gd_ed_0.01_0_0.bin.ref")),
+    std::make_pair(1ul,std::string("water_6-31Gd_ed_0_0.01_0.bin.ref"))
+  };
+
+  for(auto &X : fieldRefs) {
+
+    size_t j  = X.first;
+    std::array<double,3> mu = SCFRefDipole(X.second);
+
+    for(auto i = 0; i < 3; i++) {
+      double dmu = -alpha[3*i + j] * F - 0.5 * beta[i][j] * F * F;
+      BOOST_CHECK_MESSAGE(std::abs((mu[i] - mu0[i]) - dmu) < 3e-4, 
+        "RESP DIPOLE TEST FAILED IJ = " << i << j << " " << 
+        std::abs((mu[i] - mu0[i]) - dmu) );
+    }
+
+  }
+
+};
+
+// O2 UHF/6-31G(d) linear response against finite field
+BOOST_FIXTURE_TEST_CASE( Oxygen_631Gd_RESP, SerialJob ) {
+
+  CQRespFFCheck("scf/serial/uhf/","oxygen_6-31Gd_resp","oxygen_6-31Gd_ff",
+    1e-4);
+
+};
+
+// Water B3LYP/6-31G(d) linear response (hybrid kernel) against finite field
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_B3LYP_RESP, SerialJob ) {
+
+  CQRespFFCheck("scf/serial/rks/","water_6-31Gd_B3LYP_resp",
+    "water_6-31Gd_B3LYP_ff",1e-4);
+
+};
+
+// Water RHF/6-31G(d) density cube: the header describes the molecule and
+// the grid, and the density integrates to the number of electrons
+BOOST_FIXTURE_TEST_CASE( Water_631Gd_Cube, SerialJob ) {
+
+  RunChronusQ(TEST_ROOT "scf/serial/rhf/water_6-31Gd_cube.inp","STDOUT",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_cube.bin",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_cube.scr");
+
+  std::ifstream cube(TEST_OUT "scf/serial/rhf/water_6-31Gd_cube_scf_den.cube");
+  BOOST_REQUIRE( cube.good() );
+
+  const double spacing = 0.1, padding = 4.;
+  const std::array<int,3> Z = {8, 1, 1};
+  const std::array<std::array<double,3>,3> geom = {{
+    {{ 0.         , -0.07579184359, 0. }},
+    {{ 0.866811829,  0.6014357793 , 0. }},
+    {{-0.866811829,  0.6014357793 , 0. }}
+  }};
+
+  std::string line;
+  std::getline(cube,line); // Comment
+  std::getline(cube,line); // Comment
+
+  int nAtoms;
+  std::array<double,3> origin;
+  cube >> nAtoms >> origin[0] >> origin[1] >> origin[2];
+  BOOST_CHECK_EQUAL( nAtoms, 3 );
+
+  std::array<size_t,3> nPts;
+  std::array<std::array<double,3>,3> axes;
+  for(auto i = 0; i < 3; i++)
+    cube >> nPts[i] >> axes[i][0] >> axes[i][1] >> axes[i][2];
+
+  for(auto i = 0; i < 3; i++)
+  for(auto j = 0; j < 3; j++)
+    BOOST_CHECK_SMALL( axes[i][j] - (i == j ? spacing : 0.), 1e-6 );
+
+  for(auto iAtm = 0; iAtm < 3; iAtm++) {
+    int atomicNumber; double charge; std::array<double,3> xyz;
+    cube >> atomicNumber >> charge >> xyz[0] >> xyz[1] >> xyz[2];
+    BOOST_CHECK_EQUAL( atomicNumber, Z[iAtm] );
+    for(auto k = 0; k < 3; k++)
+      BOOST_CHECK_SMALL( xyz[k] - geom[iAtm][k] / AngPerBohr, 1e-5 );
+  }
+
+  // The grid encloses the nuclei with the default padding
+  for(auto k = 0; k < 3; k++) {
+    double minXYZ = geom[0][k], maxXYZ = geom[0][k];
+    for(auto &X : geom) {
+      minXYZ = std::min(minXYZ,X[k]); maxXYZ = std::max(maxXYZ,X[k]);
+    }
+    minXYZ /= AngPerBohr; maxXYZ /= AngPerBohr;
+
+    BOOST_CHECK_SMALL( origin[k] - (minXYZ - padding), 1e-5 );
+    BOOST_CHECK_EQUAL( nPts[k], 
+      size_t(std::ceil((maxXYZ - minXYZ + 2*padding) / spacing) + 1) );
+  }
+
+  // Integrate the density. The error is dominated by the aliasing of the
+  // tight O core primitives on the grid and the truncation of the tails
+  size_t nVal = 0;
+  double rho, nElectron = 0.;
+  while( cube >> rho ) { nElectron += rho; nVal++; }
+  nElectron *= spacing * spacing * spacing;
+
+  BOOST_CHECK_EQUAL( nVal, nPts[0] * nPts[1] * nPts[2] );
+  BOOST_CHECK_MESSAGE( std::abs(nElectron - 10.) < 5e-2, 
+    "DENSITY INTEGRATION TEST FAILED " << nElectron );
+
+};
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -99,4 +99,21 @@ using namespace ChronusQ;
 
 #endif
 
+
+// SCF energy test against a reference within a given tolerance (for jobs 
+// which only reproduce the reference energy within a known error, e.g.
+// approximate integrals)
+#define CQSCFENERGYTEST( in, ref, tol ) \
+  RunChronusQ(TEST_ROOT #in ".inp","STDOUT", \
+    TEST_OUT #in ".bin",TEST_OUT #in ".scr");\
+  \
+  SafeFile refFile(SCF_TEST_REF #ref,true);\
+  SafeFile resFile(TEST_OUT #in ".bin",true);\
+  \
+  double xDummy, yDummy;\
+  \
+  refFile.readData("SCF/TOTAL_ENERGY",&xDummy);\
+  resFile.readData("SCF/TOTAL_ENERGY",&yDummy);\
+  BOOST_CHECK_MESSAGE(std::abs(yDummy - xDummy) < tol, "ENERGY TEST FAILED " << std::abs(yDummy - xDummy) );
+
 #endif
@@ -0,0 +1,84 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2017 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include "scf.hpp"
+
+#include <cxxapi/session.hpp>
+
+// Read the SCF total energy from a standalone SCF reference
+static double SCFRefEnergy(const std::string &ref) {
+
+  SafeFile refFile(SCF_TEST_REF + ref,true);
+
+  double E;
+  refFile.readData("SCF/TOTAL_ENERGY",&E);
+  return E;
+
+}; // SCFRefEnergy
+
+#define CQSESSIONCHECK( E, ref ) \
+  BOOST_CHECK_MESSAGE(std::abs(E - SCFRefEnergy(ref)) < 9e-10, \
+    "SESSION ENERGY TEST FAILED " << ref << " " << \
+    std::abs(E - SCFRefEnergy(ref)) );
+
+
+BOOST_AUTO_TEST_SUITE( SESSION )
+
+// Two concurrent sessions (water RHF and O2 UHF) in one process, with
+// interleaved SCF runs and a static field, against the standalone SCF
+// references
+BOOST_FIXTURE_TEST_CASE( Water_O2_631Gd_Session, SerialJob ) {
+
+  CQSession water(TEST_ROOT "scf/serial/rhf/water_6-31Gd.inp","STDOUT",
+    TEST_OUT "scf/serial/rhf/water_6-31Gd_session.bin");
+  CQSession o2(TEST_ROOT "scf/serial/uhf/oxygen_6-31Gd.inp","STDOUT",
+    TEST_OUT "scf/serial/uhf/oxygen_6-31Gd_session.bin");
+
+  double EWater = water.runSCF();
+  double EO2    = o2.runSCF();
+
+  CQSESSIONCHECK( EWater, "water_6-31Gd.bin.ref" );
+  CQSESSIONCHECK( EO2,    "oxygen_6-31Gd.bin.ref" );
+
+  // Field runs restart from the previous density
+  water.setField({0., 0.01, 0.});
+  double EWaterY = water.runSCF();
+
+  water.setField({0.01, 0., 0.});
+  double EWaterX = water.runSCF();
+
+  CQSESSIONCHECK( EWaterY, "water_6-31Gd_ed_0_0.01_0.bin.ref" );
+  CQSESSIONCHECK( EWaterX, "water_6-31Gd_ed_0.01_0_0.bin.ref" );
+
+  // Removing the field recovers the field free energy, and the other 
+  // session is unaffected
+  water.clearField();
+  EWater = water.runSCF();
+  EO2    = o2.runSCF();
+
+  CQSESSIONCHECK( EWater, "water_6-31Gd.bin.ref" );
+  CQSESSIONCHECK( EO2,    "oxygen_6-31Gd.bin.ref" );
+
+};
+
+BOOST_AUTO_TEST_SUITE_END()